@@ -1,7 +1,8 @@
 # This is free script released into the public domain.
 # GNU make file v20240211 created by Truong Hy.
 #
-# Builds bare-metal source for the Intel Cyclone V SoC.
+# Builds bare-metal source for the Intel Cyclone V SoC, or the QEMU vexpress-a9
+# board with board=vexpa9.
 # Depending on the options it will output the following application files:
 #   - elf (.elf)
 #   - binary (.bin)
@@ -28,6 +29,9 @@ semi ?= 0
 etu ?= 0
 bin ?= 0
 uimg ?= 0
+heap ?= 4
+bench ?= 0
+board ?= de10nano
 
 # These variables are assumed to be set already
 ifndef APP_PROGRAM_NAME1
@@ -74,7 +78,7 @@ SRCS := \
 	$(wildcard $(APP_SRC_PATH1)/trulib/source/*.c) \
 	$(wildcard $(APP_SRC_PATH1)/FreeRTOS/Source/*.c) \
 	$(wildcard $(APP_SRC_PATH1)/FreeRTOS/Source/portable/Common/*.c) \
-	$(wildcard $(APP_SRC_PATH1)/FreeRTOS/Source/portable/MemMang/*.c) \
+	$(APP_SRC_PATH1)/FreeRTOS/Source/portable/MemMang/heap_$(heap).c \
 	$(wildcard $(APP_SRC_PATH1)/FreeRTOS/Source/portable/GCC/ARM_CA9/*.c) \
 	$(wildcard $(APP_SRC_PATH1)/FreeRTOS/Source/portable/GCC/ARM_CA9/*.S)
 	
@@ -92,11 +96,15 @@ INCS := \
 	-I$(APP_SRC_PATH1)/FreeRTOS/Source/portable/GCC/ARM_CA9
 
 # The linker script to use
+ifeq ($(board),vexpa9)
+LINKER_SCRIPT := $(APP_SRC_PATH1)/ldscript/tru_vexpa9_ddr.ld
+else
 ifeq ($(etu),1)
 LINKER_SCRIPT := $(APP_SRC_PATH1)/ldscript/tru_c5_ddr.ld
 else
 LINKER_SCRIPT := $(APP_SRC_PATH1)/ldscript/tru_c5_ddr.ld
 endif
+endif
 
 # =========================================
 # Common linker and compiler build settings
@@ -106,9 +114,11 @@ CFLAGS := -mcpu=cortex-a9 -marm -mfloat-abi=hard -mfpu=neon -mno-unaligned-acces
 LDFLAGS := -Xlinker --gc-sections --specs=nosys.specs
 
 # Compiler user symbols (defines)
-CFLAGS_SYMBOL_HWLIB := -Dsoc_cv_av -DCYCLONEV -DALT_INT_PROVISION_VECTOR_SUPPORT=0
+CFLAGS_SYMBOL_HWLIB := -Dsoc_cv_av -DCYCLONEV -DALT_INT_PROVISION_VECTOR_SUPPORT=0 -DALT_INT_PROVISION_CPU_COUNT=2
 CFLAGS_SYMBOL_DEBUG_SEMI := -DSEMIHOSTING
 CFLAGS_SYMBOL_ETU := -DTRU_EXIT_TO_UBOOT=1
+CFLAGS_SYMBOL_BENCH := -DBENCH_RUN=1
+CFLAGS_SYMBOL_VEXPA9 := -DTRU_BOARD=TRU_BOARD_VEXPA9
 
 # ================================
 # Optimization and Debugging flags
@@ -131,6 +141,10 @@ endif
 ifeq ($(etu),1)
 DBG_CFLAGS := $(DBG_CFLAGS) $(CFLAGS_SYMBOL_ETU)
 endif
+# Conditional debug compiler flags
+ifeq ($(board),vexpa9)
+DBG_CFLAGS := $(DBG_CFLAGS) $(CFLAGS_SYMBOL_VEXPA9)
+endif
 # Common debug compiler flags
 DBG_CFLAGS := $(DBG_CFLAGS) $(INCS)
 
@@ -165,6 +179,14 @@ endif
 ifeq ($(etu),1)
 REL_CFLAGS := $(REL_CFLAGS) $(CFLAGS_SYMBOL_ETU)
 endif
+# Conditional release compiler flags
+ifeq ($(bench),1)
+REL_CFLAGS := $(REL_CFLAGS) $(CFLAGS_SYMBOL_BENCH)
+endif
+# Conditional release compiler flags
+ifeq ($(board),vexpa9)
+REL_CFLAGS := $(REL_CFLAGS) $(CFLAGS_SYMBOL_VEXPA9)
+endif
 # Common release compiler flags
 REL_CFLAGS := $(REL_CFLAGS) $(INCS)
 
@@ -185,11 +207,23 @@ endif
 # Common release linker flags
 REL_LDFLAGS := $(REL_LDFLAGS) -T$(LINKER_SCRIPT)
 
+# ====================
+# App settings (Board)
+# ====================
+
+# A build for another board goes into its own folders, so switching between
+# them does not rebuild
+ifeq ($(board),vexpa9)
+BOARD_SUFFIX := -vexpa9
+else
+BOARD_SUFFIX :=
+endif
+
 # ====================
 # App settings (Debug)
 # ====================
 
-DBG_PATH := $(APP_OUT_PATH)/Debug
+DBG_PATH := $(APP_OUT_PATH)/Debug$(BOARD_SUFFIX)
 DBG_ELF := $(DBG_PATH)/$(APP_PROGRAM_NAME1).elf
 DBG_CFLAGS_FILE := $(DBG_PATH)/$(APP_PROGRAM_NAME1).cflags.txt
 DBG_ELF_LOAD_FILE := $(DBG_PATH)/$(APP_PROGRAM_NAME1).load.txt
@@ -202,7 +236,14 @@ DBG_OBJS := $(patsubst %.c,$(DBG_PATH)/%.o,$(SRCS))
 # App settings (Release)
 # ======================
 
-REL_PATH := $(APP_OUT_PATH)/Release
+# The benchmark build is a Release build in its own folder, so switching
+# between them does not rebuild
+BNC_PATH := $(APP_OUT_PATH)/Bench$(BOARD_SUFFIX)
+ifeq ($(bench),1)
+REL_PATH := $(BNC_PATH)
+else
+REL_PATH := $(APP_OUT_PATH)/Release$(BOARD_SUFFIX)
+endif
 REL_ELF := $(REL_PATH)/$(APP_PROGRAM_NAME1).elf
 REL_CFLAGS_FILE := $(REL_PATH)/$(APP_PROGRAM_NAME1).cflags.txt
 REL_ELF_LOAD_FILE := $(REL_PATH)/$(APP_PROGRAM_NAME1).load.txt
@@ -259,7 +300,7 @@ SPACE := $() $()
 # ===========
 
 # Options
-.PHONY: all help release debug clean cleantemp
+.PHONY: all help release debug bench clean cleantemp
 
 # Default build
 all: release
@@ -276,6 +317,7 @@ help:
 	@echo "Targets:"
 	@echo "  release       Build elf Release (default)"
 	@echo "  debug         Build elf Debug"
+	@echo "  bench         Build elf Release with the benchmarks (bench.h)"
 	@echo "  clean         Delete all built files"
 	@echo "  cleantemp     Clean except target files"
 	@echo "Options to use with target:"
@@ -283,6 +325,8 @@ help:
 	@echo "  etu=1         Elf exit to U-Boot"
 	@echo "  bin=1         Outputs binary from the elf"
 	@echo "  uimg=1        Outputs U-Boot image from the binary"
+	@echo "  heap=tlsf     FreeRTOS heap, uses heap_<heap>.c (default 4)"
+	@echo "  board=vexpa9  Build for the QEMU vexpress-a9 board (default de10nano)"
 
 # ===========
 # Clean rules
@@ -292,6 +336,8 @@ help:
 clean_1:
 	@if [ -d "$(DBG_PATH)" ]; then echo rm -rf $(DBG_PATH); rm -rf $(DBG_PATH); fi
 	@if [ -d "$(REL_PATH)" ]; then echo rm -rf $(REL_PATH); rm -rf $(REL_PATH); fi
+	@if [ -d "$(BNC_PATH)" ]; then echo rm -rf $(BNC_PATH); rm -rf $(BNC_PATH); fi
+	@for d in Debug Release Bench; do if [ -d "$(APP_OUT_PATH)/$$d-vexpa9" ]; then echo rm -rf $(APP_OUT_PATH)/$$d-vexpa9; rm -rf $(APP_OUT_PATH)/$$d-vexpa9; fi; done
 
 # Clean root folder
 clean: clean_1
@@ -331,6 +377,9 @@ debug: $(DBG_ELF) $(DBG_CFLAGS_FILE) $(DBG_ELF_LOAD_FILE) $(DBG_ELF_ENTRY_FILE)
 
 release: $(REL_ELF) $(REL_CFLAGS_FILE) $(REL_ELF_LOAD_FILE) $(REL_ELF_ENTRY_FILE)
 
+bench:
+	make -f Makefile-app1.mk --no-print-directory release bench=1 semi=$(semi) etu=$(etu) bin=$(bin) uimg=$(uimg) heap=$(heap) board=$(board)
+
 ifeq ($(bin),1)
 # Add additional target rule
 debug: $(DBG_BIN)
@@ -428,10 +477,12 @@ $(REL_ELF): $(REL_OBJS)
 $(DBG_CFLAGS_FILE): $(DBG_ELF)
 	@echo $(DBG_CFLAGS) > $(DBG_CFLAGS_FILE)
 	@$(SZ) --format=berkeley $(DBG_ELF)
+	@echo "FreeRTOS static objects: $$(( 0x$$(grep " __rtos_static_end$$" $(DBG_ELF).map | cut -d" " -f1) - 0x$$(grep " __rtos_static_start$$" $(DBG_ELF).map | cut -d" " -f1) )) bytes"
 
 $(REL_CFLAGS_FILE): $(REL_ELF)
 	@echo $(REL_CFLAGS) > $(REL_CFLAGS_FILE)
 	@$(SZ) --format=berkeley $(REL_ELF)
+	@echo "FreeRTOS static objects: $$(( 0x$$(grep " __rtos_static_end$$" $(REL_ELF).map | cut -d" " -f1) - 0x$$(grep " __rtos_static_start$$" $(REL_ELF).map | cut -d" " -f1) )) bytes"
 
 # ==============================
 # Extract elf load address rules
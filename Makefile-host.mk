@@ -0,0 +1,120 @@
+# This is free script released into the public domain.
+# GNU make file v20261017 created by Truong Hy.
+#
+# Builds the host (Linux) programs of source/host with the native gcc, and runs
+# their tests.  Nothing here needs the board or the ARM toolchain:
+#   - frame_target  The framed transport for the loopback test of
+#                   scripts-generic/tru_frame_client.py
+#   - blinky_host   The blinky tasks on the POSIX port of source/host, with the
+#                   fake HPS registers of tru_c5soc_hps_sim.h, and a test task
+#
+# The POSIX port, source/host/freertos_posix.c, is cooperative: a task is only
+# switched out where it calls the kernel.  It runs tasks that block or delay,
+# a task that busy polls hangs it, and it is no good for throughput or stress
+# tests.
+#
+# For usage, type make -f Makefile-host.mk help
+#
+# Linux requirements:
+#   - gcc
+#   - Python 3 (for the tests)
+#
+# This makefile is already complicated, but to keep things a bit more simple:
+#   - We assume the required global variables are already set
+#   - We assume the required files and paths are relative to the location of this Makefile
+
+# These variables are assumed to be set already
+ifndef APP_OUT_PATH
+$(error APP_OUT_PATH environment variable is not set)
+endif
+ifndef APP_SRC_PATH1
+$(error APP_SRC_PATH1 environment variable is not set)
+endif
+
+# ============
+# Source files
+# ============
+
+# The framed transport loopback target
+FRAME_SRCS := \
+	$(APP_SRC_PATH1)/host/frame_target.c \
+	$(APP_SRC_PATH1)/trulib/source/tru_frame.c
+
+# The blinky demo tasks, unmodified, on the POSIX port of the host folder
+BLINKY_SRCS := \
+	$(APP_SRC_PATH1)/host/blinky_host.c \
+	$(APP_SRC_PATH1)/blinky_tasks.c \
+	$(APP_SRC_PATH1)/blinky_gpio.c \
+	$(APP_SRC_PATH1)/freertos_static.c \
+	$(APP_SRC_PATH1)/trulib/source/tru_c5soc_hps_sim.c \
+	$(APP_SRC_PATH1)/trulib/source/tru_logger.c \
+	$(wildcard $(APP_SRC_PATH1)/FreeRTOS/Source/*.c) \
+	$(APP_SRC_PATH1)/FreeRTOS/Source/portable/MemMang/heap_4.c \
+	$(APP_SRC_PATH1)/host/freertos_posix.c
+
+# List of header include search paths.  The host folder goes first for its
+# FreeRTOSConfig.h and portmacro.h
+INCS := \
+	-I$(APP_SRC_PATH1)/host \
+	-I$(APP_SRC_PATH1) \
+	-I$(APP_SRC_PATH1)/hwlib/include \
+	-I$(APP_SRC_PATH1)/hwlib/include/soc_cv_av \
+	-I$(APP_SRC_PATH1)/trulib/include \
+	-I$(APP_SRC_PATH1)/FreeRTOS/Source/include
+
+# ==============
+# Build settings
+# ==============
+
+CC := gcc
+CFLAGS := -std=gnu11 -g -O2
+LDFLAGS := -pthread
+
+# Compiler user symbols (defines).  The HPS base addresses point at the fake
+# register blocks
+CFLAGS_SYMBOL_HWLIB := -Dsoc_cv_av -DCYCLONEV -DALT_INT_PROVISION_VECTOR_SUPPORT=0 -DALT_INT_PROVISION_CPU_COUNT=2
+CFLAGS_SYMBOL_SIM := -DTRU_HPS_SIM=1
+PYTHON := python3
+
+HST_PATH := $(APP_OUT_PATH)/Host
+HST_FRAME := $(HST_PATH)/frame_target
+HST_BLINKY := $(HST_PATH)/blinky_host
+
+# ===========
+# Build rules
+# ===========
+
+# Options
+.PHONY: all help test clean
+
+# Default build
+all: $(HST_FRAME) $(HST_BLINKY)
+
+help:
+	@echo "Builds and tests the host programs"
+	@echo "Usage:"
+	@echo "  make -f Makefile-host.mk [targets]"
+	@echo ""
+	@echo "Targets:"
+	@echo "  all           Build the host programs (default)"
+	@echo "  test          Build and run the host tests"
+	@echo "  clean         Delete all built files"
+	@echo ""
+	@echo "The blinky host program runs on a cooperative POSIX port, a task is only"
+	@echo "switched out where it calls the kernel.  Tasks that busy poll hang it,"
+	@echo "and it is not meant for throughput or stress tests."
+
+$(HST_FRAME): $(FRAME_SRCS)
+	@mkdir -p $(@D)
+	$(CC) $(CFLAGS) $(INCS) -o $@ $(FRAME_SRCS)
+
+$(HST_BLINKY): $(BLINKY_SRCS) $(wildcard $(APP_SRC_PATH1)/host/*.h)
+	@mkdir -p $(@D)
+	$(CC) $(CFLAGS) $(CFLAGS_SYMBOL_HWLIB) $(CFLAGS_SYMBOL_SIM) $(INCS) -o $@ $(BLINKY_SRCS) $(LDFLAGS)
+
+test: $(HST_FRAME) $(HST_BLINKY)
+	$(PYTHON) scripts-generic/tru_frame_client.py loopback --target $(HST_FRAME)
+	$(HST_BLINKY)
+
+clean:
+	@if [ -d "$(HST_PATH)" ]; then echo rm -rf $(HST_PATH); rm -rf $(HST_PATH); fi
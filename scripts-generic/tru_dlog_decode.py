@@ -0,0 +1,184 @@
+#!/usr/bin/env python3
+#
+# MIT License
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in all
+# copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+# SOFTWARE.
+#
+# Developer: Truong Hy
+# Version  : 20261017
+#
+#
+# Decodes the output of the trulib deferred logger (tru_dlog.h).  The records
+# only hold the address of the format string, so the strings are read from the
+# ELF file of the program, which must be the one running.
+#
+# The input is the raw console output, a serial port or a file captured from
+# it, e.g.:
+#   stty -F /dev/ttyUSB0 115200 raw
+#   python3 tru_dlog_decode.py program.elf /dev/ttyUSB0
+#   python3 tru_dlog_decode.py -t program.elf capture.bin
+# Text written around the binary frames, e.g. by the bootloader or LOG_SYNC(),
+# is passed through.  With -t each record is prefixed with its CPU and time in
+# seconds, the global timer runs at -f Hz (default 200MHz, the DE10-Nano, use
+# 100000000 for the QEMU vexpress-a9).
+
+import argparse
+import re
+import struct
+import sys
+
+# Must match tru_dlog.h and tru_dlog.c
+TRU_DLOG_SYNC = 0x00
+TRU_DLOG_ARGS_MAX = 12
+
+SHT_NOBITS = 8
+SHF_ALLOC = 0x2
+
+# A printf conversion, the length modifiers are dropped as all arguments are 32 bits
+CONVERSION = re.compile(r"%([-+ #0]*\d*(?:\.\d+)?)(?:hh|h|ll|l|j|z|t)?([diouxXcsp%])")
+
+# The allocated sections with contents, as (address, data), read from an ELF32
+# little endian file
+def read_elf(path):
+	with open(path, "rb") as f:
+		data = f.read()
+	if data[:4] != b"\x7fELF" or data[4] != 1 or data[5] != 1:
+		sys.exit("%s is not a 32-bit little endian ELF file" % path)
+
+	shoff, = struct.unpack_from("<I", data, 32)
+	shentsize, shnum = struct.unpack_from("<HH", data, 46)
+	sections = []
+	for i in range(shnum):
+		_, sh_type, flags, addr, offset, size = struct.unpack_from("<IIIIII", data, shoff + i * shentsize)
+		if flags & SHF_ALLOC and sh_type != SHT_NOBITS and size:
+			sections.append((addr, data[offset:offset + size]))
+	return sections
+
+def read_string(sections, addr):
+	for base, data in sections:
+		if base <= addr < base + len(data):
+			end = data.find(b"\0", addr - base)
+			return data[addr - base:end if end >= 0 else len(data)].decode("ascii", "replace")
+	return None
+
+# Formats a record the way printf would have
+def format_record(sections, fmt_addr, args):
+	fmt = read_string(sections, fmt_addr)
+	if fmt is None:
+		return "<bad format string address 0x%08x>\n" % fmt_addr
+
+	args = list(args)
+	def convert(match):
+		flags, conv = match.groups()
+		if conv == "%":
+			return "%"
+		value = args.pop(0) if args else 0
+		if conv in "di":
+			value = value - (1 << 32) if value & 0x80000000 else value
+		elif conv == "c":
+			value = chr(value & 0xff)
+		elif conv == "s":
+			text = read_string(sections, value)
+			value = text if text is not None else "<0x%08x>" % value
+		elif conv == "p":
+			conv = "x"
+			flags = "#" + flags
+		return ("%" + flags + conv) % value
+	return CONVERSION.sub(convert, fmt)
+
+# Splits the input into text and frames, and returns the decoded output
+class Decoder:
+	def __init__(self, sections, hz, times):
+		self.sections = sections
+		self.hz = hz
+		self.times = times
+		self.buf = bytearray()
+		self.start = None
+
+	def record(self, cpu_nargs, fmt_addr, time, args):
+		cpu = cpu_nargs >> 4
+		if self.start is None:
+			self.start = time
+		prefix = "[%d %12.6f] " % (cpu, (time - self.start) / self.hz) if self.times else ""
+		if fmt_addr == 0:
+			return prefix + "# %d log records dropped on CPU%d\n" % (args[0], cpu)
+		return prefix + format_record(self.sections, fmt_addr, args)
+
+	def feed(self, data):
+		self.buf += data
+		out = []
+		while self.buf:
+			sync = self.buf.find(bytes([TRU_DLOG_SYNC]))
+			if sync < 0:
+				out.append(self.buf.decode("ascii", "replace"))
+				self.buf.clear()
+				break
+			if sync > 0:
+				out.append(self.buf[:sync].decode("ascii", "replace"))
+				del self.buf[:sync]
+				continue
+
+			# A frame, or a stray 0x00
+			if len(self.buf) < 2:
+				break
+			cpu_nargs = self.buf[1]
+			nargs = cpu_nargs & 0xf
+			size = 2 + 4 + 8 + nargs * 4 + 1
+			if nargs > TRU_DLOG_ARGS_MAX:
+				del self.buf[:1]
+				continue
+			if len(self.buf) < size:
+				break
+
+			check = 0
+			for b in self.buf[1:size]:
+				check ^= b
+			if check != 0:
+				del self.buf[:1]
+				continue
+
+			fmt_addr, time = struct.unpack_from("<IQ", self.buf, 2)
+			args = struct.unpack_from("<%dI" % nargs, self.buf, 14)
+			out.append(self.record(cpu_nargs, fmt_addr, time, args))
+			del self.buf[:size]
+		return "".join(out)
+
+def main():
+	parser = argparse.ArgumentParser(description="Decodes the trulib deferred logger output")
+	parser.add_argument("-t", "--times", action="store_true", help="prefix each record with its CPU and time")
+	parser.add_argument("-f", "--hz", type=float, default=200e6, help="global timer frequency (default 200MHz)")
+	parser.add_argument("elf", help="ELF file of the running program")
+	parser.add_argument("input", nargs="?", default="-", help="serial port or captured file (default stdin)")
+	args = parser.parse_args()
+
+	decoder = Decoder(read_elf(args.elf), args.hz, args.times)
+	f = sys.stdin.buffer if args.input == "-" else open(args.input, "rb", buffering=0)
+	try:
+		while True:
+			data = f.read1(256) if hasattr(f, "read1") else f.read(256)
+			if not data:
+				break
+			sys.stdout.write(decoder.feed(data))
+			sys.stdout.flush()
+	except KeyboardInterrupt:
+		pass
+	sys.stdout.write(decoder.buf.decode("ascii", "replace"))
+
+if __name__ == "__main__":
+	main()
@@ -0,0 +1,384 @@
+#!/usr/bin/env python3
+#
+# MIT License
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in all
+# copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+#
+# Developer: Truong Hy
+# Version  : 20261017
+#
+# Host side of the trulib framed transport (tru_frame.h), built with
+# TRU_CFG_FRAME 1U.  Each frame is COBS(channel, payload, CRC-32) 0x00.
+#
+#   python3 tru_frame_client.py monitor /dev/ttyUSB0 [--elf program.elf]
+#       Prints the log text, the deferred logger records (decoded with the ELF
+#       file, as tru_dlog_decode.py does) and the telemetry
+#   python3 tru_frame_client.py ping /dev/ttyUSB0
+#       Round trip time of a command
+#   python3 tru_frame_client.py trace /dev/ttyUSB0 trace.bin
+#       Stops the kernel trace recorder and saves its dump for
+#       tru_trace_decode.py
+#   python3 tru_frame_client.py level /dev/ttyUSB0 [module level]
+#       Prints the log threshold of each module, or first sets one of them
+#       (module all sets every module), see tru_logger.h
+#   python3 tru_frame_client.py stats /dev/ttyUSB0
+#       Prints the run time stats of each task and the interrupt time of each
+#       core, see freertos_stats.h
+#   python3 tru_frame_client.py loopback [--target Host/frame_target]
+#       Tests the codec, then this client against tru_frame.c on a Linux
+#       pseudo terminal, no board needed.  The target is the host program
+#       source/host/frame_target.c, built with make host.  Exits with 1 on a
+#       failure
+
+import argparse
+import os
+import random
+import select
+import struct
+import subprocess
+import sys
+import termios
+import time
+import tty
+import zlib
+
+# Must match tru_frame.h
+TRU_FRAME_DELIM = 0x00
+CH_LOG = 0
+CH_DLOG = 1
+CH_TELEMETRY = 2
+CH_COMMAND = 3
+CH_TRACE = 4
+CHANNELS = ("log", "dlog", "telemetry", "command", "trace")
+
+# Must match frame_task.c
+CMD_PING = ord("P")
+CMD_TRACE = ord("T")
+CMD_LEVEL = ord("L")
+CMD_STATS = ord("S")
+CMD_UNKNOWN = ord("?")
+
+# Must match tru_logger.h
+LOG_LEVELS = ("none", "error", "warn", "info", "debug")
+LOG_MODULES = ("default", "trulib", "rtos", "app")
+TELEMETRY = struct.Struct("<IIIIII")
+TELEMETRY_FIELDS = ("time_ms", "heap_free", "heap_min_free", "rx_overruns", "rx_dropped", "frame_errors")
+
+# The same blocks as tru_frame_sendv(): a full block of 254 bytes implies no
+# zero, and at the end needs nothing after it
+def cobs_encode(data):
+	out = bytearray()
+	start = 0
+	while True:
+		end = start
+		while end < len(data) and end - start < 254 and data[end] != 0:
+			end += 1
+		out.append(end - start + 1)
+		out += data[start:end]
+		if end - start < 254 and end < len(data):
+			start = end + 1
+		elif end == len(data):
+			return bytes(out)
+		else:
+			start = end
+
+def cobs_decode(data):
+	out = bytearray()
+	i = 0
+	while i < len(data):
+		code = data[i]
+		if code == 0 or i + code > len(data):
+			return None
+		out += data[i + 1:i + code]
+		i += code
+		if code < 255 and i < len(data):
+			out.append(0)
+	return bytes(out)
+
+def encode_frame(channel, payload):
+	body = bytes([channel]) + bytes(payload)
+	return cobs_encode(body + struct.pack("<I", zlib.crc32(body))) + bytes([TRU_FRAME_DELIM])
+
+# Splits a byte stream into frames, bytes before the first delimiter are
+# dropped as they may be the end of a frame
+class FrameDecoder:
+	def __init__(self, max_size=2048):
+		self.max_size = max_size
+		self.buf = bytearray()
+		self.synced = False
+		self.frames = 0
+		self.errors = 0
+
+	# Returns the good frames as (channel, payload)
+	def feed(self, data):
+		frames = []
+		self.buf += data
+		while True:
+			end = self.buf.find(bytes([TRU_FRAME_DELIM]))
+			if end < 0:
+				if len(self.buf) > 2 * self.max_size:
+					del self.buf[:]
+					self.errors += 1
+				return frames
+			raw = bytes(self.buf[:end])
+			del self.buf[:end + 1]
+			if not self.synced:
+				self.synced = True
+				continue
+			if not raw:
+				continue
+
+			body = cobs_decode(raw)
+			if body is None or len(body) < 5 or struct.unpack_from("<I", body, len(body) - 4)[0] != zlib.crc32(body[:-4]):
+				self.errors += 1
+				continue
+			self.frames += 1
+			frames.append((body[0], body[1:-4]))
+
+# A serial port, or the pseudo terminal of the loopback test
+class Link:
+	def __init__(self, path, baud=None, synced=False):
+		self.fd = os.open(path, os.O_RDWR | os.O_NOCTTY)
+		tty.setraw(self.fd)
+		if baud is not None:
+			attr = termios.tcgetattr(self.fd)
+			speed = getattr(termios, "B%d" % baud)
+			attr[4] = attr[5] = speed
+			termios.tcsetattr(self.fd, termios.TCSANOW, attr)
+		self.decoder = FrameDecoder()
+		self.decoder.synced = synced
+		self.pending = []
+
+	def close(self):
+		os.close(self.fd)
+
+	def send(self, channel, payload):
+		os.write(self.fd, encode_frame(channel, payload))
+
+	# Returns the next frame as (channel, payload), or None after the timeout
+	def receive(self, timeout=None):
+		deadline = None if timeout is None else time.monotonic() + timeout
+		while not self.pending:
+			left = None if deadline is None else deadline - time.monotonic()
+			if left is not None and left <= 0:
+				return None
+			ready, _, _ = select.select([self.fd], [], [], left)
+			if ready:
+				self.pending += self.decoder.feed(os.read(self.fd, 4096))
+		return self.pending.pop(0)
+
+	# Sends a command and returns its reply, printing the frames of the other
+	# channels in the meantime with the print function given
+	def command(self, payload, timeout=2.0, other=None):
+		self.send(CH_COMMAND, payload)
+		deadline = time.monotonic() + timeout
+		while True:
+			frame = self.receive(deadline - time.monotonic())
+			if frame is None:
+				return None
+			if frame[0] == CH_COMMAND and frame[1][:1] in (payload[:1], bytes([CMD_UNKNOWN])):
+				return frame[1]
+			if other is not None:
+				other(*frame)
+
+# Prints the frames of all channels
+class Printer:
+	def __init__(self, elf=None, hz=200e6, times=False):
+		self.dlog = None
+		if elf is not None:
+			sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+			import tru_dlog_decode
+			self.dlog = tru_dlog_decode.Decoder(tru_dlog_decode.read_elf(elf), hz, times)
+
+	def __call__(self, channel, payload):
+		if channel == CH_LOG:
+			sys.stdout.write(payload.decode("ascii", "replace"))
+		elif channel == CH_DLOG and self.dlog is not None and len(payload) >= 13:
+			cpu_nargs = payload[0]
+			fmt_addr, rec_time = struct.unpack_from("<IQ", payload, 1)
+			args = struct.unpack_from("<%dI" % ((len(payload) - 13) // 4), payload, 13)
+			sys.stdout.write(self.dlog.record(cpu_nargs, fmt_addr, rec_time, args))
+		elif channel == CH_TELEMETRY and len(payload) == TELEMETRY.size:
+			values = TELEMETRY.unpack(payload)
+			sys.stdout.write("# " + " ".join("%s=%d" % pair for pair in zip(TELEMETRY_FIELDS, values)) + "\n")
+		else:
+			name = CHANNELS[channel] if channel < len(CHANNELS) else "channel %d" % channel
+			sys.stdout.write("# %s: %s\n" % (name, payload.hex()))
+		sys.stdout.flush()
+
+def monitor(args):
+	link = Link(args.port, args.baud)
+	printer = Printer(args.elf, args.hz, args.times)
+	try:
+		while True:
+			printer(*link.receive())
+	except KeyboardInterrupt:
+		pass
+	print("# %d frames, %d errors" % (link.decoder.frames, link.decoder.errors))
+
+def ping(args):
+	link = Link(args.port, args.baud)
+	printer = Printer()
+	for i in range(args.count):
+		payload = bytes([CMD_PING]) + struct.pack("<I", i)
+		start = time.monotonic()
+		reply = link.command(payload, other=printer)
+		if reply != payload:
+			sys.exit("No reply to ping %d" % i)
+		print("ping %d: %.3f ms" % (i, (time.monotonic() - start) * 1e3))
+
+def trace(args):
+	link = Link(args.port, args.baud)
+	reply = link.command(bytes([CMD_TRACE]))
+	if reply is None or reply[:1] != bytes([CMD_TRACE]):
+		sys.exit("The target did not accept the trace command")
+
+	dump = bytearray()
+	while True:
+		frame = link.receive(2.0)
+		if frame is None:
+			sys.exit("The trace dump stopped after %d bytes" % len(dump))
+		if frame[0] != CH_TRACE:
+			continue
+		if not frame[1]:
+			break
+		dump += frame[1]
+
+	with open(args.output, "wb") as f:
+		f.write(dump)
+	print("%d bytes saved, decode with tru_trace_decode.py" % len(dump))
+
+def level(args):
+	link = Link(args.port, args.baud)
+	payload = bytes([CMD_LEVEL])
+	if args.module is not None:
+		if args.level is None:
+			sys.exit("Give the level too")
+		module = args.module.lower()
+		module = 255 if module == "all" else LOG_MODULES.index(module) if module in LOG_MODULES else int(module, 0)
+		value = args.level.lower()
+		value = LOG_LEVELS.index(value) if value in LOG_LEVELS else int(value, 0)
+		payload += bytes([module, value])
+
+	reply = link.command(payload)
+	if reply is None or reply[:1] != bytes([CMD_LEVEL]):
+		sys.exit("The target did not accept the level command, is it built with TRU_LOG?")
+	for module, value in enumerate(reply[1:]):
+		name = LOG_MODULES[module] if module < len(LOG_MODULES) else "app+%d" % (module - len(LOG_MODULES) + 1)
+		print("%-8s %s" % (name, LOG_LEVELS[value] if value < len(LOG_LEVELS) else value))
+
+def stats(args):
+	link = Link(args.port, args.baud)
+	reply = link.command(bytes([CMD_STATS]))
+	if reply is None or reply[:1] != bytes([CMD_STATS]):
+		sys.exit("The target did not accept the stats command")
+	sys.stdout.write(reply[1:].decode("ascii", "replace"))
+
+def loopback(args):
+	rng = random.Random(args.seed)
+
+	# Codec edge cases, the block boundaries of COBS
+	lengths = [0, 1, 2, 253, 254, 255, 256, 508, 509, 510, 1000]
+	for n in lengths:
+		for fill in (b"\x00", b"\x01", b"\xff"):
+			data = fill * n
+			frame = encode_frame(CH_TELEMETRY, data)
+			assert TRU_FRAME_DELIM not in frame[:-1]
+			decoder = FrameDecoder()
+			decoder.synced = True
+			assert decoder.feed(frame) == [(CH_TELEMETRY, data)], "codec failed, %d bytes of %r" % (n, fill)
+
+	# A corrupted frame is counted and the next one still arrives
+	decoder = FrameDecoder()
+	decoder.synced = True
+	bad = bytearray(encode_frame(CH_LOG, b"hello"))
+	bad[3] ^= 0x40
+	assert decoder.feed(bytes(bad) + encode_frame(CH_LOG, b"world")) == [(CH_LOG, b"world")] and decoder.errors == 1
+
+	# Commands over the pseudo terminal, to tru_frame.c built for the host
+	if not os.access(args.target, os.X_OK):
+		sys.exit("%s not found, build it with make host" % args.target)
+	master, slave = os.openpty()
+	proc = subprocess.Popen([args.target, str(args.seed)], stdin=master, stdout=master)
+	link = Link(os.ttyname(slave), synced=True)
+	others = []
+	telemetry = []
+	garbage = 0
+	failed = 0
+	def other(channel, data):
+		others.append(channel)
+		if channel == CH_TELEMETRY:
+			telemetry.append(TELEMETRY.unpack(data))
+	try:
+		for i in range(args.count):
+			# Garbage for the target to drop, never a whole frame
+			if rng.randrange(4) == 0:
+				os.write(link.fd, bytes(rng.randrange(1, 256) for _ in range(rng.randrange(1, 8))) + bytes([TRU_FRAME_DELIM]))
+				garbage += 1
+			n = rng.choice([0, 1, 253, 254, 255, 256, rng.randrange(0, 1024)])
+			payload = bytes([CMD_PING]) + bytes(rng.choice([0, 0, rng.randrange(256)]) for _ in range(n))
+			reply = link.command(payload, other=other)
+			if reply != payload:
+				print("ping %d of %d bytes failed" % (i, len(payload)))
+				failed += 1
+	finally:
+		link.close()
+		os.close(slave)
+		try:
+			proc.wait(timeout=2.0)
+		except subprocess.TimeoutExpired:
+			proc.kill()
+			proc.wait()
+		os.close(master)
+
+	if others.count(CH_LOG) != args.count or len(telemetry) != args.count:
+		print("lost log or telemetry frames")
+		failed += 1
+	elif telemetry[-1][5] != garbage:
+		print("the target dropped %d frames, %d were sent" % (telemetry[-1][5], garbage))
+		failed += 1
+	print("%d pings, %d frames, %d garbage frames dropped by the client, %d by the target, %s" % (args.count, link.decoder.frames, link.decoder.errors, garbage, "FAILED" if failed else "passed"))
+	sys.exit(1 if failed else 0)
+
+def main():
+	parser = argparse.ArgumentParser(description="Client of the trulib framed transport")
+	sub = parser.add_subparsers(dest="command", required=True)
+
+	for name, func in (("monitor", monitor), ("ping", ping), ("trace", trace), ("level", level), ("stats", stats)):
+		p = sub.add_parser(name)
+		p.set_defaults(func=func)
+		p.add_argument("-b", "--baud", type=int, default=115200, help="baud rate (default 115200)")
+		p.add_argument("port", help="serial port")
+	monitor_parser = sub.choices["monitor"]
+	monitor_parser.add_argument("-e", "--elf", help="ELF file of the running program, to decode the deferred logger records")
+	monitor_parser.add_argument("-t", "--times", action="store_true", help="prefix each record with its CPU and time")
+	monitor_parser.add_argument("-f", "--hz", type=float, default=200e6, help="global timer frequency (default 200MHz)")
+	sub.choices["ping"].add_argument("-n", "--count", type=int, default=10, help="number of pings")
+	sub.choices["trace"].add_argument("output", help="file to save the dump to")
+	sub.choices["level"].add_argument("module", nargs="?", help="module name or number, or all")
+	sub.choices["level"].add_argument("level", nargs="?", help="level name or number")
+	p = sub.add_parser("loopback")
+	p.set_defaults(func=loopback)
+	p.add_argument("-n", "--count", type=int, default=200, help="number of pings")
+	p.add_argument("-s", "--seed", type=int, default=1, help="random seed")
+	p.add_argument("-t", "--target", default=os.path.join("Host", "frame_target"), help="host build of the target (default Host/frame_target)")
+
+	args = parser.parse_args()
+	args.func(args)
+
+if __name__ == "__main__":
+	main()
@@ -0,0 +1,150 @@
+#!/usr/bin/env python3
+#
+# MIT License
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in all
+# copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+# SOFTWARE.
+#
+# Developer: Truong Hy
+# Version  : 20261017
+#
+# Symbolises the histogram printed by tru_prof_print() (tru_prof.h) against the
+# ELF file of the program, and writes flame graph input in the folded stack
+# format read by flamegraph.pl, or https://www.speedscope.app:
+#   <task>;<caller>;<function> <samples>
+# Capture the serial output to a file, other lines in it are ignored, then:
+#   python3 tru_prof_symbolise.py DEBUG/freertos_blinky.elf capture.txt prof.folded
+# A summary of the functions with the most samples is printed.
+#
+# The caller comes from the interrupted LR, which is only right while the
+# function has not used LR for something else, so it is left out when it is not
+# in a function.  The task is the symbol of its TCB, which is named for the
+# tasks allocated at build time (freertos_static.h).
+#
+# The symbols are read with nm, set NM or use --nm for another toolchain prefix.
+
+import argparse
+import bisect
+import os
+import re
+import subprocess
+import sys
+
+PROF_LINE = re.compile(r"PROF (\d+) ([0-9a-fA-F]{8}) ([0-9a-fA-F]{8}) ([0-9a-fA-F]{8}) (\d+)")
+PROF_CPU = re.compile(r"PROF cpu (\d+) samples (\d+) dropped (\d+)")
+
+class Symbols:
+	def __init__(self, nm, elf, types):
+		out = subprocess.run([nm, "-n", "-S", "--defined-only", elf], check=True, capture_output=True, text=True).stdout
+		self.addrs = []
+		self.syms = []
+		for line in out.splitlines():
+			fields = line.split()
+			if len(fields) == 4:
+				addr, size, kind, name = int(fields[0], 16), int(fields[1], 16), fields[2], fields[3]
+			elif len(fields) == 3:
+				addr, size, kind, name = int(fields[0], 16), 0, fields[1], fields[2]
+			else:
+				continue
+			if kind in types and not name.startswith("$"):
+				self.addrs.append(addr)
+				self.syms.append((addr, size, name))
+
+	# Returns (name, offset) or None when the address is not in a symbol
+	def lookup(self, addr):
+		i = bisect.bisect_right(self.addrs, addr) - 1
+		if i < 0:
+			return None
+		start, size, name = self.syms[i]
+		if size == 0:
+			# Without a size, assume it runs to the next symbol
+			end = self.syms[i + 1][0] if i + 1 < len(self.syms) else start + 1
+		else:
+			end = start + size
+		if addr >= end:
+			return None
+		return name, addr - start
+
+def task_name(data, context):
+	if context == 0:
+		return "(no task)"
+	sym = data.lookup(context)
+	if sym is None:
+		return "task@%08x" % context
+	name, offset = sym
+	if name.endswith("_tcb"):
+		name = name[:-4]
+	return name if offset == 0 else "%s+0x%x" % (name, offset)
+
+def main():
+	parser = argparse.ArgumentParser(description="Symbolise a tru_prof histogram")
+	parser.add_argument("elf")
+	parser.add_argument("capture")
+	parser.add_argument("folded", nargs="?", help="Flame graph output, default stdout")
+	parser.add_argument("--nm", default=os.environ.get("NM", "arm-none-eabi-nm"))
+	parser.add_argument("--top", type=int, default=20, help="Functions in the summary")
+	args = parser.parse_args()
+
+	funcs = Symbols(args.nm, args.elf, "TtWw")
+	data = Symbols(args.nm, args.elf, "BbDdSs")
+
+	samples = 0
+	dropped = 0
+	stacks = {}
+	flat = {}
+	with open(args.capture, "r", errors="replace") as f:
+		for line in f:
+			m = PROF_CPU.search(line)
+			if m:
+				samples += int(m.group(2))
+				dropped += int(m.group(3))
+				continue
+			m = PROF_LINE.search(line)
+			if not m:
+				continue
+			context, lr, pc, count = int(m.group(2), 16), int(m.group(3), 16), int(m.group(4), 16), int(m.group(5))
+
+			sym = funcs.lookup(pc)
+			func = sym[0] if sym else "0x%08x" % pc
+			frames = [task_name(data, context)]
+			caller = funcs.lookup(lr) if lr else None
+			if caller and caller[0] != func:
+				frames.append(caller[0])
+			frames.append(func)
+
+			stack = ";".join(frames)
+			stacks[stack] = stacks.get(stack, 0) + count
+			flat[func] = flat.get(func, 0) + count
+
+	if not stacks:
+		sys.exit("No PROF lines found in %s" % args.capture)
+
+	out = open(args.folded, "w") if args.folded else sys.stdout
+	for stack, count in sorted(stacks.items()):
+		out.write("%s %d\n" % (stack, count))
+	if args.folded:
+		out.close()
+
+	total = sum(flat.values())
+	report = sys.stdout if args.folded else sys.stderr
+	report.write("%d samples, %d dropped\n" % (samples or total, dropped))
+	for func, count in sorted(flat.items(), key=lambda item: -item[1])[:args.top]:
+		report.write("%6.2f%% %8d  %s\n" % (count * 100.0 / total, count, func))
+
+if __name__ == "__main__":
+	main()
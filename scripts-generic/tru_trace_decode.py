@@ -0,0 +1,165 @@
+#!/usr/bin/env python3
+#
+# MIT License
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in all
+# copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+# SOFTWARE.
+#
+# Developer: Truong Hy
+# Version  : 20261017
+#
+# Converts a dump of the trulib trace recorder (tru_trace.h) to the Chrome
+# trace event JSON format, which opens in https://ui.perfetto.dev or
+# chrome://tracing.
+#
+# Get the dump with the program stopped in OpenOCD, e.g.:
+#   (gdb) call tru_trace_stop()
+#   > dump_image trace.bin <address of tru_trace> <sizeof(tru_trace)>
+# then:
+#   python3 tru_trace_decode.py trace.bin trace.json
+#
+# Each CPU has a track for its tasks and one for its interrupt handlers.  Queue
+# and timer events are instant events on the task track.
+
+import json
+import struct
+import sys
+
+# Must match tru_trace.h
+TRU_TRACE_MAGIC = 0x54525443
+TRU_TRACE_NAMES = 64
+TRU_TRACE_NAME_LEN = 16
+CACHELINE_SIZE = 32
+TIME_BITS = 40
+
+EVENTS = {
+	1: "TASK_CREATE",
+	2: "TASK_IN",
+	3: "TASK_OUT",
+	4: "QUEUE_CREATE",
+	5: "QUEUE_SEND",
+	6: "QUEUE_SEND_FROM_ISR",
+	7: "QUEUE_RECEIVE",
+	8: "QUEUE_RECEIVE_FROM_ISR",
+	9: "ISR_ENTER",
+	10: "ISR_EXIT",
+	11: "TIMER_CREATE",
+	12: "TIMER_COMMAND",
+	13: "TIMER_EXPIRED",
+	14: "USER",
+}
+
+def align(value, alignment):
+	return (value + alignment - 1) // alignment * alignment
+
+# Returns the records of each CPU in time order as (time, event, arg)
+def read_dump(data):
+	magic, ring_length, cpus, timer_hz, stop_time = struct.unpack_from("<IIIIQ", data, 0)
+	if magic != TRU_TRACE_MAGIC:
+		sys.exit("Not a tru_trace dump, bad magic 0x%08x" % magic)
+	if stop_time == 0:
+		sys.exit("The recorder was not stopped, call tru_trace_stop() before the dump")
+
+	names = {}
+	offset = 32
+	for i in range(TRU_TRACE_NAMES):
+		name = data[offset:offset + TRU_TRACE_NAME_LEN].split(b"\0")[0].decode("ascii", "replace")
+		if name:
+			names[i] = name
+		offset += TRU_TRACE_NAME_LEN
+
+	ring_offset = align(offset, CACHELINE_SIZE)
+	ring_size = align(CACHELINE_SIZE + ring_length * 8, CACHELINE_SIZE)
+	time_mask = (1 << TIME_BITS) - 1
+
+	rings = []
+	for cpu in range(cpus):
+		base = ring_offset + cpu * ring_size
+		(head,) = struct.unpack_from("<I", data, base)
+		count = min(head, ring_length)
+		words = struct.unpack_from("<%dQ" % ring_length, data, base + CACHELINE_SIZE)
+
+		# Unwrap the 40-bit timestamps backwards from the stop time
+		records = []
+		last = stop_time
+		for i in range(head - 1, head - 1 - count, -1):
+			word = words[i % ring_length]
+			low = word & time_mask
+			time = (last & ~time_mask) | low
+			if time > last:
+				time -= 1 << TIME_BITS
+			last = time
+			records.append((time, word >> 58, (word >> 40) & 0x3ffff))
+		records.reverse()
+		rings.append(records)
+
+	return timer_hz, names, rings
+
+def to_chrome(timer_hz, names, rings):
+	start = min((r[0][0] for r in rings if r), default=0)
+	us = lambda time: (time - start) * 1e6 / timer_hz
+	task_name = lambda task: names.get(task, "task %d" % task)
+	out = [{"ph": "M", "pid": 0, "name": "process_name", "args": {"name": "FreeRTOS"}}]
+
+	for cpu, records in enumerate(rings):
+		task_tid = cpu * 2
+		isr_tid = cpu * 2 + 1
+		out.append({"ph": "M", "pid": 0, "tid": task_tid, "name": "thread_name", "args": {"name": "CPU%d tasks" % cpu}})
+		out.append({"ph": "M", "pid": 0, "tid": isr_tid, "name": "thread_name", "args": {"name": "CPU%d interrupts" % cpu}})
+
+		task_in = None
+		isr_stack = []
+		for time, event, arg in records:
+			name = EVENTS.get(event, "EVENT_%d" % event)
+			if event == 2:
+				task_in = (time, arg)
+			elif event == 3:
+				if task_in is not None and task_in[1] == arg:
+					out.append({"ph": "X", "pid": 0, "tid": task_tid, "name": task_name(arg), "ts": us(task_in[0]), "dur": us(time) - us(task_in[0])})
+				task_in = None
+			elif event == 9:
+				isr_stack.append((time, arg))
+			elif event == 10:
+				if isr_stack and isr_stack[-1][1] == arg:
+					entry = isr_stack.pop()
+					out.append({"ph": "X", "pid": 0, "tid": isr_tid, "name": "IRQ %d" % arg, "ts": us(entry[0]), "dur": us(time) - us(entry[0])})
+			else:
+				label = task_name(arg) if event == 1 else "%s %d" % (name, arg)
+				out.append({"ph": "i", "s": "t", "pid": 0, "tid": task_tid, "name": label, "ts": us(time), "args": {"event": name, "arg": arg}})
+
+		# A task still running when the recorder stopped
+		if task_in is not None and records:
+			out.append({"ph": "X", "pid": 0, "tid": task_tid, "name": task_name(task_in[1]), "ts": us(task_in[0]), "dur": us(records[-1][0]) - us(task_in[0])})
+
+	return {"traceEvents": out, "displayTimeUnit": "ns"}
+
+def main():
+	if len(sys.argv) != 3:
+		sys.exit("Usage: tru_trace_decode.py <trace.bin> <trace.json>")
+
+	with open(sys.argv[1], "rb") as f:
+		data = f.read()
+
+	timer_hz, names, rings = read_dump(data)
+	with open(sys.argv[2], "w") as f:
+		json.dump(to_chrome(timer_hz, names, rings), f)
+
+	print("%d records decoded" % sum(len(r) for r in rings))
+
+if __name__ == "__main__":
+	main()
@@ -0,0 +1,31 @@
+#!/bin/bash
+
+# Runs the QEMU vexpress-a9 board build (make ... board=vexpa9) in QEMU, with
+# the console UART on stdio.  Exit QEMU with Ctrl-A then X.
+# Usage: runqemu.sh <debug|release|bench> [extra QEMU options, e.g. -icount shift=0]
+
+set -e
+function cleanup {
+	rc=$?
+	# If error and shell is child level 1 then stay in shell
+	if [ $rc -ne 0 ] && [ $SHLVL -eq 1 ]; then exec $SHELL; else exit $rc; fi
+}
+trap cleanup EXIT
+
+if [ -z "${APP_HOME_PATH+x}" ]; then
+	chmod +x ../scripts-env/env-linux.sh
+	source ../scripts-env/env-linux.sh
+fi
+
+cd $APP_HOME_PATH
+
+# Determine build from input argument
+if [ "$1" = "debug" ]; then
+	app1_elf="$APP_OUT_PATH/Debug-vexpa9/$APP_PROGRAM_NAME1".elf
+elif [ "$1" = "bench" ]; then
+	app1_elf="$APP_OUT_PATH/Bench-vexpa9/$APP_PROGRAM_NAME1".elf
+else
+	app1_elf="$APP_OUT_PATH/Release-vexpa9/$APP_PROGRAM_NAME1".elf
+fi
+
+qemu-system-arm -M vexpress-a9 -smp 1 -m 1G -nographic -kernel $app1_elf "${@:2}"
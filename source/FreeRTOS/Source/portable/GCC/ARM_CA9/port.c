@@ -126,8 +126,9 @@
     __asm volatile ( "ISB" );
 
 
-/* Macro to unmask all interrupt priorities. */
-#define portCLEAR_INTERRUPT_MASK()                            \
+/* Macro to unmask all interrupt priorities.  Not named
+ * portCLEAR_INTERRUPT_MASK() as the SMP kernel uses that name. */
+#define portUNMASK_INTERRUPT_PRIORITIES()                     \
     {                                                         \
         portCPU_IRQ_DISABLE();                                \
         portICCPMR_PRIORITY_MASK_REGISTER = portUNMASK_VALUE; \
@@ -153,6 +154,17 @@
  * registers, plus a 32-bit status register. */
 #define portFPU_REGISTER_WORDS    ( ( 32 * 2 ) + 1 )
 
+/* Called by vPortEnterCritical() once the outermost critical section has been
+ * entered, and by vPortExitCritical() before it is left, e.g. to time how long
+ * interrupts are masked.  Both are called with interrupts masked. */
+#ifndef portCRITICAL_SECTION_ENTERED
+    #define portCRITICAL_SECTION_ENTERED()
+#endif
+
+#ifndef portCRITICAL_SECTION_EXITING
+    #define portCRITICAL_SECTION_EXITING()
+#endif
+
 /*-----------------------------------------------------------*/
 
 /*
@@ -189,23 +201,65 @@ void vApplicationFPUSafeIRQHandler( uint32_t ulICCIAR ) __attribute__( ( weak )
 
 /*-----------------------------------------------------------*/
 
+/* The variables below are per core, and are indexed by the core ID (the CPU ID
+ * field of the MPIDR) here and in portASM.S.  A single core build has arrays of
+ * one entry. */
+
 /* A variable is used to keep track of the critical section nesting.  This
  * variable has to be stored as part of the task context and must be initialised to
  * a non zero value to ensure interrupts don't inadvertently become unmasked before
  * the scheduler starts.  As it is stored as part of the task context it will
  * automatically be set to 0 when the first task is started. */
-volatile uint32_t ulCriticalNesting = 9999UL;
+volatile uint32_t ulCriticalNesting[ configNUMBER_OF_CORES ] = { [ 0 ... ( configNUMBER_OF_CORES - 1 ) ] = 9999UL };
 
-/* Saved as part of the task context.  If ulPortTaskHasFPUContext is non-zero then
- * a floating point context must be saved and restored for the task. */
-volatile uint32_t ulPortTaskHasFPUContext = pdFALSE;
+/* Saved as part of the task context.  If bit 0 of ulPortTaskHasFPUContext is set
+ * then a floating point context must be saved and restored for the task.  When
+ * configUSE_TASK_FPU_SUPPORT is 3 it instead holds the address of the task's FPU
+ * save area, which is word aligned so bit 0 is always clear. */
+volatile uint32_t ulPortTaskHasFPUContext[ configNUMBER_OF_CORES ] = { pdFALSE };
+
+/* Used when configUSE_TASK_FPU_SUPPORT is 3.  The FPU save area of the task
+ * whose registers are currently held in the FPU register bank, or NULL if the
+ * bank is not owned by any task.  The FPU is only enabled while the owning task
+ * is running, any other task that executes a VFP/NEON instruction traps into
+ * FreeRTOS_Undef_Handler (portASM.S), which moves the bank over to that task. */
+uint32_t * volatile pulPortFPUOwnerContext[ configNUMBER_OF_CORES ] = { NULL };
 
 /* Set to 1 to pend a context switch from an ISR. */
-volatile uint32_t ulPortYieldRequired = pdFALSE;
+volatile uint32_t ulPortYieldRequired[ configNUMBER_OF_CORES ] = { pdFALSE };
 
 /* Counts the interrupt nesting depth.  A context switch is only performed if
  * if the nesting depth is 0. */
-volatile uint32_t ulPortInterruptNesting = 0UL;
+volatile uint32_t ulPortInterruptNesting[ configNUMBER_OF_CORES ] = { 0UL };
+
+/* The kernel holds the running task of each core in pxCurrentTCBs[] when built
+ * for SMP, and in pxCurrentTCB otherwise.  The asm file indexes this by the core
+ * ID either way. */
+#if ( configNUMBER_OF_CORES == 1 )
+    extern void * volatile pxCurrentTCB;
+    __attribute__( ( used ) ) void * volatile * const pxPortCurrentTCBs = &pxCurrentTCB;
+#else
+    extern void * volatile pxCurrentTCBs[];
+    __attribute__( ( used ) ) void * volatile * const pxPortCurrentTCBs = pxCurrentTCBs;
+#endif
+
+/* With more than one core a task can be switched out on one core and back in on
+ * another, so a lazily switched FPU context (configUSE_TASK_FPU_SUPPORT == 3)
+ * cannot be left in the register bank of the core it last ran on.  It is saved
+ * when the owning task is switched out instead, and only tasks that do not use
+ * the FPU still benefit from the lazy switching. */
+__attribute__( ( used ) ) const uint32_t ulPortFPUSaveOnSwitch = ( configNUMBER_OF_CORES > 1 );
+
+/* An interrupt handler that the application calls without saving the FPU
+ * registers first runs with the FPU disabled.  If it does execute a VFP/NEON
+ * instruction after all, e.g. in a library memcpy(), FreeRTOS_Undef_Handler
+ * (portASM.S) saves the registers into the save area of the core, records the
+ * interrupt nesting level of the handler here and enables the FPU.  The
+ * application restores the registers when that handler returns and clears the
+ * level back to 0.  A handler nested in it finds the FPU enabled and must stack
+ * the registers itself. */
+volatile uint32_t ulPortISRFPULevel[ configNUMBER_OF_CORES ] = { 0UL };
+uint32_t ulPortISRFPUContext[ configNUMBER_OF_CORES ][ portFPU_LAZY_AREA_WORDS ] __attribute__( ( aligned( 8 ) ) );
 
 /* Used in the asm file. */
 __attribute__( ( used ) ) const uint32_t ulICCIAR = portICCIAR_INTERRUPT_ACKNOWLEDGE_REGISTER_ADDRESS;
@@ -228,6 +282,20 @@ StackType_t * pxPortInitialiseStack( StackType_t * pxTopOfStack,
      * The fist real value on the stack is the status register, which is set for
      * system mode, with interrupts enabled.  A few NULLs are added first to ensure
      * GDB does not try decoding a non-existent return address. */
+    #if ( configUSE_TASK_FPU_SUPPORT == 3 )
+        StackType_t * pxFPUContext;
+
+        /* The FPU registers are saved and restored lazily, so the task gets a
+         * fixed save area at the top of its stack instead of having them pushed
+         * with the rest of its context.  They start initialised to 0.  The top
+         * of stack is 8-byte aligned, so the area starts 8-byte aligned for
+         * VSTMIA/VLDMIA, and the spare word is below it. */
+        pxFPUContext = pxTopOfStack - ( portFPU_LAZY_AREA_WORDS - 2 );
+        configASSERT( ( ( uint32_t ) pxFPUContext & 0x7UL ) == 0UL );
+        memset( pxFPUContext - 1, 0x00, portFPU_LAZY_AREA_WORDS * sizeof( StackType_t ) );
+        pxTopOfStack -= portFPU_LAZY_AREA_WORDS;
+    #endif
+
     *pxTopOfStack = ( StackType_t ) NULL;
     pxTopOfStack--;
     *pxTopOfStack = ( StackType_t ) NULL;
@@ -299,11 +367,19 @@ StackType_t * pxPortInitialiseStack( StackType_t * pxTopOfStack,
 
         pxTopOfStack--;
         *pxTopOfStack = pdTRUE;
-        ulPortTaskHasFPUContext = pdTRUE;
+        ulPortTaskHasFPUContext[ portGET_CORE_ID() ] = pdTRUE;
+    }
+    #elif ( configUSE_TASK_FPU_SUPPORT == 3 )
+    {
+        /* The task does not own the FPU when it starts, it is given the FPU
+         * register bank on its first VFP/NEON instruction.  The context holds
+         * the address of its save area in place of the FPU context flag. */
+        pxTopOfStack--;
+        *pxTopOfStack = ( StackType_t ) pxFPUContext;
     }
     #else /* if ( configUSE_TASK_FPU_SUPPORT == 1 ) */
     {
-        #error "Invalid configUSE_TASK_FPU_SUPPORT setting - configUSE_TASK_FPU_SUPPORT must be set to 1, 2, or left undefined."
+        #error "Invalid configUSE_TASK_FPU_SUPPORT setting - configUSE_TASK_FPU_SUPPORT must be set to 1, 2, 3, or left undefined."
     }
     #endif /* if ( configUSE_TASK_FPU_SUPPORT == 1 ) */
 
@@ -319,7 +395,7 @@ static void prvTaskExitError( void )
      *
      * Artificially force an assert() to be triggered if configASSERT() is
      * defined, then stop here so application writers can catch the error. */
-    configASSERT( ulPortInterruptNesting == ~0UL );
+    configASSERT( ulPortInterruptNesting[ portGET_CORE_ID() ] == ~0UL );
     portDISABLE_INTERRUPTS();
 
     for( ; ; )
@@ -391,6 +467,14 @@ BaseType_t xPortStartScheduler( void )
             /* Start the timer that generates the tick ISR. */
             configSETUP_TICK_INTERRUPT();
 
+            #if ( configNUMBER_OF_CORES > 1 )
+            {
+                /* Start the other cores, each of them calls
+                 * vPortStartSecondaryCore() to start its first task. */
+                configSTART_SECONDARY_CORES();
+            }
+            #endif
+
             /* Start the first task executing. */
             vPortRestoreTaskContext();
         }
@@ -410,10 +494,12 @@ void vPortEndScheduler( void )
 {
     /* Not implemented in ports where there is nothing to return to.
      * Artificially force an assert. */
-    configASSERT( ulCriticalNesting == 1000UL );
+    configASSERT( ulCriticalNesting[ portGET_CORE_ID() ] == 1000UL );
 }
 /*-----------------------------------------------------------*/
 
+#if ( configNUMBER_OF_CORES == 1 )
+
 void vPortEnterCritical( void )
 {
     /* Mask interrupts up to the max syscall interrupt priority. */
@@ -422,66 +508,210 @@ void vPortEnterCritical( void )
     /* Now that interrupts are disabled, ulCriticalNesting can be accessed
      * directly.  Increment ulCriticalNesting to keep a count of how many times
      * portENTER_CRITICAL() has been called. */
-    ulCriticalNesting++;
+    ulCriticalNesting[ 0 ]++;
 
     /* This is not the interrupt safe version of the enter critical function so
      * assert() if it is being called from an interrupt context.  Only API
      * functions that end in "FromISR" can be used in an interrupt.  Only assert if
      * the critical nesting count is 1 to protect against recursive calls if the
      * assert function also uses a critical section. */
-    if( ulCriticalNesting == 1 )
+    if( ulCriticalNesting[ 0 ] == 1 )
     {
-        configASSERT( ulPortInterruptNesting == 0 );
+        configASSERT( ulPortInterruptNesting[ 0 ] == 0 );
+        portCRITICAL_SECTION_ENTERED();
     }
 }
 /*-----------------------------------------------------------*/
 
 void vPortExitCritical( void )
 {
-    if( ulCriticalNesting > portNO_CRITICAL_NESTING )
+    if( ulCriticalNesting[ 0 ] > portNO_CRITICAL_NESTING )
     {
         /* Decrement the nesting count as the critical section is being
          * exited. */
-        ulCriticalNesting--;
+        ulCriticalNesting[ 0 ]--;
 
         /* If the nesting level has reached zero then all interrupt
          * priorities must be re-enabled. */
-        if( ulCriticalNesting == portNO_CRITICAL_NESTING )
+        if( ulCriticalNesting[ 0 ] == portNO_CRITICAL_NESTING )
         {
+            portCRITICAL_SECTION_EXITING();
+
             /* Critical nesting has reached zero so all interrupt priorities
              * should be unmasked. */
-            portCLEAR_INTERRUPT_MASK();
+            portUNMASK_INTERRUPT_PRIORITIES();
         }
     }
 }
+
+#endif /* configNUMBER_OF_CORES */
 /*-----------------------------------------------------------*/
 
 void FreeRTOS_Tick_Handler( void )
 {
-    /* Set interrupt mask before altering scheduler structures.   The tick
-     * handler runs at the lowest priority, so interrupts cannot already be masked,
-     * so there is no need to save and restore the current mask value.  It is
-     * necessary to turn off interrupts in the CPU itself while the ICCPMR is being
-     * updated. */
-    portCPU_IRQ_DISABLE();
-    portICCPMR_PRIORITY_MASK_REGISTER = ( uint32_t ) ( configMAX_API_CALL_INTERRUPT_PRIORITY << portPRIORITY_SHIFT );
-    __asm volatile ( "dsb        \n"
-                     "isb        \n" ::: "memory" );
-    portCPU_IRQ_ENABLE();
+    #if ( configNUMBER_OF_CORES == 1 )
+    {
+        /* Set interrupt mask before altering scheduler structures.   The tick
+         * handler runs at the lowest priority, so interrupts cannot already be masked,
+         * so there is no need to save and restore the current mask value.  It is
+         * necessary to turn off interrupts in the CPU itself while the ICCPMR is being
+         * updated. */
+        portCPU_IRQ_DISABLE();
+        portICCPMR_PRIORITY_MASK_REGISTER = ( uint32_t ) ( configMAX_API_CALL_INTERRUPT_PRIORITY << portPRIORITY_SHIFT );
+        __asm volatile ( "dsb        \n"
+                         "isb        \n" ::: "memory" );
+        portCPU_IRQ_ENABLE();
+
+        /* Increment the RTOS tick. */
+        if( xTaskIncrementTick() != pdFALSE )
+        {
+            ulPortYieldRequired[ 0 ] = pdTRUE;
+        }
 
-    /* Increment the RTOS tick. */
-    if( xTaskIncrementTick() != pdFALSE )
+        /* Ensure all interrupt priorities are active again. */
+        portUNMASK_INTERRUPT_PRIORITIES();
+    }
+    #else /* if ( configNUMBER_OF_CORES == 1 ) */
     {
-        ulPortYieldRequired = pdTRUE;
+        UBaseType_t uxSavedInterruptStatus;
+
+        /* Only core 0 receives the tick.  The kernel data is shared with the
+         * other cores, so the ISR lock is taken as well as the interrupt
+         * priorities being masked.  Time slicing on the other cores is done by
+         * the kernel yielding them from xTaskIncrementTick(). */
+        uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+        {
+            if( xTaskIncrementTick() != pdFALSE )
+            {
+                ulPortYieldRequired[ portGET_CORE_ID() ] = pdTRUE;
+            }
+        }
+        taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
     }
+    #endif /* if ( configNUMBER_OF_CORES == 1 ) */
 
-    /* Ensure all interrupt priorities are active again. */
-    portCLEAR_INTERRUPT_MASK();
     configCLEAR_TICK_INTERRUPT();
 }
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_TASK_FPU_SUPPORT != 2 )
+#if ( configNUMBER_OF_CORES > 1 )
+
+    /* Lock word of the task lock and the ISR lock.  Holds 0 if the lock is free,
+     * otherwise the ID of the core that holds it plus 1. */
+    static volatile uint32_t ulPortLockOwner[ 2 ] = { 0UL };
+
+    /* The number of times the core that holds the lock has taken it.  Only
+     * accessed by the core that holds the lock. */
+    static uint32_t ulPortLockRecursionCount[ 2 ] = { 0UL };
+
+    void vPortRecursiveLock( uint32_t ulLockNum,
+                             BaseType_t xAcquire )
+    {
+        const uint32_t ulCoreTag = ( uint32_t ) portGET_CORE_ID() + 1UL;
+        volatile uint32_t * const pulLock = &ulPortLockOwner[ ulLockNum ];
+        uint32_t ulValue;
+        uint32_t ulStoreFailed;
+
+        /* The kernel only takes the locks with interrupts masked, so this core
+         * cannot be preempted between the owner check and the update below. */
+        if( xAcquire != pdFALSE )
+        {
+            if( *pulLock != ulCoreTag )
+            {
+                /* Wait for the lock to be free, then claim it with an exclusive
+                 * store.  A core waiting for the lock sleeps in WFE until the
+                 * holder releases it and sends an event. */
+                __asm volatile (
+                    "1:                             \n"
+                    "    LDREX   %0, [%2]           \n"
+                    "    CMP     %0, #0             \n"
+                    "    WFENE                      \n"
+                    "    BNE     1b                 \n"
+                    "    STREX   %1, %3, [%2]       \n"
+                    "    CMP     %1, #0             \n"
+                    "    BNE     1b                 \n"
+                    "    DMB                        \n"
+                    : "=&r" ( ulValue ), "=&r" ( ulStoreFailed )
+                    : "r" ( pulLock ), "r" ( ulCoreTag )
+                    : "cc", "memory" );
+            }
+
+            ulPortLockRecursionCount[ ulLockNum ]++;
+        }
+        else
+        {
+            configASSERT( *pulLock == ulCoreTag );
+            configASSERT( ulPortLockRecursionCount[ ulLockNum ] != 0UL );
+
+            ulPortLockRecursionCount[ ulLockNum ]--;
+
+            if( ulPortLockRecursionCount[ ulLockNum ] == 0UL )
+            {
+                /* Make the protected data visible before the lock is seen to be
+                 * free, then wake any core waiting in WFE. */
+                __asm volatile ( "DMB" ::: "memory" );
+                *pulLock = 0UL;
+                __asm volatile ( "DSB        \n"
+                                 "SEV        \n" ::: "memory" );
+            }
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    void vPortYieldCore( BaseType_t xCoreID )
+    {
+        if( xCoreID == portGET_CORE_ID() )
+        {
+            if( ulPortInterruptNesting[ xCoreID ] != 0UL )
+            {
+                /* Switch on exit from the interrupt. */
+                ulPortYieldRequired[ xCoreID ] = pdTRUE;
+            }
+            else
+            {
+                portYIELD();
+            }
+        }
+        else
+        {
+            /* Interrupt the other core.  Its handler for the interrupt is
+             * FreeRTOS_Yield_Handler(). */
+            configTRIGGER_YIELD_INTERRUPT( xCoreID );
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    void FreeRTOS_Yield_Handler( void )
+    {
+        /* Another core has requested this core to reschedule.  The context
+         * switch is performed on exit from the interrupt. */
+        ulPortYieldRequired[ portGET_CORE_ID() ] = pdTRUE;
+    }
+/*-----------------------------------------------------------*/
+
+    void vPortStartSecondaryCore( void )
+    {
+        /* The GIC CPU interface of each core is banked, so the binary point must
+         * be checked on this core too.  See xPortStartScheduler(). */
+        configASSERT( ( portICCBPR_BINARY_POINT_REGISTER & portBINARY_POINT_BITS ) <= portMAX_BINARY_POINT_VALUE );
+
+        /* Interrupts are turned off in the CPU itself until the first task on
+         * this core starts executing. */
+        portCPU_IRQ_DISABLE();
+
+        /* Enable the interrupts of this core that are used by the kernel.  The
+         * banked private peripheral and software generated interrupts must be
+         * enabled by each core. */
+        configSETUP_TICK_INTERRUPT();
+
+        /* Start the first task of this core executing. */
+        vPortRestoreTaskContext();
+    }
+
+#endif /* configNUMBER_OF_CORES */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TASK_FPU_SUPPORT != 2 ) && ( configUSE_TASK_FPU_SUPPORT != 3 )
 
     void vPortTaskUsesFPU( void )
     {
@@ -489,7 +719,7 @@ void FreeRTOS_Tick_Handler( void )
 
         /* A task is registering the fact that it needs an FPU context.  Set the
          * FPU flag (which is saved as part of the task context). */
-        ulPortTaskHasFPUContext = pdTRUE;
+        ulPortTaskHasFPUContext[ portGET_CORE_ID() ] = pdTRUE;
 
         /* Initialise the floating point status register. */
         __asm volatile ( "FMXR  FPSCR, %0" ::"r" ( ulInitialFPSCR ) : "memory" );
@@ -498,11 +728,42 @@ void FreeRTOS_Tick_Handler( void )
 #endif /* configUSE_TASK_FPU_SUPPORT */
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_TASK_FPU_SUPPORT == 3 )
+
+    void vPortCleanUpTCB( void * pxTCB )
+    {
+        uint32_t * pulTopOfStack;
+        BaseType_t xCoreID;
+
+        /* The first member of the TCB is the saved stack pointer, and the last
+         * word pushed by portSAVE_CONTEXT is the task's FPU save area address.
+         * The task being deleted is not running, so its context is saved. */
+        pulTopOfStack = *( ( uint32_t ** ) pxTCB );
+
+        /* If the task owns the FPU register bank of a core then release it, so
+         * that its registers are not saved into a stack that is about to be
+         * freed. */
+        portENTER_CRITICAL();
+        {
+            for( xCoreID = 0; xCoreID < configNUMBER_OF_CORES; xCoreID++ )
+            {
+                if( pulPortFPUOwnerContext[ xCoreID ] == ( uint32_t * ) pulTopOfStack[ 0 ] )
+                {
+                    pulPortFPUOwnerContext[ xCoreID ] = NULL;
+                }
+            }
+        }
+        portEXIT_CRITICAL();
+    }
+
+#endif /* configUSE_TASK_FPU_SUPPORT */
+/*-----------------------------------------------------------*/
+
 void vPortClearInterruptMask( uint32_t ulNewMaskValue )
 {
     if( ulNewMaskValue == pdFALSE )
     {
-        portCLEAR_INTERRUPT_MASK();
+        portUNMASK_INTERRUPT_PRIORITIES();
     }
 }
 /*-----------------------------------------------------------*/
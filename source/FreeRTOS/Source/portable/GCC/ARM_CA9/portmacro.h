@@ -45,6 +45,15 @@
  *-----------------------------------------------------------
  */
 
+/* Words of an FPU save area: D0-D31, FPSCR and a word to keep 8-byte
+ * alignment.  Used for the lazily switched registers at the top of each task
+ * stack and for the save area of each core for interrupt handlers, by port.c,
+ * portASM.S and the application's integer only interrupt handler call.  This
+ * is the only part of this file the assembler sees. */
+#define portFPU_LAZY_AREA_WORDS    ( ( 32 * 2 ) + 2 )
+
+#ifndef __ASSEMBLER__
+
 /* Type definitions. */
 #define portCHAR          char
 #define portFLOAT         float
@@ -76,15 +85,16 @@ typedef uint32_t         TickType_t;
 
 /* Task utilities. */
 
-/* Called at the end of an ISR that can cause a context switch. */
-#define portEND_SWITCHING_ISR( xSwitchRequired ) \
-    {                                            \
-        extern uint32_t ulPortYieldRequired;     \
-                                                 \
-        if( xSwitchRequired != pdFALSE )         \
-        {                                        \
-            ulPortYieldRequired = pdTRUE;        \
-        }                                        \
+/* Called at the end of an ISR that can cause a context switch.  The port keeps
+ * one yield flag per core. */
+#define portEND_SWITCHING_ISR( xSwitchRequired )                  \
+    {                                                             \
+        extern volatile uint32_t ulPortYieldRequired[];           \
+                                                                  \
+        if( xSwitchRequired != pdFALSE )                          \
+        {                                                         \
+            ulPortYieldRequired[ portGET_CORE_ID() ] = pdTRUE;    \
+        }                                                         \
     }
 
 #define portYIELD_FROM_ISR( x )    portEND_SWITCHING_ISR( x )
@@ -103,8 +113,10 @@ extern void vPortInstallFreeRTOSVectorTable( void );
 
 /* These macros do not globally disable/enable interrupts.  They do mask off
  * interrupts that have a priority below configMAX_API_CALL_INTERRUPT_PRIORITY. */
-#define portENTER_CRITICAL()                      vPortEnterCritical();
-#define portEXIT_CRITICAL()                       vPortExitCritical();
+#if ( configNUMBER_OF_CORES == 1 )
+    #define portENTER_CRITICAL()                  vPortEnterCritical();
+    #define portEXIT_CRITICAL()                   vPortExitCritical();
+#endif
 #define portDISABLE_INTERRUPTS()                  ulPortSetInterruptMask()
 #define portENABLE_INTERRUPTS()                   vPortClearInterruptMask( 0 )
 #define portSET_INTERRUPT_MASK_FROM_ISR()         ulPortSetInterruptMask()
@@ -112,6 +124,63 @@ extern void vPortInstallFreeRTOSVectorTable( void );
 
 /*-----------------------------------------------------------*/
 
+/* SMP (configNUMBER_OF_CORES > 1) support. */
+
+/* The port keeps the critical nesting count, interrupt nesting count, yield
+ * flag and FPU state of each core in arrays indexed by the core ID.  The core
+ * ID is the CPU ID field of the MPIDR. */
+static inline __attribute__( ( always_inline ) ) BaseType_t xPortGetCoreID( void )
+{
+    uint32_t ulMPIDR;
+
+    __asm volatile ( "MRC p15, 0, %0, c0, c0, 5" : "=r" ( ulMPIDR ) );
+
+    return ( BaseType_t ) ( ulMPIDR & 0x3UL );
+}
+
+#if ( configNUMBER_OF_CORES > 1 )
+    extern volatile uint32_t ulCriticalNesting[];
+    extern volatile uint32_t ulPortInterruptNesting[];
+
+    extern void vTaskEnterCritical( void );
+    extern void vTaskExitCritical( void );
+    extern UBaseType_t vTaskEnterCriticalFromISR( void );
+    extern void vTaskExitCriticalFromISR( UBaseType_t uxSavedInterruptStatus );
+    extern void vPortYieldCore( BaseType_t xCoreID );
+    extern void vPortRecursiveLock( uint32_t ulLockNum, BaseType_t xAcquire );
+
+    #define portGET_CORE_ID()                           xPortGetCoreID()
+    #define portYIELD_CORE( x )                         vPortYieldCore( x )
+
+    /* The kernel takes care of the critical nesting count, locking and
+     * yielding in SMP builds. */
+    #define portENTER_CRITICAL()                        vTaskEnterCritical()
+    #define portEXIT_CRITICAL()                         vTaskExitCritical()
+    #define portENTER_CRITICAL_FROM_ISR()               vTaskEnterCriticalFromISR()
+    #define portEXIT_CRITICAL_FROM_ISR( x )             vTaskExitCriticalFromISR( x )
+    #define portSET_INTERRUPT_MASK()                    ulPortSetInterruptMask()
+    #define portCLEAR_INTERRUPT_MASK( x )               vPortClearInterruptMask( x )
+
+    #define portGET_CRITICAL_NESTING_COUNT()            ( ulCriticalNesting[ portGET_CORE_ID() ] )
+    #define portSET_CRITICAL_NESTING_COUNT( x )         ( ulCriticalNesting[ portGET_CORE_ID() ] = ( x ) )
+    #define portINCREMENT_CRITICAL_NESTING_COUNT()      ( ulCriticalNesting[ portGET_CORE_ID() ]++ )
+    #define portDECREMENT_CRITICAL_NESTING_COUNT()      ( ulCriticalNesting[ portGET_CORE_ID() ]-- )
+
+    #define portASSERT_IF_IN_ISR()                      configASSERT( ulPortInterruptNesting[ portGET_CORE_ID() ] == 0UL )
+
+    /* The task lock and ISR lock are recursive spinlocks built on
+     * LDREX/STREX, see vPortRecursiveLock() in port.c.  They are always taken
+     * with interrupts masked. */
+    #define portTASK_LOCK                               0UL
+    #define portISR_LOCK                                1UL
+    #define portGET_TASK_LOCK()                         vPortRecursiveLock( portTASK_LOCK, pdTRUE )
+    #define portRELEASE_TASK_LOCK()                     vPortRecursiveLock( portTASK_LOCK, pdFALSE )
+    #define portGET_ISR_LOCK()                          vPortRecursiveLock( portISR_LOCK, pdTRUE )
+    #define portRELEASE_ISR_LOCK()                      vPortRecursiveLock( portISR_LOCK, pdFALSE )
+#endif /* configNUMBER_OF_CORES */
+
+/*-----------------------------------------------------------*/
+
 /* Task function macros as described on the FreeRTOS.org WEB site.  These are
  * not required for this port but included in case common demo code that uses these
  * macros is used. */
@@ -122,12 +191,26 @@ extern void vPortInstallFreeRTOSVectorTable( void );
  * handler for whichever peripheral is used to generate the RTOS tick. */
 void FreeRTOS_Tick_Handler( void );
 
+/* Prototype of the FreeRTOS cross core yield handler.  In SMP builds this must
+ * be installed as the handler for the software generated interrupt that
+ * configTRIGGER_YIELD_INTERRUPT() sends to another core. */
+void FreeRTOS_Yield_Handler( void );
+
+/* Called by each secondary core once it has been started by
+ * configSTART_SECONDARY_CORES() and has initialised its own GIC CPU interface.
+ * It does not return. */
+void vPortStartSecondaryCore( void );
+
 /* If configUSE_TASK_FPU_SUPPORT is set to 1 (or left undefined) then tasks are
  * created without an FPU context and must call vPortTaskUsesFPU() to give
  * themselves an FPU context before using any FPU instructions.  If
  * configUSE_TASK_FPU_SUPPORT is set to 2 then all tasks will have an FPU context
- * by default. */
-#if ( configUSE_TASK_FPU_SUPPORT != 2 )
+ * by default.  If configUSE_TASK_FPU_SUPPORT is set to 3 then all tasks will
+ * have an FPU context that is only switched when a task executes a VFP/NEON
+ * instruction while another task owns the FPU registers.  This requires
+ * FreeRTOS_Undef_Handler to be installed as the undefined instruction handler.
+ * Kernel code executed during a context switch must not use the FPU. */
+#if ( configUSE_TASK_FPU_SUPPORT != 2 ) && ( configUSE_TASK_FPU_SUPPORT != 3 )
     void vPortTaskUsesFPU( void );
 #else
 
@@ -137,6 +220,12 @@ void FreeRTOS_Tick_Handler( void );
 #endif
 #define portTASK_USES_FLOATING_POINT()    vPortTaskUsesFPU()
 
+/* A task that is deleted while owning the FPU registers must release them. */
+#if ( configUSE_TASK_FPU_SUPPORT == 3 )
+    void vPortCleanUpTCB( void * pxTCB );
+    #define portCLEAN_UP_TCB( pxTCB )    vPortCleanUpTCB( pxTCB )
+#endif
+
 #define portLOWEST_INTERRUPT_PRIORITY           ( ( ( uint32_t ) configUNIQUE_INTERRUPT_PRIORITIES ) - 1UL )
 #define portLOWEST_USABLE_INTERRUPT_PRIORITY    ( portLOWEST_INTERRUPT_PRIORITY - 1UL )
 
@@ -186,6 +275,13 @@ void FreeRTOS_Tick_Handler( void );
     #error Invalid configUNIQUE_INTERRUPT_PRIORITIES setting.  configUNIQUE_INTERRUPT_PRIORITIES must be set to the number of unique priorities implemented by the target hardware
 #endif /* if configUNIQUE_INTERRUPT_PRIORITIES == 16 */
 
+/* Tickless idle.  The application provides vPortSuppressTicksAndSleep(), which
+ * stops the tick and sleeps until the next task unblocks. */
+#if ( configUSE_TICKLESS_IDLE == 1 )
+    extern void vPortSuppressTicksAndSleep( TickType_t xExpectedIdleTime );
+    #define portSUPPRESS_TICKS_AND_SLEEP( xExpectedIdleTime )    vPortSuppressTicksAndSleep( xExpectedIdleTime )
+#endif
+
 /* Interrupt controller access addresses. */
 #define portICCPMR_PRIORITY_MASK_OFFSET                      ( 0x04 )
 #define portICCIAR_INTERRUPT_ACKNOWLEDGE_OFFSET              ( 0x0C )
@@ -203,6 +299,8 @@ void FreeRTOS_Tick_Handler( void );
 
 #define portMEMORY_BARRIER()    __asm volatile ( "" ::: "memory" )
 
+#endif /* __ASSEMBLER__ */
+
 /* *INDENT-OFF* */
 #ifdef __cplusplus
     }
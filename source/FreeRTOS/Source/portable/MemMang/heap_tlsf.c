@@ -0,0 +1,746 @@
+/*
+ * FreeRTOS Kernel V11.1.0
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * An implementation of pvPortMalloc() and vPortFree() using the Two-Level
+ * Segregated Fit (TLSF) allocator, so that both take a bounded, constant time
+ * regardless of the number of free blocks or how fragmented the heap is.
+ *
+ * Free blocks are kept in segregated lists, indexed by a first level (the power
+ * of 2 of the block size) and a second level (heapSL_INDEX_COUNT linear
+ * subdivisions of that power of 2).  Two levels of bitmaps record which lists
+ * are not empty, so a list holding a block that is large enough is found with
+ * two count leading zero instructions.  Each block records the size of its own
+ * and whether the physically previous block is free, so adjacent free blocks
+ * are combined as blocks are freed, without searching.
+ *
+ * The heap starts with ucHeap[ configTOTAL_HEAP_SIZE ], the same as heap_4.c.
+ * More non-contiguous regions, e.g. on-chip RAM and DDR, can be added with
+ * vPortDefineHeapRegions(), which takes the same array of HeapRegion_t
+ * structures as heap_5.c.
+ *
+ * Select it instead of heap_4.c with the make option heap=tlsf.
+ */
+#include <stdlib.h>
+#include <string.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+ * all the API functions to use the MPU wrappers.  That should only be done when
+ * task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#if ( configSUPPORT_DYNAMIC_ALLOCATION == 0 )
+    #error This file must not be used if configSUPPORT_DYNAMIC_ALLOCATION is 0
+#endif
+
+#ifndef configHEAP_CLEAR_MEMORY_ON_FREE
+    #define configHEAP_CLEAR_MEMORY_ON_FREE    0
+#endif
+
+/* Number of second level lists per first level, as a power of 2. */
+#define heapSL_INDEX_COUNT_LOG2    ( 4 )
+#define heapSL_INDEX_COUNT         ( 1 << heapSL_INDEX_COUNT_LOG2 )
+
+/* Block sizes are a multiple of portBYTE_ALIGNMENT (8 on this port). */
+#define heapALIGN_SIZE_LOG2        ( 3 )
+#define heapALIGN_SIZE             ( ( size_t ) 1 << heapALIGN_SIZE_LOG2 )
+
+/* Blocks smaller than heapSMALL_BLOCK_SIZE all go in the first level 0 lists,
+ * which are linearly subdivided.  The largest block is 2^heapFL_INDEX_MAX
+ * bytes, which covers the 1GB of DDR on the DE10-Nano. */
+#define heapFL_INDEX_MAX           ( 30 )
+#define heapFL_INDEX_SHIFT         ( heapSL_INDEX_COUNT_LOG2 + heapALIGN_SIZE_LOG2 )
+#define heapFL_INDEX_COUNT         ( heapFL_INDEX_MAX - heapFL_INDEX_SHIFT + 1 )
+#define heapSMALL_BLOCK_SIZE       ( ( size_t ) 1 << heapFL_INDEX_SHIFT )
+
+/* The two low bits of xSize are always 0 in a size, so hold the block flags. */
+#define heapBLOCK_FREE_BIT         ( ( size_t ) 1 )
+#define heapBLOCK_PREV_FREE_BIT    ( ( size_t ) 2 )
+#define heapBLOCK_FLAGS_MASK       ( heapBLOCK_FREE_BIT | heapBLOCK_PREV_FREE_BIT )
+
+/* Max value that fits in a size_t type. */
+#define heapSIZE_MAX               ( ~( ( size_t ) 0 ) )
+
+/* Check if multiplying a and b will result in overflow. */
+#define heapMULTIPLY_WILL_OVERFLOW( a, b )    ( ( ( a ) > 0 ) && ( ( b ) > ( heapSIZE_MAX / ( a ) ) ) )
+
+/*-----------------------------------------------------------*/
+
+/* Allocate the memory for the heap. */
+#if ( configAPPLICATION_ALLOCATED_HEAP == 1 )
+
+/* The application writer has already defined the array used for the RTOS
+* heap - probably so it can be placed in a special segment or address. */
+    extern uint8_t ucHeap[ configTOTAL_HEAP_SIZE ];
+#else
+    PRIVILEGED_DATA static uint8_t ucHeap[ configTOTAL_HEAP_SIZE ];
+#endif /* configAPPLICATION_ALLOCATED_HEAP */
+
+/* The header of a block, the two words before the memory returned to the
+ * application.  pxPrevPhys is only valid while the previous block is free.
+ * pxNextFree and pxPrevFree are in the memory of the block itself, so are only
+ * valid while the block is free. */
+typedef struct A_TLSF_BLOCK
+{
+    struct A_TLSF_BLOCK * pxPrevPhys; /**< The physically previous block, if it is free. */
+    size_t xSize;                     /**< Size of the block memory, and the block flags. */
+    struct A_TLSF_BLOCK * pxNextFree; /**< Next block in the same free list. */
+    struct A_TLSF_BLOCK * pxPrevFree; /**< Previous block in the same free list. */
+} TLSFBlock_t;
+
+/* Offset from the block to the memory returned to the application. */
+#define heapBLOCK_START_OFFSET     ( offsetof( TLSFBlock_t, xSize ) + sizeof( size_t ) )
+
+/* Space used by a block in addition to its memory.  It is a multiple of
+ * portBYTE_ALIGNMENT so that splitting a block keeps both halves aligned. */
+#define heapBLOCK_OVERHEAD         heapBLOCK_START_OFFSET
+
+/* A free block must hold the free list pointers. */
+#define heapBLOCK_SIZE_MIN         ( ( size_t ) 16 )
+#define heapBLOCK_SIZE_MAX         ( ( size_t ) 1 << heapFL_INDEX_MAX )
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Called automatically to add ucHeap the first time pvPortMalloc() or
+ * vPortDefineHeapRegions() is called.
+ */
+static void prvHeapInit( void ) PRIVILEGED_FUNCTION;
+
+/*
+ * Adds a region of memory to the heap as one free block, followed by a zero
+ * sized allocated block that stops it being combined past the region end.
+ */
+static void prvAddRegion( uint8_t * pucStart,
+                          size_t xSizeInBytes ) PRIVILEGED_FUNCTION;
+
+static void prvInsertFreeBlock( TLSFBlock_t * pxBlock ) PRIVILEGED_FUNCTION;
+static void prvRemoveFreeBlock( TLSFBlock_t * pxBlock ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------*/
+
+/* An empty free list points to xNullBlock instead of NULL, which saves a test
+ * when a block is removed from a list. */
+PRIVILEGED_DATA static TLSFBlock_t xNullBlock;
+
+/* The first level bitmap, the second level bitmaps and the free lists. */
+PRIVILEGED_DATA static uint32_t ulFLBitmap;
+PRIVILEGED_DATA static uint32_t ulSLBitmap[ heapFL_INDEX_COUNT ];
+PRIVILEGED_DATA static TLSFBlock_t * pxFreeLists[ heapFL_INDEX_COUNT ][ heapSL_INDEX_COUNT ];
+
+PRIVILEGED_DATA static BaseType_t xHeapHasBeenInitialised = pdFALSE;
+
+/* Keeps track of the number of calls to allocate and free memory as well as the
+ * number of free bytes remaining, but says nothing about fragmentation. */
+PRIVILEGED_DATA static size_t xFreeBytesRemaining = ( size_t ) 0U;
+PRIVILEGED_DATA static size_t xMinimumEverFreeBytesRemaining = ( size_t ) 0U;
+PRIVILEGED_DATA static size_t xNumberOfSuccessfulAllocations = ( size_t ) 0U;
+PRIVILEGED_DATA static size_t xNumberOfSuccessfulFrees = ( size_t ) 0U;
+
+/*-----------------------------------------------------------*/
+
+/* Index of the most and least significant set bit, the value must not be 0. */
+static portINLINE uint32_t prvFLS( size_t xValue )
+{
+    return ( uint32_t ) ( 31 - __builtin_clz( ( uint32_t ) xValue ) );
+}
+
+static portINLINE uint32_t prvFFS( uint32_t ulValue )
+{
+    return ( uint32_t ) __builtin_ctz( ulValue );
+}
+
+static portINLINE size_t prvBlockSize( const TLSFBlock_t * pxBlock )
+{
+    return pxBlock->xSize & ~heapBLOCK_FLAGS_MASK;
+}
+
+static portINLINE void prvBlockSetSize( TLSFBlock_t * pxBlock,
+                                        size_t xSize )
+{
+    pxBlock->xSize = xSize | ( pxBlock->xSize & heapBLOCK_FLAGS_MASK );
+}
+
+static portINLINE BaseType_t prvBlockIsFree( const TLSFBlock_t * pxBlock )
+{
+    return ( pxBlock->xSize & heapBLOCK_FREE_BIT ) != 0 ? pdTRUE : pdFALSE;
+}
+
+static portINLINE BaseType_t prvBlockIsPrevFree( const TLSFBlock_t * pxBlock )
+{
+    return ( pxBlock->xSize & heapBLOCK_PREV_FREE_BIT ) != 0 ? pdTRUE : pdFALSE;
+}
+
+static portINLINE void * prvBlockToPtr( TLSFBlock_t * pxBlock )
+{
+    return ( void * ) ( ( ( uint8_t * ) pxBlock ) + heapBLOCK_START_OFFSET );
+}
+
+static portINLINE TLSFBlock_t * prvBlockFromPtr( void * pv )
+{
+    return ( TLSFBlock_t * ) ( ( ( uint8_t * ) pv ) - heapBLOCK_START_OFFSET );
+}
+
+/* The physically next block, which starts straight after this block memory. */
+static portINLINE TLSFBlock_t * prvBlockNext( TLSFBlock_t * pxBlock )
+{
+    return ( TLSFBlock_t * ) ( ( ( uint8_t * ) prvBlockToPtr( pxBlock ) ) + prvBlockSize( pxBlock ) );
+}
+
+/* Marks the block free, and tells the next block about it. */
+static portINLINE void prvBlockMarkFree( TLSFBlock_t * pxBlock )
+{
+    TLSFBlock_t * pxNext = prvBlockNext( pxBlock );
+
+    pxNext->pxPrevPhys = pxBlock;
+    pxNext->xSize |= heapBLOCK_PREV_FREE_BIT;
+    pxBlock->xSize |= heapBLOCK_FREE_BIT;
+}
+
+static portINLINE void prvBlockMarkUsed( TLSFBlock_t * pxBlock )
+{
+    TLSFBlock_t * pxNext = prvBlockNext( pxBlock );
+
+    pxNext->xSize &= ~heapBLOCK_PREV_FREE_BIT;
+    pxBlock->xSize &= ~heapBLOCK_FREE_BIT;
+}
+
+/*-----------------------------------------------------------*/
+
+/* The free list that a block of xSize bytes is kept in. */
+static void prvMappingInsert( size_t xSize,
+                              uint32_t * pulFL,
+                              uint32_t * pulSL )
+{
+    uint32_t ulFL, ulSL;
+
+    if( xSize < heapSMALL_BLOCK_SIZE )
+    {
+        ulFL = 0;
+        ulSL = ( uint32_t ) ( xSize / ( heapSMALL_BLOCK_SIZE / heapSL_INDEX_COUNT ) );
+    }
+    else
+    {
+        ulFL = prvFLS( xSize );
+        ulSL = ( uint32_t ) ( xSize >> ( ulFL - heapSL_INDEX_COUNT_LOG2 ) ) ^ ( 1U << heapSL_INDEX_COUNT_LOG2 );
+        ulFL -= ( heapFL_INDEX_SHIFT - 1 );
+    }
+
+    *pulFL = ulFL;
+    *pulSL = ulSL;
+}
+
+/* The first free list whose blocks are all at least xSize bytes.  The size is
+ * rounded up to the next list, so any block in it will do and the search
+ * doesn't have to walk the list. */
+static void prvMappingSearch( size_t xSize,
+                              uint32_t * pulFL,
+                              uint32_t * pulSL )
+{
+    if( xSize >= heapSMALL_BLOCK_SIZE )
+    {
+        xSize += ( ( size_t ) 1 << ( prvFLS( xSize ) - heapSL_INDEX_COUNT_LOG2 ) ) - 1;
+    }
+
+    prvMappingInsert( xSize, pulFL, pulSL );
+}
+
+/* Finds a non-empty free list at or above the given one, using the bitmaps. */
+static TLSFBlock_t * prvSearchSuitableBlock( uint32_t * pulFL,
+                                             uint32_t * pulSL )
+{
+    uint32_t ulFL = *pulFL;
+    uint32_t ulSL = *pulSL;
+    uint32_t ulSLMap, ulFLMap;
+
+    ulSLMap = ulSLBitmap[ ulFL ] & ( ~0U << ulSL );
+
+    if( ulSLMap == 0 )
+    {
+        /* No block in this first level, use the next one up that has one. */
+        ulFLMap = ( ulFL + 1 < 32 ) ? ( ulFLBitmap & ( ~0U << ( ulFL + 1 ) ) ) : 0;
+
+        if( ulFLMap == 0 )
+        {
+            return NULL;
+        }
+
+        ulFL = prvFFS( ulFLMap );
+        ulSLMap = ulSLBitmap[ ulFL ];
+    }
+
+    ulSL = prvFFS( ulSLMap );
+
+    *pulFL = ulFL;
+    *pulSL = ulSL;
+
+    return pxFreeLists[ ulFL ][ ulSL ];
+}
+
+static void prvInsertFreeBlock( TLSFBlock_t * pxBlock ) /* PRIVILEGED_FUNCTION */
+{
+    uint32_t ulFL, ulSL;
+    TLSFBlock_t * pxCurrent;
+
+    prvMappingInsert( prvBlockSize( pxBlock ), &ulFL, &ulSL );
+
+    pxCurrent = pxFreeLists[ ulFL ][ ulSL ];
+    pxBlock->pxNextFree = pxCurrent;
+    pxBlock->pxPrevFree = &xNullBlock;
+    pxCurrent->pxPrevFree = pxBlock;
+
+    pxFreeLists[ ulFL ][ ulSL ] = pxBlock;
+    ulFLBitmap |= ( 1U << ulFL );
+    ulSLBitmap[ ulFL ] |= ( 1U << ulSL );
+}
+
+static void prvRemoveFreeBlock( TLSFBlock_t * pxBlock ) /* PRIVILEGED_FUNCTION */
+{
+    uint32_t ulFL, ulSL;
+    TLSFBlock_t * pxPrev = pxBlock->pxPrevFree;
+    TLSFBlock_t * pxNext = pxBlock->pxNextFree;
+
+    prvMappingInsert( prvBlockSize( pxBlock ), &ulFL, &ulSL );
+
+    pxNext->pxPrevFree = pxPrev;
+    pxPrev->pxNextFree = pxNext;
+
+    /* If the block is the head of its list, the list has a new head, and if
+     * that is the null block the list is now empty. */
+    if( pxFreeLists[ ulFL ][ ulSL ] == pxBlock )
+    {
+        pxFreeLists[ ulFL ][ ulSL ] = pxNext;
+
+        if( pxNext == &xNullBlock )
+        {
+            ulSLBitmap[ ulFL ] &= ~( 1U << ulSL );
+
+            if( ulSLBitmap[ ulFL ] == 0 )
+            {
+                ulFLBitmap &= ~( 1U << ulFL );
+            }
+        }
+    }
+}
+
+/* Combines the block with the physically previous block, if that is free. */
+static TLSFBlock_t * prvMergePrev( TLSFBlock_t * pxBlock )
+{
+    TLSFBlock_t * pxPrev;
+
+    if( prvBlockIsPrevFree( pxBlock ) != pdFALSE )
+    {
+        pxPrev = pxBlock->pxPrevPhys;
+        prvRemoveFreeBlock( pxPrev );
+        prvBlockSetSize( pxPrev, prvBlockSize( pxPrev ) + prvBlockSize( pxBlock ) + heapBLOCK_OVERHEAD );
+        pxBlock = pxPrev;
+        prvBlockNext( pxBlock )->pxPrevPhys = pxBlock;
+    }
+
+    return pxBlock;
+}
+
+/* Combines the block with the physically next block, if that is free. */
+static TLSFBlock_t * prvMergeNext( TLSFBlock_t * pxBlock )
+{
+    TLSFBlock_t * pxNext = prvBlockNext( pxBlock );
+
+    if( prvBlockIsFree( pxNext ) != pdFALSE )
+    {
+        prvRemoveFreeBlock( pxNext );
+        prvBlockSetSize( pxBlock, prvBlockSize( pxBlock ) + prvBlockSize( pxNext ) + heapBLOCK_OVERHEAD );
+        prvBlockNext( pxBlock )->pxPrevPhys = pxBlock;
+    }
+
+    return pxBlock;
+}
+
+/* Splits the end of a free block that isn't needed into a new free block, if
+ * it is big enough to be one. */
+static void prvTrimFree( TLSFBlock_t * pxBlock,
+                         size_t xSize )
+{
+    TLSFBlock_t * pxRemaining;
+    size_t xRemainingSize;
+
+    if( prvBlockSize( pxBlock ) >= xSize + heapBLOCK_OVERHEAD + heapBLOCK_SIZE_MIN )
+    {
+        pxRemaining = ( TLSFBlock_t * ) ( ( ( uint8_t * ) prvBlockToPtr( pxBlock ) ) + xSize );
+        xRemainingSize = prvBlockSize( pxBlock ) - ( xSize + heapBLOCK_OVERHEAD );
+        configASSERT( ( ( ( size_t ) prvBlockToPtr( pxRemaining ) ) & portBYTE_ALIGNMENT_MASK ) == 0 );
+
+        pxRemaining->xSize = xRemainingSize;
+        prvBlockSetSize( pxBlock, xSize );
+
+        /* pxBlock is marked as used by the caller, which also clears the
+         * previous free bit of pxRemaining. */
+        prvBlockMarkFree( pxRemaining );
+        prvInsertFreeBlock( pxRemaining );
+    }
+}
+
+/*-----------------------------------------------------------*/
+
+void * pvPortMalloc( size_t xWantedSize )
+{
+    TLSFBlock_t * pxBlock = NULL;
+    void * pvReturn = NULL;
+    size_t xAdjustedSize = 0;
+    uint32_t ulFL, ulSL;
+
+    /* Round up to the alignment and the smallest block.  Requests that can
+     * never be met are left as 0 and fail. */
+    if( ( xWantedSize > 0 ) && ( xWantedSize < heapBLOCK_SIZE_MAX ) )
+    {
+        xAdjustedSize = ( xWantedSize + ( heapALIGN_SIZE - 1 ) ) & ~( heapALIGN_SIZE - 1 );
+
+        if( xAdjustedSize < heapBLOCK_SIZE_MIN )
+        {
+            xAdjustedSize = heapBLOCK_SIZE_MIN;
+        }
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    vTaskSuspendAll();
+    {
+        /* If this is the first call to malloc then the heap will require
+         * initialisation to setup the list of free blocks. */
+        if( xHeapHasBeenInitialised == pdFALSE )
+        {
+            prvHeapInit();
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        if( ( xAdjustedSize > 0 ) && ( xAdjustedSize <= xFreeBytesRemaining ) )
+        {
+            prvMappingSearch( xAdjustedSize, &ulFL, &ulSL );
+
+            if( ulFL < heapFL_INDEX_COUNT )
+            {
+                pxBlock = prvSearchSuitableBlock( &ulFL, &ulSL );
+            }
+
+            if( pxBlock != NULL )
+            {
+                configASSERT( prvBlockSize( pxBlock ) >= xAdjustedSize );
+
+                prvRemoveFreeBlock( pxBlock );
+                prvTrimFree( pxBlock, xAdjustedSize );
+                prvBlockMarkUsed( pxBlock );
+                pvReturn = prvBlockToPtr( pxBlock );
+
+                xFreeBytesRemaining -= prvBlockSize( pxBlock ) + heapBLOCK_OVERHEAD;
+
+                if( xFreeBytesRemaining < xMinimumEverFreeBytesRemaining )
+                {
+                    xMinimumEverFreeBytesRemaining = xFreeBytesRemaining;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                xNumberOfSuccessfulAllocations++;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        traceMALLOC( pvReturn, xAdjustedSize );
+    }
+    ( void ) xTaskResumeAll();
+
+    #if ( configUSE_MALLOC_FAILED_HOOK == 1 )
+    {
+        if( pvReturn == NULL )
+        {
+            vApplicationMallocFailedHook();
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    #endif /* if ( configUSE_MALLOC_FAILED_HOOK == 1 ) */
+
+    configASSERT( ( ( ( size_t ) pvReturn ) & ( size_t ) portBYTE_ALIGNMENT_MASK ) == 0 );
+    return pvReturn;
+}
+/*-----------------------------------------------------------*/
+
+void vPortFree( void * pv )
+{
+    TLSFBlock_t * pxBlock;
+
+    if( pv != NULL )
+    {
+        pxBlock = prvBlockFromPtr( pv );
+
+        configASSERT( prvBlockIsFree( pxBlock ) == pdFALSE );
+
+        if( prvBlockIsFree( pxBlock ) == pdFALSE )
+        {
+            #if ( configHEAP_CLEAR_MEMORY_ON_FREE == 1 )
+            {
+                ( void ) memset( pv, 0, prvBlockSize( pxBlock ) );
+            }
+            #endif
+
+            vTaskSuspendAll();
+            {
+                xFreeBytesRemaining += prvBlockSize( pxBlock ) + heapBLOCK_OVERHEAD;
+                traceFREE( pv, prvBlockSize( pxBlock ) );
+
+                prvBlockMarkFree( pxBlock );
+                pxBlock = prvMergePrev( pxBlock );
+                pxBlock = prvMergeNext( pxBlock );
+                prvInsertFreeBlock( pxBlock );
+
+                xNumberOfSuccessfulFrees++;
+            }
+            ( void ) xTaskResumeAll();
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+size_t xPortGetFreeHeapSize( void )
+{
+    return xFreeBytesRemaining;
+}
+/*-----------------------------------------------------------*/
+
+size_t xPortGetMinimumEverFreeHeapSize( void )
+{
+    return xMinimumEverFreeBytesRemaining;
+}
+/*-----------------------------------------------------------*/
+
+void vPortInitialiseBlocks( void )
+{
+    /* This just exists to keep the linker quiet. */
+}
+/*-----------------------------------------------------------*/
+
+void * pvPortCalloc( size_t xNum,
+                     size_t xSize )
+{
+    void * pv = NULL;
+
+    if( heapMULTIPLY_WILL_OVERFLOW( xNum, xSize ) == 0 )
+    {
+        pv = pvPortMalloc( xNum * xSize );
+
+        if( pv != NULL )
+        {
+            ( void ) memset( pv, 0, xNum * xSize );
+        }
+    }
+
+    return pv;
+}
+/*-----------------------------------------------------------*/
+
+void vPortDefineHeapRegions( const HeapRegion_t * const pxHeapRegions ) /* PRIVILEGED_FUNCTION */
+{
+    const HeapRegion_t * pxHeapRegion;
+
+    vTaskSuspendAll();
+    {
+        if( xHeapHasBeenInitialised == pdFALSE )
+        {
+            prvHeapInit();
+        }
+
+        /* The array is terminated by a region with a size of 0. */
+        for( pxHeapRegion = pxHeapRegions; pxHeapRegion->xSizeInBytes > 0; pxHeapRegion++ )
+        {
+            prvAddRegion( pxHeapRegion->pucStartAddress, pxHeapRegion->xSizeInBytes );
+        }
+    }
+    ( void ) xTaskResumeAll();
+}
+/*-----------------------------------------------------------*/
+
+static void prvHeapInit( void ) /* PRIVILEGED_FUNCTION */
+{
+    uint32_t ulFL, ulSL;
+
+    xNullBlock.pxNextFree = &xNullBlock;
+    xNullBlock.pxPrevFree = &xNullBlock;
+
+    ulFLBitmap = 0;
+
+    for( ulFL = 0; ulFL < heapFL_INDEX_COUNT; ulFL++ )
+    {
+        ulSLBitmap[ ulFL ] = 0;
+
+        for( ulSL = 0; ulSL < heapSL_INDEX_COUNT; ulSL++ )
+        {
+            pxFreeLists[ ulFL ][ ulSL ] = &xNullBlock;
+        }
+    }
+
+    xHeapHasBeenInitialised = pdTRUE;
+
+    prvAddRegion( ucHeap, configTOTAL_HEAP_SIZE );
+}
+/*-----------------------------------------------------------*/
+
+static void prvAddRegion( uint8_t * pucStart,
+                          size_t xSizeInBytes ) /* PRIVILEGED_FUNCTION */
+{
+    portPOINTER_SIZE_TYPE uxStartAddress, uxEndAddress;
+    TLSFBlock_t * pxBlock;
+    TLSFBlock_t * pxSentinel;
+    size_t xBlockSize;
+
+    /* Ensure the region starts on a correctly aligned boundary, then the
+     * header size keeps the block memory aligned too.  The pxPrevPhys of the
+     * first block is never used, as it has no previous block. */
+    uxStartAddress = ( portPOINTER_SIZE_TYPE ) pucStart;
+    uxEndAddress = uxStartAddress + ( portPOINTER_SIZE_TYPE ) xSizeInBytes;
+    uxStartAddress = ( uxStartAddress + portBYTE_ALIGNMENT_MASK ) & ~( ( portPOINTER_SIZE_TYPE ) portBYTE_ALIGNMENT_MASK );
+
+    /* The region holds the first block and the sentinel block header. */
+    if( uxEndAddress < uxStartAddress + heapBLOCK_OVERHEAD + heapBLOCK_SIZE_MIN + heapBLOCK_OVERHEAD )
+    {
+        return;
+    }
+
+    xBlockSize = ( size_t ) ( uxEndAddress - uxStartAddress - ( 2 * heapBLOCK_OVERHEAD ) );
+    xBlockSize &= ~( heapALIGN_SIZE - 1 );
+
+    if( xBlockSize > heapBLOCK_SIZE_MAX - heapALIGN_SIZE )
+    {
+        xBlockSize = heapBLOCK_SIZE_MAX - heapALIGN_SIZE;
+    }
+
+    pxBlock = ( TLSFBlock_t * ) uxStartAddress;
+    pxBlock->xSize = xBlockSize;
+
+    /* The sentinel is a zero sized allocated block, it is never combined so
+     * blocks of different regions are never combined either. */
+    pxSentinel = prvBlockNext( pxBlock );
+    pxSentinel->xSize = 0;
+
+    prvBlockMarkFree( pxBlock );
+    prvInsertFreeBlock( pxBlock );
+
+    xFreeBytesRemaining += xBlockSize + heapBLOCK_OVERHEAD;
+    xMinimumEverFreeBytesRemaining += xBlockSize + heapBLOCK_OVERHEAD;
+}
+/*-----------------------------------------------------------*/
+
+void vPortGetHeapStats( HeapStats_t * pxHeapStats )
+{
+    TLSFBlock_t * pxBlock;
+    uint32_t ulFL, ulSL;
+    size_t xBlocks = 0, xMaxSize = 0, xMinSize = portMAX_DELAY; /* portMAX_DELAY used as a portable way of getting the maximum value. */
+
+    /* Walks every free list, so unlike pvPortMalloc() and vPortFree() this
+     * takes a time proportional to the number of free blocks. */
+    vTaskSuspendAll();
+    {
+        if( xHeapHasBeenInitialised != pdFALSE )
+        {
+            for( ulFL = 0; ulFL < heapFL_INDEX_COUNT; ulFL++ )
+            {
+                for( ulSL = 0; ulSL < heapSL_INDEX_COUNT; ulSL++ )
+                {
+                    for( pxBlock = pxFreeLists[ ulFL ][ ulSL ]; pxBlock != &xNullBlock; pxBlock = pxBlock->pxNextFree )
+                    {
+                        xBlocks++;
+
+                        if( prvBlockSize( pxBlock ) > xMaxSize )
+                        {
+                            xMaxSize = prvBlockSize( pxBlock );
+                        }
+
+                        if( prvBlockSize( pxBlock ) < xMinSize )
+                        {
+                            xMinSize = prvBlockSize( pxBlock );
+                        }
+                    }
+                }
+            }
+        }
+    }
+    ( void ) xTaskResumeAll();
+
+    pxHeapStats->xSizeOfLargestFreeBlockInBytes = xMaxSize;
+    pxHeapStats->xSizeOfSmallestFreeBlockInBytes = xMinSize;
+    pxHeapStats->xNumberOfFreeBlocks = xBlocks;
+
+    taskENTER_CRITICAL();
+    {
+        pxHeapStats->xAvailableHeapSpaceInBytes = xFreeBytesRemaining;
+        pxHeapStats->xNumberOfSuccessfulAllocations = xNumberOfSuccessfulAllocations;
+        pxHeapStats->xNumberOfSuccessfulFrees = xNumberOfSuccessfulFrees;
+        pxHeapStats->xMinimumEverFreeBytesRemaining = xMinimumEverFreeBytesRemaining;
+    }
+    taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+/*
+ * Reset the state in this file. This state is normally initialized at start up.
+ * This function must be called by the application before restarting the
+ * scheduler.
+ */
+void vPortHeapResetState( void )
+{
+    xHeapHasBeenInitialised = pdFALSE;
+
+    xFreeBytesRemaining = ( size_t ) 0U;
+    xMinimumEverFreeBytesRemaining = ( size_t ) 0U;
+    xNumberOfSuccessfulAllocations = ( size_t ) 0U;
+    xNumberOfSuccessfulFrees = ( size_t ) 0U;
+}
+/*-----------------------------------------------------------*/
@@ -32,6 +32,11 @@
 #include "alt_interrupt.h"
 #include "alt_globaltmr.h"
 
+/* Trulib includes. */
+#include "tru_config.h"
+#include "tru_board.h"
+#include "tru_cortex_a9.h"
+
 /*-----------------------------------------------------------
  * Application specific definitions.
  *
@@ -70,14 +75,50 @@
  * lowest priority.
  */
 
+/* 1 = tasks call vPortTaskUsesFPU() to get an FPU context, 2 = all tasks have
+an FPU context that is saved on every switch, 3 = all tasks have an FPU context
+that is only switched when another task uses the FPU (lazy switching, opt in,
+needs FreeRTOS_Undef_Handler, see freertos_c5soc.c).  With SMP 3 only helps
+tasks that don't use the FPU, see ulPortFPUSaveOnSwitch in port.c. */
 #define configUSE_TASK_FPU_SUPPORT				2
 #define configMAX_API_CALL_INTERRUPT_PRIORITY	18
 #define configAPPLICATION_ALLOCATED_HEAP		0
-#define configSUPPORT_STATIC_ALLOCATION			0
+/* The application tasks, queues and the kernel's own idle and timer tasks are
+allocated at build time, see freertos_static.h.  The heap is still available,
+the benchmarks use it. */
+#define configSUPPORT_STATIC_ALLOCATION			1
 #define configSUPPORT_DYNAMIC_ALLOCATION		1
 #define configCPU_CLOCK_HZ						/* Not used in this demo. */
-#define configUSE_PORT_OPTIMISED_TASK_SELECTION	1
-#define configUSE_TICKLESS_IDLE					0
+/* Run on both Cortex-A9 cores (SMP) when trulib is configured with TRU_SMP,
+see tru_user_config.h.  The SMP kernel does not support the optimised task
+selection. */
+#if defined(TRU_SMP) && TRU_SMP == 1U
+	#define configNUMBER_OF_CORES					2
+	#define configUSE_PORT_OPTIMISED_TASK_SELECTION	0
+	#define configRUN_MULTIPLE_PRIORITIES			1
+	#define configUSE_CORE_AFFINITY					1
+	#define configUSE_PASSIVE_IDLE_HOOK				0
+#else
+	#define configNUMBER_OF_CORES					1
+	#define configUSE_PORT_OPTIMISED_TASK_SELECTION	1
+#endif
+/* Tickless idle with TRU_TICKLESS, single core only.  The SMP kernel holds its
+task lock while the scheduler is suspended, so a sleeping core would stall the
+other one. */
+#if defined(TRU_TICKLESS) && TRU_TICKLESS == 1U
+	#define configUSE_TICKLESS_IDLE					1
+#else
+	#define configUSE_TICKLESS_IDLE					0
+#endif
+/* A newlib struct _reent per task (errno, strtok(), the printf() buffers)
+with TRU_NEWLIB_REENTRANT, single core only.  newlib finds it through the one
+global _impure_ptr, which can't follow two cores.  The newlib locks of
+freertos_newlib.c come with TRU_NEWLIB_REENTRANT on SMP too. */
+#if defined(TRU_NEWLIB_REENTRANT) && TRU_NEWLIB_REENTRANT == 1U && configNUMBER_OF_CORES == 1
+	#define configUSE_NEWLIB_REENTRANT				1
+#else
+	#define configUSE_NEWLIB_REENTRANT				0
+#endif
 #define configTICK_RATE_HZ						( ( TickType_t ) 1000 )
 #define configUSE_PREEMPTION					1
 #define configMAX_PRIORITIES					( 7 )
@@ -119,6 +160,8 @@ to exclude the API function. */
 #define INCLUDE_vTaskDelay						1
 #define INCLUDE_xTimerPendFunctionCall			1
 #define INCLUDE_eTaskGetState					1
+#define INCLUDE_xTaskGetIdleTaskHandle			1
+#define INCLUDE_uxTaskGetStackHighWaterMark	1
 
 /* This demo makes use of one or more example stats formatting functions.  These
 format the raw data provided by the uxTaskGetSystemState() function in to human
@@ -126,10 +169,20 @@ readable ASCII form.  See the notes in the implementation of vTaskList() within
 FreeRTOS/Source/tasks.c for limitations. */
 #define configUSE_STATS_FORMATTING_FUNCTIONS	1
 
-/* Run time stats related definitions. */
+/* Run time stats related definitions.  The counter is the 64-bit global timer
+at full resolution, less the time the calling core has spent in interrupt
+handlers, so the task counters only hold task context time.  The interrupt time
+of each core is returned by ullGetISRRunTimeCounterValue(), see freertos_c5soc.c
+and freertos_stats.h.  The kernel takes the difference of the counter at a
+switch in and the following switch out, both on the same core, so the time of
+the interrupts taken on that core in between is subtracted from the task that
+they interrupted.  freertos_stats_table() shows it as a row of each core. */
 #define configGENERATE_RUN_TIME_STATS 1
-#define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS() alt_globaltmr_start()
-#define portGET_RUN_TIME_COUNTER_VALUE() ( ( uint32_t ) ( alt_globaltmr_get64() >> ( uint64_t ) 16 ) )
+#define configRUN_TIME_COUNTER_TYPE uint64_t
+#define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS() gtim_enable()
+uint64_t ullGetRunTimeCounterValue( void );
+uint64_t ullGetISRRunTimeCounterValue( uint32_t ulCoreID );
+#define portGET_RUN_TIME_COUNTER_VALUE() ullGetRunTimeCounterValue()
 
 
 /* The size of the global output buffer that is available for use when there
@@ -154,14 +207,21 @@ nothing to return to.  To avoid this define configTASK_RETURN_ADDRESS to 0.  */
 
 /****** Hardware specific settings. *******************************************/
 
+/* ulUsesFPU should be set (non-zero) for a handler that uses VFP/NEON, including
+any code generated by the compiler for it, so that the FPU registers are saved
+before it is called.  Other handlers are called with the FPU disabled and
+without saving them.  A VFP/NEON instruction in one of them, e.g. in a library
+memcpy(), is still safe, it traps and the registers are saved then, but that
+costs more than setting ulUsesFPU. */
  typedef struct INT_DISPATCH_s
  {
      alt_int_callback_t pxISR;
      void *             pvContext;
+     uint32_t           ulUsesFPU;
  }
  INT_DISPATCH_t;
 
-void vRegisterIRQHandler( uint32_t ulID, alt_int_callback_t pxHandlerFunction, void *pvContext );
+void vRegisterIRQHandler( uint32_t ulID, alt_int_callback_t pxHandlerFunction, void *pvContext, uint32_t ulUsesFPU );
 void vApplicationIRQHandler( uint32_t ulICCIAR );
 
 /*
@@ -175,11 +235,120 @@ void vConfigureTickInterrupt( void );
 #define configSETUP_TICK_INTERRUPT() vConfigureTickInterrupt();
 
 void vClearTickInterrupt( void );
-#define configCLEAR_TICK_INTERRUPT() alt_gpt_int_clear_pending( ALT_GPT_CPU_PRIVATE_TMR );
+#if configUSE_TICKLESS_IDLE == 1
+	#define configCLEAR_TICK_INTERRUPT() gtim_clear_event();
+#else
+	#define configCLEAR_TICK_INTERRUPT() alt_gpt_int_clear_pending( ALT_GPT_CPU_PRIVATE_TMR );
+#endif
+
+/* With tickless idle the tick is generated by the global timer comparator
+instead of the private timer, and the idle task sleeps until the next task
+unblocks.  See vConfigureTickInterrupt() and vPortSuppressTicksAndSleep() in
+freertos_c5soc.c, it is declared in portmacro.h where TickType_t is defined. */
+
+/* SMP only.  The software generated interrupt used by one core to make another
+core reschedule, FreeRTOS_Yield_Handler() must be installed as its handler.
+configSTART_SECONDARY_CORES() is called by core 0 as the scheduler starts, and
+configTRIGGER_YIELD_INTERRUPT() is called to interrupt the given core. */
+#define configYIELD_INTERRUPT_ID ALT_INT_INTERRUPT_SGI0
+
+void vStartSecondaryCores( void );
+#define configSTART_SECONDARY_CORES() vStartSecondaryCores()
+
+void vTriggerYieldInterrupt( long xCoreID );
+#define configTRIGGER_YIELD_INTERRUPT( xCoreID ) vTriggerYieldInterrupt( xCoreID )
+
+/* Returns pdTRUE when called by a task that may block, not before the scheduler
+starts, with it suspended, in a critical section or in an interrupt handler. */
+long xCanBlock( void );
+
+/* newlib's locks when TRU_NEWLIB_REENTRANT is 1, see freertos_newlib.c.
+vConfigureNewlibLocks() creates the mutexes of newlib's own locks, it must be
+called before the scheduler starts. */
+void vConfigureNewlibLocks( void );
+
+/* High resolution (microsecond) timer service, see tru_hrtimer.h.
+vConfigureHRTimer() initialises it and installs its interrupt.
+vHRTimerNotifyTask() is a timer callback that gives a direct to task
+notification to the task passed as the timer's context. */
+struct tru_hrtimer_s;
+void vConfigureHRTimer( void );
+void vHRTimerNotifyTask( struct tru_hrtimer_s *pxTimer, void *pvTask );
+
+/* Interrupt driven console UART transmit when TRU_UART_TX_IRQ is 1, see
+tru_c5soc_hps_uart.h.  vConfigureConsoleUART() sets it up and installs its
+interrupt, from then on _write() queues to it.  Writers block on a semaphore
+when the ring is full.  With TRU_UART_TX_DMA xConsoleUARTWriteDMA() sends a
+large buffer with a PL330 DMA channel, the task is woken by a direct to task
+notification from the DMA event interrupt when it is done.  With
+TRU_UART_RX_IRQ the receive interrupt feeds a stream buffer and _read() blocks
+on it, so fgets() and scanf() wait without polling.  With TRU_NEWLIB_REENTRANT
+tasks reading stdin take turns on newlib's stream lock. */
+void vConfigureConsoleUART( void );
+long xConsoleUARTWriteDMA( const void *pvBuffer, uint32_t ulLength );
+
+/* Kernel event trace, recorded by trulib into a RAM ring per core when
+TRU_TRACE is 1, see tru_trace.h.  vConfigureTrace() starts the recorder.  The
+hooks are expanded inside the kernel sources, so they can read the task, queue
+and timer structures.  Queues and timers are numbered by the recorder as they
+are created, tasks use the kernel's own task number.  Interrupt handlers are
+recorded by vApplicationIRQHandler(). */
+void vConfigureTrace( void );
+#if defined(TRU_TRACE) && TRU_TRACE == 1U
+	#include "tru_trace.h"
+
+	#define traceTASK_CREATE( pxNewTCB )						tru_trace_task_create( ( pxNewTCB )->uxTCBNumber, ( pxNewTCB )->pcTaskName )
+	#define traceQUEUE_CREATE( pxNewQueue )						do{ ( pxNewQueue )->uxQueueNumber = tru_trace_new_id(); tru_trace_record( TRU_TRACE_QUEUE_CREATE, ( pxNewQueue )->uxQueueNumber ); }while( 0 )
+	#define traceQUEUE_SEND( pxQueue )							tru_trace_record( TRU_TRACE_QUEUE_SEND, ( pxQueue )->uxQueueNumber )
+	#define traceQUEUE_SEND_FROM_ISR( pxQueue )					tru_trace_record( TRU_TRACE_QUEUE_SEND_FROM_ISR, ( pxQueue )->uxQueueNumber )
+	#define traceQUEUE_RECEIVE( pxQueue )						tru_trace_record( TRU_TRACE_QUEUE_RECEIVE, ( pxQueue )->uxQueueNumber )
+	#define traceQUEUE_RECEIVE_FROM_ISR( pxQueue )				tru_trace_record( TRU_TRACE_QUEUE_RECEIVE_FROM_ISR, ( pxQueue )->uxQueueNumber )
+	#define traceTIMER_CREATE( pxNewTimer )						do{ ( pxNewTimer )->uxTimerNumber = tru_trace_new_id(); tru_trace_record( TRU_TRACE_TIMER_CREATE, ( pxNewTimer )->uxTimerNumber ); }while( 0 )
+	#define traceTIMER_COMMAND_SEND( xTimer, xMessageID, xMessageValueValue, xReturn )	tru_trace_record( TRU_TRACE_TIMER_COMMAND, ( xTimer )->uxTimerNumber )
+	#define traceTIMER_EXPIRED( pxTimer )						tru_trace_record( TRU_TRACE_TIMER_EXPIRED, ( pxTimer )->uxTimerNumber )
+#endif
+
+/* Performance monitor (PMU) event counts per task when TRU_PMU is 1, see
+tru_pmu.h.  vConfigurePMU() sets up the PMU of the calling core.  The task
+switch hooks are shared with the trace recorder, whichever is turned off is an
+empty inline function.  The PMU is read first on the way out and last on the
+way in, so the trace record is not counted in the task. */
+void vConfigurePMU( void );
+#if ( defined(TRU_TRACE) && TRU_TRACE == 1U ) || ( defined(TRU_PMU) && TRU_PMU == 1U )
+	#include "tru_trace.h"
+	#include "tru_pmu.h"
+
+	#define traceTASK_SWITCHED_IN()								do{ tru_trace_record( TRU_TRACE_TASK_IN, pxCurrentTCB->uxTCBNumber ); tru_pmu_switch_in( pxCurrentTCB->uxTCBNumber ); }while( 0 )
+	#define traceTASK_SWITCHED_OUT()							do{ tru_pmu_switch_out( pxCurrentTCB->uxTCBNumber ); tru_trace_record( TRU_TRACE_TASK_OUT, pxCurrentTCB->uxTCBNumber ); }while( 0 )
+#endif
+
+/* Statistical PC sampling profiler when TRU_PROF is 1, see tru_prof.h.
+vConfigureProfiler() starts it on the calling core.  The private watchdog of
+each core interrupts at configPROFILER_RATE_HZ, which is kept off multiples of
+the tick rate.  The interrupt is one level above
+configMAX_API_CALL_INTERRUPT_PRIORITY, so it also samples the kernel critical
+sections and the interrupt handlers below it. */
+#define configPROFILER_RATE_HZ		997
+void vConfigureProfiler( void );
+
+/* Benchmarks, see bench.h.  The latency benchmark times the outermost critical
+sections of the tasks, with hooks called after entering and before leaving.
+With a single core vPortEnterCritical() and vPortExitCritical() in port.c call
+them, with SMP the kernel's own vTaskEnterCritical() and vTaskExitCritical()
+do through their trace hooks. */
+#include "bench.h"
+#if( BENCH_RUN == 1U )
+	#define portCRITICAL_SECTION_ENTERED()		bench_latency_critical_enter()
+	#define portCRITICAL_SECTION_EXITING()		bench_latency_critical_exit()
+	#if( configNUMBER_OF_CORES > 1 )
+		#define traceRETURN_vTaskEnterCritical()	do{ if( portGET_CRITICAL_NESTING_COUNT() == 1U ) portCRITICAL_SECTION_ENTERED(); }while( 0 )
+		#define traceENTER_vTaskExitCritical()		do{ if( portGET_CRITICAL_NESTING_COUNT() == 1U ) portCRITICAL_SECTION_EXITING(); }while( 0 )
+	#endif
+#endif
 
-/* The following constant describe the hardware, and are correct for the
-Cyclone V SoC. */
-#define configINTERRUPT_CONTROLLER_BASE_ADDRESS         ( 0xFFFED000 )
+/* The following constant describe the hardware.  The GIC address is of the
+board, see tru_board.h. */
+#define configINTERRUPT_CONTROLLER_BASE_ADDRESS         ( TRU_BOARD_GIC_DIST_BASE )
 #define configINTERRUPT_CONTROLLER_CPU_INTERFACE_OFFSET ( -0xf00 )
 #define configUNIQUE_INTERRUPT_PRIORITIES               32
 
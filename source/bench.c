@@ -0,0 +1,203 @@
+/*
+	MIT License
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+
+
+	Developer: Truong Hy
+	Version  : 20261017
+
+	Benchmark task, see bench.h.
+*/
+
+#include "bench.h"
+
+// FreeRTOS includes
+#include "FreeRTOS.h"
+#include "task.h"
+
+// Other includes
+#include "tru_board.h"
+#include "freertos_static.h"
+#include "tru_logger.h"
+
+#define BENCH_TASK_PRIORITY   (tskIDLE_PRIORITY + 4U)
+#define BENCH_TASK_STACK_SIZE (configMINIMAL_STACK_SIZE * 4U)
+
+#if(BENCH_RUN == 1U)
+
+static void bench_task(void *parameters);
+
+FREERTOS_STATIC_TASK_STORAGE(bench, BENCH_TASK_STACK_SIZE);
+
+static const freertos_static_task_t bench_tasks[] = {
+	FREERTOS_STATIC_TASK_ENTRY(bench, bench_task, "B", BENCH_TASK_STACK_SIZE, NULL, BENCH_TASK_PRIORITY, NULL)
+};
+
+// The frequency of the bench clock, so the results convert to time
+static void bench_clock_log(void){
+#if(BENCH_CYCLES == 1U)
+	bench_value_log("clock", tru_board_cpu_clk_hz(), "hz");
+#else
+	bench_value_log("clock", tru_board_periph_clk_hz(), "hz");
+#endif
+}
+
+static void bench_task(void *parameters){
+	// Suppress compiler unused parameter warning
+	(void)parameters;
+
+#if(configNUMBER_OF_CORES > 1)
+	// Runs on CPU0 only, the benchmarks set up banked (per CPU) interrupts and
+	// the timings should not include a migration
+	vTaskCoreAffinitySet(NULL, 0x1U);
+#endif
+
+	LOG_SYNC("# Benchmarks start, board " TRU_BOARD_NAME "\n");
+	LOG_SYNC("bench,name,n,min,avg,max,p50,p90,p99,p99.9,unit\n");
+	LOG_SYNC("hist,name,lower,upper,count\n");
+	bench_clock_log();
+	bench_kernel_run();
+	bench_spsc_run();
+	bench_heap_run();
+	bench_latency_run();
+	bench_hrtimer_run();
+	bench_fmt_run();
+	LOG_SYNC("# Benchmarks end\n");
+
+	vTaskDelete(NULL);
+}
+
+#endif
+
+// Bucket of a value, see bench.h
+static uint32_t bench_hist_bucket(uint32_t value){
+	uint32_t shift;
+
+	if(value < (2U << BENCH_HIST_SUB_BITS)) return value;
+
+	shift = 31U - (uint32_t)__builtin_clz(value) - BENCH_HIST_SUB_BITS;
+	return (shift << BENCH_HIST_SUB_BITS) + (value >> shift);
+}
+
+// Highest value of a bucket
+static uint32_t bench_hist_bucket_top(uint32_t bucket){
+	uint32_t shift;
+
+	if(bucket < (2U << BENCH_HIST_SUB_BITS)) return bucket;
+
+	shift = (bucket >> BENCH_HIST_SUB_BITS) - 1U;
+	return (((bucket & ((1U << BENCH_HIST_SUB_BITS) - 1U)) + (1U << BENCH_HIST_SUB_BITS) + 1U) << shift) - 1U;
+}
+
+void bench_hist_clear(bench_hist_t *hist){
+	uint32_t i;
+
+	hist->n = 0U;
+	hist->min = UINT32_MAX;
+	hist->max = 0U;
+	hist->total = 0U;
+	for(i = 0U; i < BENCH_HIST_BUCKETS; i++) hist->bucket[i] = 0U;
+}
+
+void bench_hist_add(bench_hist_t *hist, uint32_t value){
+	hist->n++;
+	hist->total += value;
+	if(value < hist->min) hist->min = value;
+	if(value > hist->max) hist->max = value;
+	hist->bucket[bench_hist_bucket(value)]++;
+}
+
+void bench_hist_merge(bench_hist_t *hist, const bench_hist_t *other){
+	uint32_t i;
+
+	hist->n += other->n;
+	hist->total += other->total;
+	if(other->min < hist->min) hist->min = other->min;
+	if(other->max > hist->max) hist->max = other->max;
+	for(i = 0U; i < BENCH_HIST_BUCKETS; i++) hist->bucket[i] += other->bucket[i];
+}
+
+// Value at or below which per_mille of the values are, e.g. 990 for the 99th
+// percentile
+uint32_t bench_hist_percentile(const bench_hist_t *hist, uint32_t per_mille){
+	uint64_t rank;
+	uint64_t seen = 0U;
+	uint32_t i;
+
+	if(hist->n == 0U) return 0U;
+
+	rank = ((uint64_t)hist->n * per_mille + 999U) / 1000U;
+	for(i = 0U; i < BENCH_HIST_BUCKETS; i++){
+		seen += hist->bucket[i];
+		if(seen >= rank){
+			// The top of the bucket, but not above the largest value seen
+			return (bench_hist_bucket_top(i) < hist->max) ? bench_hist_bucket_top(i) : hist->max;
+		}
+	}
+
+	return hist->max;
+}
+
+// Prints the summary and then the buckets that are not empty, as CSV lines
+// (see bench.h)
+void bench_hist_log(const char *name, const bench_hist_t *hist){
+	uint32_t lower = 0U;
+	uint32_t i;
+
+	LOG_SYNC("bench,%s,%lu,%lu,%lu,%lu,%lu,%lu,%lu,%lu," BENCH_UNIT "\n",
+		name,
+		(unsigned long)hist->n,
+		(unsigned long)(hist->n ? hist->min : 0U),
+		(unsigned long)(hist->n ? hist->total / hist->n : 0U),
+		(unsigned long)hist->max,
+		(unsigned long)bench_hist_percentile(hist, 500U),
+		(unsigned long)bench_hist_percentile(hist, 900U),
+		(unsigned long)bench_hist_percentile(hist, 990U),
+		(unsigned long)bench_hist_percentile(hist, 999U));
+
+	for(i = 0U; i < BENCH_HIST_BUCKETS; i++){
+		if(hist->bucket[i] != 0U){
+			LOG_SYNC("hist,%s,%lu,%lu,%lu\n", name, (unsigned long)lower, (unsigned long)bench_hist_bucket_top(i), (unsigned long)hist->bucket[i]);
+		}
+		lower = bench_hist_bucket_top(i) + 1U;
+	}
+}
+
+// Prints a single value as a CSV line with n 1
+void bench_value_log(const char *name, uint32_t value, const char *unit){
+	LOG_SYNC("bench,%s,1,%lu,%lu,%lu,%lu,%lu,%lu,%lu,%s\n",
+		name,
+		(unsigned long)value,
+		(unsigned long)value,
+		(unsigned long)value,
+		(unsigned long)value,
+		(unsigned long)value,
+		(unsigned long)value,
+		(unsigned long)value,
+		unit);
+}
+
+bool bench_setup(void){
+#if(BENCH_RUN == 1U)
+	if(!freertos_static_tasks_create(bench_tasks, FREERTOS_STATIC_COUNT(bench_tasks))) return false;
+#endif
+
+	return true;
+}
@@ -0,0 +1,117 @@
+/*
+	MIT License
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+
+
+	Developer: Truong Hy
+	Version  : 20261017
+
+	Benchmarks of the FreeRTOS kernel, the port and trulib, run from a task at
+	startup when BENCH_RUN is 1.  Build them with make bench, which is the
+	Release build with BENCH_RUN set, in its own folder.
+
+	Results are printed with LOG_SYNC(), so over the UART or with semihosting
+	and not through the deferred logger, as CSV.  A timing is a line with its
+	histogram summary:
+		bench,<name>,<n>,<min>,<avg>,<max>,<p50>,<p90>,<p99>,<p99.9>,<unit>
+	followed by a line for each bucket that is not empty:
+		hist,<name>,<lower>,<upper>,<count>
+	A single value, e.g. a count, is a bench line with n 1.  Other lines start
+	with #.
+
+	Timings are in CPU cycles from the PMU cycle counter of the CPU, which is
+	started on each CPU by vConfigurePMU().  Under QEMU (make bench
+	board=vexpa9, see tru_board_vexpa9.h) the counter follows the virtual
+	clock, so run it with -icount for counts that repeat from run to run, or
+	build with BENCH_CYCLES=0 to time with the global timer instead.
+*/
+
+#ifndef BENCH_H
+#define BENCH_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "tru_pmu.h"
+
+// =============
+// User settings
+// =============
+
+// Run the benchmarks at startup (1 = run, 0 = don't run)
+#ifndef BENCH_RUN
+	#define BENCH_RUN 0U
+#endif
+
+// Clock of the timings (1 = PMU cycle counter, 0 = global timer)
+#ifndef BENCH_CYCLES
+	#define BENCH_CYCLES 1U
+#endif
+
+#if(BENCH_CYCLES == 1U)
+	#define BENCH_UNIT "cycles"
+#else
+	#define BENCH_UNIT "gtim"
+#endif
+
+// The bench clock of the calling CPU.  Differences are right across a wrap
+static inline uint32_t bench_time(void){
+#if(BENCH_CYCLES == 1U)
+	return tru_pmu_cycles();
+#else
+	return (uint32_t)gtim_get_counter();
+#endif
+}
+
+// Histogram of timings, exact up to 15 and then in 8 buckets per power
+// of 2, so a percentile is within 12.5% of the value.  Percentiles are given
+// as the top of their bucket
+#define BENCH_HIST_SUB_BITS 3U
+#define BENCH_HIST_BUCKETS  ((33U - BENCH_HIST_SUB_BITS) << BENCH_HIST_SUB_BITS)
+
+typedef struct{
+	uint32_t n;
+	uint32_t min;
+	uint32_t max;
+	uint64_t total;
+	uint32_t bucket[BENCH_HIST_BUCKETS];
+}bench_hist_t;
+
+bool bench_setup(void);
+
+void bench_hist_clear(bench_hist_t *hist);
+void bench_hist_add(bench_hist_t *hist, uint32_t value);
+void bench_hist_merge(bench_hist_t *hist, const bench_hist_t *other);
+uint32_t bench_hist_percentile(const bench_hist_t *hist, uint32_t per_mille);
+void bench_hist_log(const char *name, const bench_hist_t *hist);
+void bench_value_log(const char *name, uint32_t value, const char *unit);
+
+// Individual benchmarks, called by the benchmark task
+void bench_kernel_run(void);
+void bench_spsc_run(void);
+void bench_heap_run(void);
+void bench_latency_run(void);
+void bench_hrtimer_run(void);
+void bench_fmt_run(void);
+
+// Critical section hooks of the latency benchmark, see FreeRTOSConfig.h
+void bench_latency_critical_enter(void);
+void bench_latency_critical_exit(void);
+
+#endif
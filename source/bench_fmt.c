@@ -0,0 +1,131 @@
+/*
+	MIT License
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+
+
+	Developer: Truong Hy
+	Version  : 20261017
+
+	Benchmark of the tru_fmt formatter (tru_fmt.h) against newlib's snprintf(),
+	the time to format a few typical log lines and the stack each one needs.
+
+	Each case is formatted by both into a buffer on the stack and the outputs
+	are compared, a difference is counted in fmt_mismatch.  The stack is
+	measured by formatting every case once in a new task and reading its stack
+	high water mark, the empty task is measured the same way for reference.
+*/
+
+#include "bench.h"
+
+// FreeRTOS includes
+#include "FreeRTOS.h"
+#include "task.h"
+
+// Other includes
+#include "tru_fmt.h"
+#include <stdio.h>
+#include <string.h>
+
+#define BENCH_FMT_RUNS        1000U  // Formats per case and formatter
+#define BENCH_FMT_BUF         128U
+#define BENCH_FMT_STACK_DEPTH 1024U  // Words, for the stack measuring task
+#define BENCH_FMT_CASES       4U
+
+typedef int (*bench_fmt_fn_t)(char *buf, size_t size, const char *fmt, ...);
+
+static const char *const bench_fmt_names[BENCH_FMT_CASES][2] = {
+	{ "fmt_newlib_int", "fmt_tru_int" },
+	{ "fmt_newlib_hex", "fmt_tru_hex" },
+	{ "fmt_newlib_str", "fmt_tru_str" },
+	{ "fmt_newlib_fixed", "fmt_tru_fixed" }
+};
+
+static TaskHandle_t bench_fmt_task;
+static bench_hist_t bench_fmt_hist;
+
+// One log line per case, with the same arguments each time
+static int bench_fmt_case(bench_fmt_fn_t fn, char *buf, uint32_t c){
+	switch(c){
+		case 0U:  return fn(buf, BENCH_FMT_BUF, "tick %lu task %d prio %u delta %-6ld|\n", 123456789UL, 7, 3U, -4096L);
+		case 1U:  return fn(buf, BENCH_FMT_BUF, "reg %08lx mask %#x addr %p\n", 0xffc02014UL, 0x80U, (void *)0x3ff00000);
+		case 2U:  return fn(buf, BENCH_FMT_BUF, "%s: %-10s %.4s\n", "uart", "ready", "overrun");
+		default:  return fn(buf, BENCH_FMT_BUF, "temp %.2f volt %8.3f\n", 36.6, -1.25);
+	}
+}
+
+// Formats every case once, for the stack high water mark
+static void bench_fmt_stack_task(void *parameters){
+	bench_fmt_fn_t fn = (bench_fmt_fn_t)parameters;
+	char buf[BENCH_FMT_BUF];
+
+	if(fn != NULL){
+		for(uint32_t c = 0U; c < BENCH_FMT_CASES; c++) bench_fmt_case(fn, buf, c);
+	}
+
+	xTaskNotifyGive(bench_fmt_task);
+	vTaskSuspend(NULL);
+}
+
+// Returns the bytes of stack a new task used to format every case once
+static uint32_t bench_fmt_stack(bench_fmt_fn_t fn){
+	TaskHandle_t task;
+	uint32_t used;
+
+	if(xTaskCreate(bench_fmt_stack_task, "F", BENCH_FMT_STACK_DEPTH, (void *)fn, uxTaskPriorityGet(NULL) + 1U, &task) != pdPASS) return 0U;
+	ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+	used = (BENCH_FMT_STACK_DEPTH - (uint32_t)uxTaskGetStackHighWaterMark(task)) * sizeof(StackType_t);
+	vTaskDelete(task);
+
+	return used;
+}
+
+void bench_fmt_run(void){
+	const bench_fmt_fn_t fns[2] = { snprintf, tru_fmt_snprintf };
+	char expected[BENCH_FMT_BUF];
+	char buf[BENCH_FMT_BUF];
+	uint32_t mismatch = 0U;
+	uint32_t start;
+	uint32_t c;
+	uint32_t f;
+	uint32_t i;
+
+	bench_fmt_task = xTaskGetCurrentTaskHandle();
+
+	for(c = 0U; c < BENCH_FMT_CASES; c++){
+		bench_fmt_case(snprintf, expected, c);
+		bench_fmt_case(tru_fmt_snprintf, buf, c);
+		if(strcmp(expected, buf) != 0) mismatch++;
+
+		for(f = 0U; f < 2U; f++){
+			bench_hist_clear(&bench_fmt_hist);
+			for(i = 0U; i < BENCH_FMT_RUNS; i++){
+				start = bench_time();
+				bench_fmt_case(fns[f], buf, c);
+				bench_hist_add(&bench_fmt_hist, bench_time() - start);
+			}
+			bench_hist_log(bench_fmt_names[c][f], &bench_fmt_hist);
+		}
+	}
+
+	bench_value_log("fmt_mismatch", mismatch, "cases");
+	bench_value_log("fmt_stack_empty", bench_fmt_stack(NULL), "bytes");
+	bench_value_log("fmt_stack_newlib", bench_fmt_stack(snprintf), "bytes");
+	bench_value_log("fmt_stack_tru", bench_fmt_stack(tru_fmt_snprintf), "bytes");
+}
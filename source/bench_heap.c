@@ -0,0 +1,107 @@
+/*
+	MIT License
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+
+
+	Developer: Truong Hy
+	Version  : 20261017
+
+	Benchmark of the FreeRTOS heap, pvPortMalloc() and vPortFree() latencies
+	and the fragmentation left by a random allocate and free workload.
+
+	It measures whichever heap is linked in, so to compare heap_4 with TLSF
+	run it from a build with heap=4 and one with heap=tlsf.  Fragmentation is
+	1 - largest free block / free bytes, in percent.
+*/
+
+#include "bench.h"
+
+// FreeRTOS includes
+#include "FreeRTOS.h"
+#include "task.h"
+
+#define BENCH_HEAP_SLOTS    64U     // Allocations held at a time
+#define BENCH_HEAP_OPS      20000U  // Allocate or free operations per run
+#define BENCH_HEAP_SIZE_MAX 512U    // Largest allocation in bytes
+
+static void *bench_heap_slots[BENCH_HEAP_SLOTS];
+static bench_hist_t bench_heap_alloc;
+static bench_hist_t bench_heap_free;
+
+// Small xorshift generator, so the workload is the same for every heap
+static uint32_t bench_heap_rand(uint32_t *state){
+	uint32_t x = *state;
+
+	x ^= x << 13;
+	x ^= x >> 17;
+	x ^= x << 5;
+	*state = x;
+
+	return x;
+}
+
+void bench_heap_run(void){
+	HeapStats_t heap_stats;
+	uint32_t seed = 0x2545F491U;
+	uint32_t fails = 0U;
+	uint32_t frag;
+	uint32_t slot;
+	uint32_t i;
+	uint32_t start;
+	size_t size;
+
+	bench_hist_clear(&bench_heap_alloc);
+	bench_hist_clear(&bench_heap_free);
+
+	for(i = 0U; i < BENCH_HEAP_OPS; i++){
+		slot = bench_heap_rand(&seed) % BENCH_HEAP_SLOTS;
+
+		if(bench_heap_slots[slot] == NULL){
+			size = 1U + bench_heap_rand(&seed) % BENCH_HEAP_SIZE_MAX;
+
+			start = bench_time();
+			bench_heap_slots[slot] = pvPortMalloc(size);
+			bench_hist_add(&bench_heap_alloc, bench_time() - start);
+
+			if(bench_heap_slots[slot] == NULL) fails++;
+		}else{
+			start = bench_time();
+			vPortFree(bench_heap_slots[slot]);
+			bench_hist_add(&bench_heap_free, bench_time() - start);
+
+			bench_heap_slots[slot] = NULL;
+		}
+	}
+
+	// Fragmentation while the last allocations are still held
+	vPortGetHeapStats(&heap_stats);
+	frag = heap_stats.xAvailableHeapSpaceInBytes ? 100U - (uint32_t)((uint64_t)heap_stats.xSizeOfLargestFreeBlockInBytes * 100U / heap_stats.xAvailableHeapSpaceInBytes) : 0U;
+
+	for(slot = 0U; slot < BENCH_HEAP_SLOTS; slot++){
+		vPortFree(bench_heap_slots[slot]);
+		bench_heap_slots[slot] = NULL;
+	}
+
+	bench_hist_log("heap_malloc", &bench_heap_alloc);
+	bench_hist_log("heap_free", &bench_heap_free);
+	bench_value_log("heap_free_blocks", (uint32_t)heap_stats.xNumberOfFreeBlocks, "blocks");
+	bench_value_log("heap_fragmented", frag, "percent");
+	bench_value_log("heap_failed", fails, "allocs");
+}
@@ -0,0 +1,148 @@
+/*
+	MIT License
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+
+
+	Developer: Truong Hy
+	Version  : 20261017
+	Developer: Truong Hy
+	Version  : 20261017
+
+	Wake up accuracy of a task woken by the high resolution timer service
+	(tru_hrtimer.h), with vHRTimerNotifyTask() as the timer callback:
+		- hrtimer_wake  : from the expiry of a one-shot timer to the first line
+		                  of the task waiting for it, through the SP timer
+		                  interrupt, the callback and the context switch
+		- hrtimer_jitter: difference of the time between two wakes of a
+		                  periodic timer from its period
+	Expiries the task was too late for are counted in hrtimer_missed, and wakes
+	before the expiry, within TRU_HRTIMER_SLACK_US, in hrtimer_early.  Timings
+	are in nanoseconds, from the global timer, which is the time base of the
+	timers.
+
+	The timers are an HPS SP timer, which the QEMU vexpress-a9 doesn't have, so
+	it only runs on the DE10-Nano.
+*/
+
+#include "bench.h"
+
+// FreeRTOS includes
+#include "FreeRTOS.h"
+#include "task.h"
+
+// Other includes
+#include "tru_board.h"
+#include "tru_hrtimer.h"
+#include "tru_logger.h"
+
+#define BENCH_HRTIMER_RUNS      2000U
+#define BENCH_HRTIMER_DELAY_US  50U   // Of the one-shot timer
+#define BENCH_HRTIMER_PERIOD_US 100U  // Of the periodic timer
+
+#if(BENCH_RUN == 1U)
+
+static tru_hrtimer_t bench_hrtimer_timer;
+static bench_hist_t bench_hrtimer_hist;
+
+// Global timer counts to nanoseconds
+static uint32_t bench_hrtimer_ns(uint64_t counts){
+	return (uint32_t)(counts * 1000000U / tru_hrtimer_us_to_counts(1000U));
+}
+
+// One-shot timers, each started a tick apart so the rest of the program runs
+// in between
+static void bench_hrtimer_oneshot(void){
+	uint64_t expiry;
+	uint64_t woken;
+	uint32_t early = 0U;
+	uint32_t i;
+
+	bench_hist_clear(&bench_hrtimer_hist);
+	for(i = 0U; i < BENCH_HRTIMER_RUNS; i++){
+		vTaskDelay(1U);
+
+		tru_hrtimer_start(&bench_hrtimer_timer, BENCH_HRTIMER_DELAY_US, 0U);
+		expiry = bench_hrtimer_timer.expiry;
+		ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+		woken = tru_hrtimer_now();
+
+		if((int64_t)(woken - expiry) < 0){
+			early++;
+			bench_hist_add(&bench_hrtimer_hist, 0U);
+		}else{
+			bench_hist_add(&bench_hrtimer_hist, bench_hrtimer_ns(woken - expiry));
+		}
+	}
+
+	bench_hist_log("hrtimer_wake", &bench_hrtimer_hist);
+	bench_value_log("hrtimer_early", early, "wakes");
+}
+
+// A periodic timer, the task is woken by every expiry
+static void bench_hrtimer_periodic(void){
+	uint64_t period = tru_hrtimer_us_to_counts(BENCH_HRTIMER_PERIOD_US);
+	uint64_t last;
+	uint64_t woken;
+	uint64_t delta;
+	uint32_t missed = 0U;
+	uint32_t notified;
+	uint32_t i;
+
+	bench_hist_clear(&bench_hrtimer_hist);
+	tru_hrtimer_start(&bench_hrtimer_timer, BENCH_HRTIMER_PERIOD_US, BENCH_HRTIMER_PERIOD_US);
+	ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+	last = tru_hrtimer_now();
+	for(i = 0U; i < BENCH_HRTIMER_RUNS; i++){
+		notified = ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+		woken = tru_hrtimer_now();
+
+		// A notification count above 1 means the task missed expiries, the time
+		// between the wakes then spans more than one period
+		if(notified > 1U){
+			missed += notified - 1U;
+		}else{
+			delta = woken - last;
+			bench_hist_add(&bench_hrtimer_hist, bench_hrtimer_ns((delta > period) ? delta - period : period - delta));
+		}
+		last = woken;
+	}
+	tru_hrtimer_stop(&bench_hrtimer_timer);
+
+	bench_hist_log("hrtimer_jitter", &bench_hrtimer_hist);
+	bench_value_log("hrtimer_missed", missed, "expiries");
+}
+
+void bench_hrtimer_run(void){
+#if(TRU_BOARD == TRU_BOARD_DE10NANO)
+	// The timer callback wakes this task, see vHRTimerNotifyTask()
+	tru_hrtimer_create(&bench_hrtimer_timer, vHRTimerNotifyTask, xTaskGetCurrentTaskHandle());
+	ulTaskNotifyTake(pdTRUE, 0U);
+
+	bench_hrtimer_oneshot();
+	bench_hrtimer_periodic();
+
+	// An expiry between the last wake and the stop leaves a notification
+	ulTaskNotifyTake(pdTRUE, 0U);
+#else
+	LOG_SYNC("# hrtimer skipped, no HPS SP timer on " TRU_BOARD_NAME "\n");
+#endif
+}
+
+#endif
@@ -0,0 +1,253 @@
+/*
+	MIT License
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+
+
+	Developer: Truong Hy
+	Version  : 20261017
+	Cost of the FreeRTOS kernel primitives, timed with the bench clock
+	(bench.h) from the benchmark task:
+		- kernel_time_read       : two back to back reads of the bench clock,
+		                           included in every result below
+		- kernel_yield           : a taskYIELD() context switch to a task of
+		                           the same priority, half of a round trip
+		- kernel_preempt         : xSemaphoreGive() to a higher priority task
+		                           blocked on it, up to its first line
+		- kernel_queue_round_trip: xQueueSend() to a higher priority task that
+		                           sends it back, up to the xQueueReceive()
+		- kernel_sem_give_take   : xSemaphoreGive() and xSemaphoreTake() with
+		                           no task waiting
+		- kernel_notify_give_take: xTaskNotifyGive() and ulTaskNotifyTake() of
+		                           the task itself
+		- kernel_critical        : taskENTER_CRITICAL() and
+		                           taskEXIT_CRITICAL()
+	The other task runs on the same CPU.  Interrupts are left enabled, so the
+	tick shows up in the top percentiles.
+*/
+
+#include "bench.h"
+
+// FreeRTOS includes
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "semphr.h"
+
+// Other includes
+#include "freertos_static.h"
+
+#define BENCH_KERNEL_RUNS            1000U
+#define BENCH_KERNEL_TASK_STACK_SIZE configMINIMAL_STACK_SIZE
+
+#if(BENCH_RUN == 1U)
+
+typedef enum bench_kernel_test_e{
+	BENCH_KERNEL_YIELD,
+	BENCH_KERNEL_PREEMPT,
+	BENCH_KERNEL_QUEUE
+}bench_kernel_test_t;
+
+static void bench_kernel_task(void *parameters);
+
+static TaskHandle_t bench_kernel_other_task;
+static SemaphoreHandle_t bench_kernel_sem;
+static QueueHandle_t bench_kernel_to;
+static QueueHandle_t bench_kernel_from;
+static volatile bench_kernel_test_t bench_kernel_test;
+static volatile uint32_t bench_kernel_stop;
+static volatile uint32_t bench_kernel_woken;
+static bench_hist_t bench_kernel_hist;
+
+FREERTOS_STATIC_TASK_STORAGE(bench_kernel, BENCH_KERNEL_TASK_STACK_SIZE);
+
+static const freertos_static_task_t bench_kernel_tasks[] = {
+	FREERTOS_STATIC_TASK_ENTRY(bench_kernel, bench_kernel_task, "BK", BENCH_KERNEL_TASK_STACK_SIZE, NULL, tskIDLE_PRIORITY, &bench_kernel_other_task)
+};
+
+// The other side of the two task tests.  It waits for a notification, then
+// runs its side of bench_kernel_test until bench_kernel_stop is set
+static void bench_kernel_task(void *parameters){
+	uint32_t item;
+
+	// Suppress compiler unused parameter warning
+	(void)parameters;
+
+	for(;;){
+		ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+		switch(bench_kernel_test){
+			case BENCH_KERNEL_YIELD:
+				while(!bench_kernel_stop) taskYIELD();
+				break;
+			case BENCH_KERNEL_PREEMPT:
+				while(!bench_kernel_stop){
+					xSemaphoreTake(bench_kernel_sem, portMAX_DELAY);
+					bench_kernel_woken = bench_time();
+				}
+				break;
+			case BENCH_KERNEL_QUEUE:
+				while(!bench_kernel_stop){
+					xQueueReceive(bench_kernel_to, &item, portMAX_DELAY);
+					xQueueSend(bench_kernel_from, &item, portMAX_DELAY);
+				}
+				break;
+		}
+	}
+}
+
+// Starts the other task on a test at a priority relative to this task
+static void bench_kernel_start(bench_kernel_test_t test, UBaseType_t priority){
+	bench_kernel_test = test;
+	bench_kernel_stop = 0U;
+	vTaskPrioritySet(bench_kernel_other_task, priority);
+	xTaskNotifyGive(bench_kernel_other_task);
+}
+
+static void bench_kernel_yield(UBaseType_t priority){
+	uint32_t start;
+	uint32_t i;
+
+	bench_hist_clear(&bench_kernel_hist);
+	bench_kernel_start(BENCH_KERNEL_YIELD, priority);
+
+	for(i = 0U; i < BENCH_KERNEL_RUNS; i++){
+		start = bench_time();
+		taskYIELD();
+		bench_hist_add(&bench_kernel_hist, (bench_time() - start) / 2U);
+	}
+
+	// The other task sees the stop on its next turn and blocks again
+	bench_kernel_stop = 1U;
+	taskYIELD();
+
+	bench_hist_log("kernel_yield", &bench_kernel_hist);
+}
+
+static void bench_kernel_preempt(UBaseType_t priority){
+	uint32_t start;
+	uint32_t i;
+
+	bench_hist_clear(&bench_kernel_hist);
+	bench_kernel_start(BENCH_KERNEL_PREEMPT, priority + 1U);
+
+	for(i = 0U; i < BENCH_KERNEL_RUNS; i++){
+		start = bench_time();
+		xSemaphoreGive(bench_kernel_sem);
+		bench_hist_add(&bench_kernel_hist, bench_kernel_woken - start);
+	}
+
+	bench_kernel_stop = 1U;
+	xSemaphoreGive(bench_kernel_sem);
+
+	bench_hist_log("kernel_preempt", &bench_kernel_hist);
+}
+
+static void bench_kernel_queue(UBaseType_t priority){
+	uint32_t item = 0U;
+	uint32_t start;
+	uint32_t i;
+
+	bench_hist_clear(&bench_kernel_hist);
+	bench_kernel_start(BENCH_KERNEL_QUEUE, priority + 1U);
+
+	for(i = 0U; i < BENCH_KERNEL_RUNS; i++){
+		start = bench_time();
+		xQueueSend(bench_kernel_to, &i, portMAX_DELAY);
+		xQueueReceive(bench_kernel_from, &item, portMAX_DELAY);
+		bench_hist_add(&bench_kernel_hist, bench_time() - start);
+	}
+
+	bench_kernel_stop = 1U;
+	xQueueSend(bench_kernel_to, &item, portMAX_DELAY);
+	xQueueReceive(bench_kernel_from, &item, portMAX_DELAY);
+
+	bench_hist_log("kernel_queue_round_trip", &bench_kernel_hist);
+}
+
+// The single task tests
+static void bench_kernel_single(void){
+	uint32_t start;
+	uint32_t i;
+
+	bench_hist_clear(&bench_kernel_hist);
+	for(i = 0U; i < BENCH_KERNEL_RUNS; i++){
+		start = bench_time();
+		bench_hist_add(&bench_kernel_hist, bench_time() - start);
+	}
+	bench_hist_log("kernel_time_read", &bench_kernel_hist);
+
+	bench_hist_clear(&bench_kernel_hist);
+	for(i = 0U; i < BENCH_KERNEL_RUNS; i++){
+		start = bench_time();
+		xSemaphoreGive(bench_kernel_sem);
+		xSemaphoreTake(bench_kernel_sem, 0U);
+		bench_hist_add(&bench_kernel_hist, bench_time() - start);
+	}
+	bench_hist_log("kernel_sem_give_take", &bench_kernel_hist);
+
+	bench_hist_clear(&bench_kernel_hist);
+	for(i = 0U; i < BENCH_KERNEL_RUNS; i++){
+		start = bench_time();
+		xTaskNotifyGive(xTaskGetCurrentTaskHandle());
+		ulTaskNotifyTake(pdTRUE, 0U);
+		bench_hist_add(&bench_kernel_hist, bench_time() - start);
+	}
+	bench_hist_log("kernel_notify_give_take", &bench_kernel_hist);
+
+	bench_hist_clear(&bench_kernel_hist);
+	for(i = 0U; i < BENCH_KERNEL_RUNS; i++){
+		start = bench_time();
+		taskENTER_CRITICAL();
+		taskEXIT_CRITICAL();
+		bench_hist_add(&bench_kernel_hist, bench_time() - start);
+	}
+	bench_hist_log("kernel_critical", &bench_kernel_hist);
+}
+
+void bench_kernel_run(void){
+	UBaseType_t priority = uxTaskPriorityGet(NULL);
+
+	bench_kernel_sem = xSemaphoreCreateBinary();
+	bench_kernel_to = xQueueCreate(1U, sizeof(uint32_t));
+	bench_kernel_from = xQueueCreate(1U, sizeof(uint32_t));
+
+	if(bench_kernel_sem != NULL && bench_kernel_to != NULL && bench_kernel_from != NULL){
+		bench_kernel_single();
+
+		if(freertos_static_tasks_create(bench_kernel_tasks, FREERTOS_STATIC_COUNT(bench_kernel_tasks))){
+#if(configNUMBER_OF_CORES > 1)
+			// On the same CPU as this task
+			vTaskCoreAffinitySet(bench_kernel_other_task, 0x1U);
+#endif
+
+			bench_kernel_yield(priority);
+			bench_kernel_preempt(priority);
+			bench_kernel_queue(priority);
+
+			vTaskDelete(bench_kernel_other_task);
+		}
+	}
+
+	if(bench_kernel_sem != NULL) vSemaphoreDelete(bench_kernel_sem);
+	if(bench_kernel_to != NULL) vQueueDelete(bench_kernel_to);
+	if(bench_kernel_from != NULL) vQueueDelete(bench_kernel_from);
+}
+
+#endif
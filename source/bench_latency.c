@@ -0,0 +1,179 @@
+/*
+	MIT License
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+
+
+	Developer: Truong Hy
+	Version  : 20261017
+	Interrupt and task wake up latency, and critical section hold times.
+
+	The task triggers a software generated interrupt (SGI) on its own CPU and
+	times, with the bench clock (bench.h):
+		- irq : from the SGI write to the first line of its handler, through
+		        FreeRTOS_IRQ_Handler and vApplicationIRQHandler()
+		- wake: from the first line of the handler to the first line of a
+		        higher priority task woken by it with a direct to task
+		        notification, through the context switch
+	Each is repeated a tick apart, so the rest of the program runs in between.
+	Meanwhile the outermost taskENTER_CRITICAL() sections of all tasks on all
+	cores are timed, with the hooks set up in FreeRTOSConfig.h.  Critical
+	sections entered by interrupt handlers are not included.
+
+	Only the bench clock and the GIC are used, so it runs the same under QEMU's
+	Cortex-A9 MPCore model.
+*/
+
+#include "bench.h"
+
+// FreeRTOS includes
+#include "FreeRTOS.h"
+#include "task.h"
+
+// Other includes
+#include "freertos_static.h"
+
+#define BENCH_LATENCY_SGI             ALT_INT_INTERRUPT_SGI2
+#define BENCH_LATENCY_RUNS            2000U
+#define BENCH_LATENCY_TASK_PRIORITY   (tskIDLE_PRIORITY + 5U)  // Above the benchmark task
+#define BENCH_LATENCY_TASK_STACK_SIZE configMINIMAL_STACK_SIZE
+
+#if(BENCH_RUN == 1U)
+
+static void bench_latency_task(void *parameters);
+
+static TaskHandle_t bench_latency_woken_task;
+static volatile uint32_t bench_latency_trigger;
+static volatile uint32_t bench_latency_entry;
+static volatile uint32_t bench_latency_woken;
+static volatile uint32_t bench_latency_done;
+
+static bench_hist_t bench_latency_irq;
+static bench_hist_t bench_latency_wake;
+
+static volatile uint32_t bench_latency_critical_on;
+static uint32_t bench_latency_critical_start[configNUMBER_OF_CORES];
+static bench_hist_t bench_latency_critical[configNUMBER_OF_CORES];
+
+FREERTOS_STATIC_TASK_STORAGE(bench_latency, BENCH_LATENCY_TASK_STACK_SIZE);
+
+static const freertos_static_task_t bench_latency_tasks[] = {
+	FREERTOS_STATIC_TASK_ENTRY(bench_latency, bench_latency_task, "BL", BENCH_LATENCY_TASK_STACK_SIZE, NULL, BENCH_LATENCY_TASK_PRIORITY, &bench_latency_woken_task)
+};
+
+static void bench_latency_sgi_handler(uint32_t icciar, void *context){
+	BaseType_t x_woken = pdFALSE;
+
+	bench_latency_entry = bench_time();
+
+	// Suppress compiler unused parameter warning
+	(void)icciar;
+	(void)context;
+
+	vTaskNotifyGiveFromISR(bench_latency_woken_task, &x_woken);
+	portYIELD_FROM_ISR(x_woken);
+}
+
+static void bench_latency_task(void *parameters){
+	// Suppress compiler unused parameter warning
+	(void)parameters;
+
+	for(;;){
+		ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+		bench_latency_woken = bench_time();
+		bench_latency_done++;
+	}
+}
+
+// Called with interrupts masked after entering the outermost critical section
+void bench_latency_critical_enter(void){
+	if(bench_latency_critical_on){
+		bench_latency_critical_start[portGET_CORE_ID()] = bench_time();
+	}
+}
+
+// Called with interrupts masked before leaving the outermost critical section.
+// A section entered before the timing was turned on has no start and is skipped
+void bench_latency_critical_exit(void){
+	BaseType_t core = portGET_CORE_ID();
+
+	if(bench_latency_critical_on && bench_latency_critical_start[core] != 0U){
+		bench_hist_add(&bench_latency_critical[core], bench_time() - bench_latency_critical_start[core]);
+		bench_latency_critical_start[core] = 0U;
+	}
+}
+
+void bench_latency_run(void){
+	static bench_hist_t critical;
+	uint32_t i;
+
+	bench_hist_clear(&bench_latency_irq);
+	bench_hist_clear(&bench_latency_wake);
+	for(i = 0U; i < configNUMBER_OF_CORES; i++){
+		bench_latency_critical_start[i] = 0U;
+		bench_hist_clear(&bench_latency_critical[i]);
+	}
+	bench_latency_done = 0U;
+
+	if(!freertos_static_tasks_create(bench_latency_tasks, FREERTOS_STATIC_COUNT(bench_latency_tasks))) return;
+#if(configNUMBER_OF_CORES > 1)
+	// On the same CPU as this task and its SGI
+	vTaskCoreAffinitySet(bench_latency_woken_task, 0x1U);
+#endif
+
+	// The handler uses the FromISR API, so its priority must be at or below
+	// configMAX_API_CALL_INTERRUPT_PRIORITY
+	vRegisterIRQHandler(BENCH_LATENCY_SGI, bench_latency_sgi_handler, NULL, pdFALSE);
+	alt_int_dist_priority_set(BENCH_LATENCY_SGI, configMAX_API_CALL_INTERRUPT_PRIORITY << portPRIORITY_SHIFT);
+	alt_int_dist_enable(BENCH_LATENCY_SGI);
+
+	bench_latency_critical_on = 1U;
+	for(i = 0U; i < BENCH_LATENCY_RUNS; i++){
+		vTaskDelay(1U);
+
+		bench_latency_trigger = bench_time();
+		alt_int_sgi_trigger(BENCH_LATENCY_SGI, ALT_INT_SGI_TARGET_SENDER_ONLY, 0U, true);
+
+		// The woken task has the higher priority, so it has run by the time
+		// this task runs again, except for the few instructions before the
+		// interrupt is taken
+		while(bench_latency_done != i + 1U);
+
+		bench_hist_add(&bench_latency_irq, bench_latency_entry - bench_latency_trigger);
+		bench_hist_add(&bench_latency_wake, bench_latency_woken - bench_latency_entry);
+	}
+	bench_latency_critical_on = 0U;
+
+	alt_int_dist_disable(BENCH_LATENCY_SGI);
+	vTaskDelete(bench_latency_woken_task);
+
+	// Let a hook that is still adding on the other core finish
+	vTaskDelay(1U);
+
+	bench_hist_clear(&critical);
+	for(i = 0U; i < configNUMBER_OF_CORES; i++){
+		bench_hist_merge(&critical, &bench_latency_critical[i]);
+	}
+
+	bench_hist_log("latency_irq", &bench_latency_irq);
+	bench_hist_log("latency_wake", &bench_latency_wake);
+	bench_hist_log("latency_critical", &critical);
+}
+
+#endif
@@ -0,0 +1,241 @@
+/*
+	MIT License
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+
+
+	Developer: Truong Hy
+	Version  : 20261017
+
+	Benchmark of passing items from an interrupt handler to a task, through a
+	FreeRTOS queue, through a trulib SPSC ring (tru_spsc.h) and as messages
+	from a trulib block pool (tru_mpool.h) passed through the ring.
+
+	The task triggers a software generated interrupt (SGI) on its own CPU, the
+	handler sends a burst of items and the task receives them.  For the queue
+	each item is sent with xQueueSendToBackFromISR() and received with
+	xQueueReceive().  For the ring each item is pushed with tru_spsc_push(), the
+	task is notified only when the ring was empty, and it pops them in a batch.
+	For the pool the handler allocates a message block, fills it in place and
+	pushes only its pointer, the task checks the message and frees the block.
+	The pool's high water mark and failed allocations and frees are printed
+	after the run, then a block freed twice checks that the pool catches it.
+*/
+
+#include "bench.h"
+
+// FreeRTOS includes
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+
+// Other includes
+#include "tru_spsc.h"
+#include "tru_mpool.h"
+
+#define BENCH_SPSC_SGI     ALT_INT_INTERRUPT_SGI1
+#define BENCH_SPSC_ITEMS   8192U  // Items per run, a multiple of the burst
+#define BENCH_SPSC_BURST   8U     // Items sent per interrupt
+#define BENCH_SPSC_LENGTH  16U    // Queue and ring length, a power of 2 for the ring
+#define BENCH_SPSC_WORDS   7U     // Payload of a pool message
+
+typedef enum bench_spsc_mode_e{
+	BENCH_SPSC_QUEUE,
+	BENCH_SPSC_RING,
+	BENCH_SPSC_POOL
+}bench_spsc_mode_t;
+
+typedef struct{
+	uint32_t seq;
+	uint32_t payload[BENCH_SPSC_WORDS];  // Each the inverted seq
+}bench_spsc_msg_t;
+
+static QueueHandle_t bench_spsc_queue;
+static tru_spsc_t bench_spsc_ring;
+static uint32_t bench_spsc_ring_buf[BENCH_SPSC_LENGTH];
+static tru_spsc_t bench_spsc_msg_ring;
+static bench_spsc_msg_t *bench_spsc_msg_ring_buf[BENCH_SPSC_LENGTH];
+static tru_mpool_t bench_spsc_pool;
+TRU_MPOOL_STORAGE(bench_spsc_pool_buf, sizeof(bench_spsc_msg_t), BENCH_SPSC_LENGTH);
+static TaskHandle_t bench_spsc_task;
+static volatile bench_spsc_mode_t bench_spsc_mode;
+static uint32_t bench_spsc_seq;
+static bench_hist_t bench_spsc_item;
+static bench_hist_t bench_spsc_isr;
+
+// Allocates a message and fills it in.  NULL when the pool is empty, the task
+// counts it as lost
+static bench_spsc_msg_t *bench_spsc_msg_new(uint32_t seq){
+	bench_spsc_msg_t *msg = tru_mpool_alloc(&bench_spsc_pool);
+	uint32_t i;
+
+	if(msg != NULL){
+		msg->seq = seq;
+		for(i = 0U; i < BENCH_SPSC_WORDS; i++) msg->payload[i] = ~seq;
+	}
+
+	return msg;
+}
+
+// Pops up to max messages into their seq and frees their blocks.  A message
+// missing or not filled in as sent is given a seq that is never expected
+static uint32_t bench_spsc_msg_pop(uint32_t *items, uint32_t max){
+	bench_spsc_msg_t *msgs[BENCH_SPSC_BURST];
+	uint32_t n;
+	uint32_t i;
+	uint32_t j;
+
+	n = tru_spsc_pop(&bench_spsc_msg_ring, msgs, max);
+	for(i = 0U; i < n; i++){
+		items[i] = UINT32_MAX;
+		if(msgs[i] == NULL) continue;
+
+		for(j = 0U; j < BENCH_SPSC_WORDS; j++){
+			if(msgs[i]->payload[j] != ~msgs[i]->seq) break;
+		}
+		if(j == BENCH_SPSC_WORDS) items[i] = msgs[i]->seq;
+		tru_mpool_free(&bench_spsc_pool, msgs[i]);
+	}
+
+	return n;
+}
+
+static void bench_spsc_sgi_handler(uint32_t icciar, void *context){
+	BaseType_t x_woken = pdFALSE;
+	bench_spsc_msg_t *msg;
+	tru_spsc_push_t pushed;
+	uint32_t start;
+	uint32_t i;
+
+	// Suppress compiler unused parameter warning
+	(void)icciar;
+	(void)context;
+
+	start = bench_time();
+	for(i = 0U; i < BENCH_SPSC_BURST; i++){
+		if(bench_spsc_mode == BENCH_SPSC_QUEUE){
+			xQueueSendToBackFromISR(bench_spsc_queue, &bench_spsc_seq, &x_woken);
+		}else{
+			if(bench_spsc_mode == BENCH_SPSC_RING){
+				pushed = tru_spsc_push(&bench_spsc_ring, &bench_spsc_seq);
+			}else{
+				msg = bench_spsc_msg_new(bench_spsc_seq);
+				pushed = tru_spsc_push(&bench_spsc_msg_ring, &msg);
+			}
+			if(pushed == TRU_SPSC_PUSHED_FIRST){
+				vTaskNotifyGiveFromISR(bench_spsc_task, &x_woken);
+			}
+		}
+		bench_spsc_seq++;
+	}
+	bench_hist_add(&bench_spsc_isr, (bench_time() - start) / BENCH_SPSC_BURST);
+
+	portYIELD_FROM_ISR(x_woken);
+}
+
+// Runs one mode and prints the time per item of each burst, from the trigger
+// to the task and in the handler, and the items lost or out of order
+static void bench_spsc_run_mode(bench_spsc_mode_t mode, const char *item_name, const char *isr_name, const char *lost_name){
+	uint32_t items[BENCH_SPSC_BURST];
+	uint32_t expected = 0U;
+	uint32_t received;
+	uint32_t lost = 0U;
+	uint32_t n;
+	uint32_t i;
+	uint32_t start;
+
+	bench_spsc_mode = mode;
+	bench_spsc_seq = 0U;
+	bench_hist_clear(&bench_spsc_item);
+	bench_hist_clear(&bench_spsc_isr);
+
+	while(expected < BENCH_SPSC_ITEMS){
+		start = bench_time();
+		alt_int_sgi_trigger(BENCH_SPSC_SGI, ALT_INT_SGI_TARGET_SENDER_ONLY, 0U, true);
+
+		received = 0U;
+		while(received < BENCH_SPSC_BURST){
+			if(mode == BENCH_SPSC_QUEUE){
+				xQueueReceive(bench_spsc_queue, &items[received], portMAX_DELAY);
+				n = 1U;
+			}else{
+				if(mode == BENCH_SPSC_RING){
+					n = tru_spsc_pop(&bench_spsc_ring, &items[received], BENCH_SPSC_BURST - received);
+				}else{
+					n = bench_spsc_msg_pop(&items[received], BENCH_SPSC_BURST - received);
+				}
+				if(n == 0U){
+					ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+					continue;
+				}
+			}
+
+			for(i = 0U; i < n; i++){
+				if(items[received + i] != expected++) lost++;
+			}
+			received += n;
+		}
+		bench_hist_add(&bench_spsc_item, (bench_time() - start) / BENCH_SPSC_BURST);
+	}
+
+	bench_hist_log(item_name, &bench_spsc_item);
+	bench_hist_log(isr_name, &bench_spsc_isr);
+	bench_value_log(lost_name, lost, "items");
+}
+
+// The pool after its run, then a block freed twice, which the pool must refuse
+static void bench_spsc_pool_check(void){
+	tru_mpool_stats_t stats;
+	void *block;
+	bool refused = false;
+
+	tru_mpool_get_stats(&bench_spsc_pool, &stats);
+	bench_value_log("spsc_pool_high_water", stats.high_water, "blocks");
+	bench_value_log("spsc_pool_alloc_fails", stats.alloc_fails, "allocs");
+	bench_value_log("spsc_pool_free_fails", stats.free_fails, "frees");
+
+	block = tru_mpool_alloc(&bench_spsc_pool);
+	if(block != NULL && tru_mpool_free(&bench_spsc_pool, block)){
+		refused = !tru_mpool_free(&bench_spsc_pool, block);
+	}
+	bench_value_log("spsc_pool_double_free", refused ? 1U : 0U, "caught");
+}
+
+void bench_spsc_run(void){
+	bench_spsc_task = xTaskGetCurrentTaskHandle();
+	bench_spsc_queue = xQueueCreate(BENCH_SPSC_LENGTH, sizeof(uint32_t));
+	if(bench_spsc_queue == NULL) return;
+	tru_spsc_init(&bench_spsc_ring, bench_spsc_ring_buf, BENCH_SPSC_LENGTH, sizeof(uint32_t));
+	tru_spsc_init(&bench_spsc_msg_ring, bench_spsc_msg_ring_buf, BENCH_SPSC_LENGTH, sizeof(bench_spsc_msg_t *));
+	tru_mpool_init(&bench_spsc_pool, bench_spsc_pool_buf, sizeof(bench_spsc_msg_t), BENCH_SPSC_LENGTH);
+
+	// The handler uses the FromISR API, so its priority must be at or below
+	// configMAX_API_CALL_INTERRUPT_PRIORITY
+	vRegisterIRQHandler(BENCH_SPSC_SGI, bench_spsc_sgi_handler, NULL, pdFALSE);
+	alt_int_dist_priority_set(BENCH_SPSC_SGI, configMAX_API_CALL_INTERRUPT_PRIORITY << portPRIORITY_SHIFT);
+	alt_int_dist_enable(BENCH_SPSC_SGI);
+
+	bench_spsc_run_mode(BENCH_SPSC_QUEUE, "spsc_queue_item", "spsc_queue_isr_item", "spsc_queue_lost");
+	bench_spsc_run_mode(BENCH_SPSC_RING, "spsc_ring_item", "spsc_ring_isr_item", "spsc_ring_lost");
+	bench_spsc_run_mode(BENCH_SPSC_POOL, "spsc_pool_item", "spsc_pool_isr_item", "spsc_pool_lost");
+	bench_spsc_pool_check();
+
+	alt_int_dist_disable(BENCH_SPSC_SGI);
+	vQueueDelete(bench_spsc_queue);
+}
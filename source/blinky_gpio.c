@@ -29,6 +29,43 @@
 #include "FreeRTOS.h"
 #include "task.h"
 
+#if(TRU_BOARD == TRU_BOARD_VEXPA9)
+
+// =============================================================================
+// The QEMU vexpress-a9 has no HPS GPIO.  The LED is only a state and the key is
+// always up, so the demo blinks and logs the same as on the DE10-Nano.
+// =============================================================================
+
+static tru_hps_gpio_pinstate_t blinky_led_state = TRU_HPS_GPIO_PIN_LOW;
+
+void blinky_gpio_setup(void){
+	blinky_led_state = TRU_HPS_GPIO_PIN_LOW;
+}
+
+tru_hps_gpio_pinstate_t blinky_get_key_state_safe(void){
+	return TRU_HPS_GPIO_PIN_HIGH;  // Key up
+}
+
+void blinky_set_led_state_safe(tru_hps_gpio_pinstate_t state){
+	blinky_led_state = state;
+}
+
+void blinky_toggle_led_safe(void){
+	blinky_led_state = (blinky_led_state == TRU_HPS_GPIO_PIN_LOW) ? TRU_HPS_GPIO_PIN_HIGH : TRU_HPS_GPIO_PIN_LOW;
+}
+
+uint32_t blinky_get_pol_key(void){
+	return 0U;
+}
+
+void blinky_toggle_pol_key(void){
+}
+
+void blinky_clear_int_key(void){
+}
+
+#else
+
 void blinky_gpio_setup(void){
 	tru_hps_gpio1_ll_reset_release();                          // Release GPIO1 module from reset, i.e. enable it (0 = held in reset, 1 = release)
 	tru_hps_gpio1_ll_set_pin_output(DE10N_LED_GPIO_PINNUM);    // Set LED pin direction to output (0 = input, 1 = output)
@@ -97,3 +134,5 @@ void blinky_toggle_pol_key(void){
 void blinky_clear_int_key(void){
 	tru_hps_gpio1_ll_clear_int(DE10N_KEY_GPIO_PINNUM);
 }
+
+#endif
@@ -59,6 +59,11 @@
 // Interrupt mode edge trigger select (1 = edge trigger, 0 = level trigger)
 #define BLINKY_KEY_IRQ_EDGE_TRIGGER 1U
 
+// The QEMU vexpress-a9 has no key interrupt, see blinky_gpio.c
+#if(TRU_BOARD == TRU_BOARD_VEXPA9) && (BLINKY_KEY_CAPTURE_POLL == 0U)
+	#error "BLINKY_KEY_CAPTURE_POLL must be 1 on the QEMU vexpress-a9 board"
+#endif
+
 #define DE10N_LED_GPIO_PINNUM 53U  // DE10-Nano HPS LED GPIO
 #define DE10N_KEY_GPIO_PINNUM 54U  // DE10-Nano HPS KEY GPIO
 
@@ -92,7 +92,10 @@
 
 // Other includes
 #include "blinky_gpio.h"
+#include "freertos_static.h"
 #include "tru_irq.h"
+
+#define TRU_LOG_MODULE TRU_LOG_MOD_APP
 #include "tru_logger.h"
 
 // Standard includes
@@ -144,31 +147,37 @@ static const blinky_msg_t keydown_msg = KEYDOWN_MSG;
 static const blinky_msg_t keyup_msg   = KEYUP_MSG;
 static blinky_msg_t last_key_msg;
 
-bool blinky_setup(void){
-	BaseType_t x_ret;
+// The queue and tasks are allocated at build time, see freertos_static.h
+FREERTOS_STATIC_QUEUE_STORAGE(blinky_msg, BLINKY_QUEUE_LENGTH, sizeof(blinky_msg_t));
+FREERTOS_STATIC_TASK_STORAGE(blinky_sender, configMINIMAL_STACK_SIZE);
+FREERTOS_STATIC_TASK_STORAGE(blinky_receiver, configMINIMAL_STACK_SIZE);
+#if(BLINKY_KEY_CAPTURE_POLL == 1U)
+	FREERTOS_STATIC_TASK_STORAGE(blinky_pollkey, configMINIMAL_STACK_SIZE);
+#endif
+
+static const freertos_static_queue_t blinky_queues[] = {
+	FREERTOS_STATIC_QUEUE_ENTRY(blinky_msg, BLINKY_QUEUE_LENGTH, sizeof(blinky_msg_t), &blinky_queue)
+};
 
+static const freertos_static_task_t blinky_tasks[] = {
+	FREERTOS_STATIC_TASK_ENTRY(blinky_sender, blinky_sender_task, "S", configMINIMAL_STACK_SIZE, NULL, BLINKY_SENDER_TASK_PRIORITY, NULL),
+	FREERTOS_STATIC_TASK_ENTRY(blinky_receiver, blinky_receiver_task, "R", configMINIMAL_STACK_SIZE, NULL, BLINKY_RECEIVER_TASK_PRIORITY, NULL),
+#if(BLINKY_KEY_CAPTURE_POLL == 1U)
+	FREERTOS_STATIC_TASK_ENTRY(blinky_pollkey, blinky_pollkey_task, "K", configMINIMAL_STACK_SIZE, NULL, BLINKY_POLLKEY_TASK_PRIORITY, NULL)
+#endif
+};
+
+bool blinky_setup(void){
 	blinky_gpio_setup();
 
 	// Initialise state variables
 	last_key_msg = KEYUP_MSG;
 
-	// Create a FreeRTOS message queue
-	blinky_queue = xQueueCreate(BLINKY_QUEUE_LENGTH, sizeof(blinky_msg_t));
-	if(blinky_queue == NULL) return false;
-
-	// Create a FreeRTOS task
-	x_ret = xTaskCreate(blinky_sender_task, "S", configMINIMAL_STACK_SIZE, NULL, BLINKY_SENDER_TASK_PRIORITY, NULL);
-	if(x_ret != pdPASS) return false;
-
-	// Create a FreeRTOS task
-	x_ret = xTaskCreate(blinky_receiver_task, "R", configMINIMAL_STACK_SIZE, NULL, BLINKY_RECEIVER_TASK_PRIORITY, NULL);
-	if(x_ret != pdPASS) return false;
+	// Create the FreeRTOS message queue and tasks from the tables
+	if(!freertos_static_queues_create(blinky_queues, FREERTOS_STATIC_COUNT(blinky_queues))) return false;
+	if(!freertos_static_tasks_create(blinky_tasks, FREERTOS_STATIC_COUNT(blinky_tasks))) return false;
 
-	#if(BLINKY_KEY_CAPTURE_POLL == 1U)
-		// Create a FreeRTOS task
-		x_ret = xTaskCreate(blinky_pollkey_task, "K", configMINIMAL_STACK_SIZE, NULL, BLINKY_POLLKEY_TASK_PRIORITY, NULL);
-		if(x_ret != pdPASS) return false;
-	#else
+	#if(BLINKY_KEY_CAPTURE_POLL == 0U)
 		blinky_register_gpio1_irq_handler();
 	#endif
 
@@ -212,19 +221,19 @@ static void blinky_receiver_task(void *parameters){
 			case BLINK_MSG:
 				// Blink only when the key is up
 				if(last_key_msg == KEYUP_MSG){
-					LOG("Blink\n");
+					LOG_INFO("Blink\n");
 					blinky_toggle_led_safe();  // blink the LED
 				}
 				break;
 
 			case KEYDOWN_MSG:
-				LOG("Key down\n");
+				LOG_INFO("Key down\n");
 				blinky_set_led_state_safe(TRU_HPS_GPIO_PIN_HIGH);  // LED on
 				last_key_msg = KEYDOWN_MSG;
 				break;
 
 			case KEYUP_MSG:
-				LOG("Key up\n");
+				LOG_INFO("Key up\n");
 				blinky_set_led_state_safe(TRU_HPS_GPIO_PIN_LOW);  // LED off
 				last_key_msg = KEYUP_MSG;
 				break;
@@ -272,7 +281,7 @@ static void blinky_receiver_task(void *parameters){
 
 	// Register interrupt handler for the input key to CPU0 with interrupt priority level 29 sublevel 7 - note, this is higher than FreeRTOS tick IRQ handler at level 30 sublevel 0
 	static void blinky_register_gpio1_irq_handler(void){
-		vRegisterIRQHandler(ALT_INT_INTERRUPT_GPIO1, (alt_int_callback_t)blinky_gpio1_irq_handler, NULL);
+		vRegisterIRQHandler(ALT_INT_INTERRUPT_GPIO1, (alt_int_callback_t)blinky_gpio1_irq_handler, NULL, pdFALSE);
 		alt_int_dist_target_set(ALT_INT_INTERRUPT_GPIO1, TRU_GIC_DIST_CPU0);
 		alt_int_dist_priority_set(ALT_INT_INTERRUPT_GPIO1, BLINKY_GPIO1_IRQ_PRIORITY);
 		alt_int_dist_enable(ALT_INT_INTERRUPT_GPIO1);
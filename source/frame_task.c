@@ -0,0 +1,236 @@
+/*
+	MIT License
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+
+	Developer: Truong Hy
+	Version  : 20261017
+
+
+	The framed transport on the console UART, see tru_frame.h.  With
+	TRU_CFG_FRAME 1U the console output, the deferred logger records and a
+	telemetry report each second go out in frames, and this task receives the
+	commands of the host client scripts-generic/tru_frame_client.py:
+		'P' ping, the reply is the command itself
+		'T' stops the kernel trace recorder and sends its dump on the trace
+		    channel, an empty frame ends it
+		'L' module level, sets the log threshold of a module, a module
+		    past the table sets all of them.  Without the two bytes it
+		    only reads them.  The reply is 'L' and the level table
+		'S' run time stats, the reply is 'S' and the freertos_stats_table()
+		    text, which has a row for the interrupts of each core
+	An unknown command gets '?' and the command back.
+
+	The task owns the console input, other tasks must not read stdin.
+*/
+
+// FreeRTOS includes
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+#include "timers.h"
+
+// Trulib includes
+#include "tru_config.h"
+#include "tru_c5soc_hps_uart.h"
+#include "tru_frame.h"
+#include "tru_logger.h"
+#include "tru_trace.h"
+
+// Other includes
+#include "freertos_static.h"
+#include "freertos_stats.h"
+
+// Standard includes
+#include <stdbool.h>
+#include <string.h>
+
+#if defined(TRU_FRAME) && TRU_FRAME == 1U
+
+#define FRAME_TASK_PRIORITY (tskIDLE_PRIORITY + 1U)
+#define FRAME_TASK_STACK    (configMINIMAL_STACK_SIZE * 2U)
+
+#define FRAME_RX_SIZE         512U  // Largest command frame
+#define FRAME_TRACE_CHUNK     512U  // Trace dump bytes per frame
+#define FRAME_STATS_SIZE      1024U // Run time stats text
+#define FRAME_TELEMETRY_MS    1000U
+
+#define FRAME_CMD_PING    'P'
+#define FRAME_CMD_TRACE   'T'
+#define FRAME_CMD_LEVEL   'L'
+#define FRAME_CMD_STATS   'S'
+#define FRAME_CMD_UNKNOWN '?'
+
+// The telemetry report, the layout is read by tru_frame_client.py
+typedef struct{
+	uint32_t time_ms;
+	uint32_t heap_free;
+	uint32_t heap_min_free;
+	uint32_t rx_overruns;
+	uint32_t rx_dropped;
+	uint32_t frame_errors;
+}frame_telemetry_t;
+
+static void frame_task(void *parameters);
+
+FREERTOS_STATIC_TASK_STORAGE(frame, FRAME_TASK_STACK);
+
+static const freertos_static_task_t frame_tasks[] = {
+	FREERTOS_STATIC_TASK_ENTRY(frame, frame_task, "F", FRAME_TASK_STACK, NULL, FRAME_TASK_PRIORITY, NULL)
+};
+
+static tru_frame_t frame_link;
+static uint8_t frame_rx_buf[FRAME_RX_SIZE];
+static char frame_stats_buf[FRAME_STATS_SIZE];
+static StaticSemaphore_t frame_mutex_buffer;
+static SemaphoreHandle_t frame_mutex;
+static StaticTimer_t frame_timer_buffer;
+
+// A task sends a frame as a whole under the mutex.  Anything that can't block
+// sends without it, as _write() did before, so a print from an interrupt
+// handler can break the frame of a task, which the host then drops for its CRC
+static void frame_lock(tru_frame_t *link){
+	(void)link;
+
+	if(xCanBlock()) xSemaphoreTake(frame_mutex, portMAX_DELAY);
+}
+
+static void frame_unlock(tru_frame_t *link){
+	(void)link;
+
+	if(xCanBlock()) xSemaphoreGive(frame_mutex);
+}
+
+// Each part of a frame is queued straight from the caller's buffer into the
+// UART driver's ring
+static void frame_write(tru_frame_t *link, const uint8_t *buf, uint32_t len){
+	(void)link;
+
+	tru_hps_uart_write(tru_hps_uart_console, buf, len, TRU_HPS_UART_WAIT);
+}
+
+#if defined(TRU_TRACE) && TRU_TRACE == 1U
+static void frame_trace_dump(tru_frame_t *link){
+	const uint8_t *dump = (const uint8_t *)&tru_trace;
+
+	tru_trace_stop();
+	for(uint32_t i = 0U; i < sizeof(tru_trace); i += FRAME_TRACE_CHUNK){
+		uint32_t len = sizeof(tru_trace) - i;
+
+		if(len > FRAME_TRACE_CHUNK) len = FRAME_TRACE_CHUNK;
+		tru_frame_send(link, TRU_FRAME_CH_TRACE, &dump[i], len);
+	}
+	tru_frame_send(link, TRU_FRAME_CH_TRACE, NULL, 0U);
+}
+#endif
+
+static void frame_command(tru_frame_t *link, uint32_t channel, const uint8_t *data, uint32_t len){
+	uint8_t unknown = FRAME_CMD_UNKNOWN;
+	tru_frame_iov_t iov[2] = {
+		{ .buf = &unknown, .len = 1U },
+		{ .buf = data, .len = len }
+	};
+
+	if(len == 0U) return;
+
+	switch(data[0]){
+		case FRAME_CMD_PING:
+			tru_frame_send(link, channel, data, len);
+			break;
+		case FRAME_CMD_TRACE:
+#if defined(TRU_TRACE) && TRU_TRACE == 1U
+			tru_frame_send(link, channel, data, 1U);
+			frame_trace_dump(link);
+#else
+			tru_frame_sendv(link, channel, iov, 2U);
+#endif
+			break;
+#if defined(TRU_LOG) && TRU_LOG == 1U
+		case FRAME_CMD_LEVEL:
+			if(len >= 3U) tru_log_level_set(data[1], data[2]);
+			iov[0].buf = data;
+			iov[1].buf = tru_log_level;
+			iov[1].len = TRU_LOG_MODULES;
+			tru_frame_sendv(link, channel, iov, 2U);
+			break;
+#endif
+		case FRAME_CMD_STATS:
+			iov[0].buf = data;
+			iov[1].buf = frame_stats_buf;
+			iov[1].len = (uint32_t)freertos_stats_table(frame_stats_buf, sizeof(frame_stats_buf));
+			tru_frame_sendv(link, channel, iov, 2U);
+			break;
+		default:
+			tru_frame_sendv(link, channel, iov, 2U);
+			break;
+	}
+}
+
+// Runs in the timer service task
+static void frame_telemetry(TimerHandle_t timer){
+	frame_telemetry_t report;
+	(void)timer;
+
+	report.time_ms = (uint32_t)(xTaskGetTickCount() * portTICK_PERIOD_MS);
+	report.heap_free = (uint32_t)xPortGetFreeHeapSize();
+	report.heap_min_free = (uint32_t)xPortGetMinimumEverFreeHeapSize();
+	report.rx_overruns = tru_hps_uart_console->rx_overruns;
+	report.rx_dropped = tru_hps_uart_console->rx_dropped;
+	report.frame_errors = frame_link.rx_errors;
+	tru_frame_send(&frame_link, TRU_FRAME_CH_TELEMETRY, &report, sizeof(report));
+}
+
+static void frame_task(void *parameters){
+	uint8_t buf[64];
+	uint32_t len;
+
+	// Suppress compiler unused parameter warning
+	(void)parameters;
+
+	for(;;){
+		len = tru_hps_uart_console->read(tru_hps_uart_console, buf, sizeof(buf));
+		tru_frame_rx(&frame_link, buf, len);
+	}
+}
+
+// Called after vConfigureConsoleUART(), output is framed from here on
+bool frame_setup(void){
+	TimerHandle_t timer;
+
+	if(tru_hps_uart_console == NULL || tru_hps_uart_console->read == NULL) return false;
+
+	frame_mutex = xSemaphoreCreateMutexStatic(&frame_mutex_buffer);
+	tru_frame_init(&frame_link, frame_write, frame_lock, frame_unlock, frame_rx_buf, FRAME_RX_SIZE, NULL);
+	tru_frame_handler_set(&frame_link, TRU_FRAME_CH_COMMAND, frame_command);
+
+	timer = xTimerCreateStatic("frame", pdMS_TO_TICKS(FRAME_TELEMETRY_MS), pdTRUE, NULL, frame_telemetry, &frame_timer_buffer);
+	if(timer == NULL || xTimerStart(timer, 0) != pdPASS) return false;
+
+	tru_frame_console = &frame_link;
+
+	return freertos_static_tasks_create(frame_tasks, FREERTOS_STATIC_COUNT(frame_tasks));
+}
+
+#else
+
+bool frame_setup(void){
+	return true;
+}
+
+#endif
@@ -35,13 +35,28 @@
 // FreeRTOS includes
 #include "FreeRTOS.h"
 #include "task.h"
+#include "timers.h"
 #include "semphr.h"
+#include "stream_buffer.h"
 
 // Intel HWLIB library includes
 #include "alt_timers.h"
 #include "alt_clock_manager.h"
 #include "socal/socal.h"
 
+// Trulib includes
+#include "tru_cortex_a9.h"
+#include "tru_board.h"
+#include "tru_smp.h"
+#include "tru_hrtimer.h"
+#include "tru_c5soc_hps_uart.h"
+#include "tru_trace.h"
+#include "tru_pmu.h"
+#include "tru_prof.h"
+
+// Other includes
+#include "freertos_static.h"
+
 // Overrides the weak vector table exception handler and jump to the FreeRTOS
 // FreeRTOS_SWI_Handler function found in portASM.S (Cortex-A9 port).  Note,
 // their function has some input arguments, which doesn't match with this
@@ -64,6 +79,29 @@ void __attribute__ ((naked)) IRQ_Handler(void){
 	__asm__ volatile("LDR pc, =FreeRTOS_IRQ_Handler");
 }
 
+// Overrides the weak vector table exception handler and jump to the FreeRTOS
+// FreeRTOS_Undef_Handler function found in portASM.S (Cortex-A9 port).  It
+// enables the FPU for code that runs with it disabled and executes a VFP/NEON
+// instruction: an interrupt handler registered without FPU saving, see
+// prvCallIntegerISR(), and with lazy FPU context switching a task that doesn't
+// own the FPU registers.  The registers must be preserved, hence the use of
+// naked attribute and assembly.  See tru_startup.c for the vector table
+void __attribute__ ((naked)) Undef_Handler(void){
+	__asm__ volatile("LDR pc, =FreeRTOS_Undef_Handler");
+}
+
+#if defined(TRU_STARTUP) && TRU_STARTUP == 1U && defined(ALT_INT_PROVISION_VECTOR_SUPPORT) && ALT_INT_PROVISION_VECTOR_SUPPORT == 0U
+extern void Default_Handler(void);
+
+// Overrides the weak vApplicationUndefHandler in portASM.S, which is called for
+// an undefined instruction that is not a VFP/NEON one, with the registers as
+// they were on entry.  It is passed on to the handler that Undef_Handler would
+// have been without FreeRTOS, see tru_startup.c
+void __attribute__ ((naked)) vApplicationUndefHandler(void){
+	__asm__ volatile("LDR pc, =Default_Handler");
+}
+#endif
+
 /* FreeRTOS uses its own interrupt handler code.  This code cannot use the array
 of handlers defined by the Altera drivers because the array is declared static,
 and so not accessible outside of the driver's source file.  Instead declare an
@@ -116,18 +154,101 @@ void vApplicationTickHook(void){
 
 }
 
+/* With configSUPPORT_STATIC_ALLOCATION the kernel gets the memory of its own
+tasks from these functions, placed with the application objects so that the
+footprint printed at link time covers them too. */
+FREERTOS_STATIC_TASK_STORAGE(xIdleTask, configMINIMAL_STACK_SIZE);
+FREERTOS_STATIC_TASK_STORAGE(xTimerTask, configTIMER_TASK_STACK_DEPTH);
+
+void vApplicationGetIdleTaskMemory(StaticTask_t **ppxIdleTaskTCBBuffer, StackType_t **ppxIdleTaskStackBuffer, configSTACK_DEPTH_TYPE *puxIdleTaskStackSize){
+	*ppxIdleTaskTCBBuffer = &xIdleTask_tcb;
+	*ppxIdleTaskStackBuffer = xIdleTask_stack;
+	*puxIdleTaskStackSize = configMINIMAL_STACK_SIZE;
+}
+
+#if(configNUMBER_OF_CORES > 1)
+static StackType_t xPassiveIdleTask_stack[configNUMBER_OF_CORES - 1][configMINIMAL_STACK_SIZE] FREERTOS_STATIC_SECTION __attribute__((aligned(portBYTE_ALIGNMENT)));
+static StaticTask_t xPassiveIdleTask_tcb[configNUMBER_OF_CORES - 1] FREERTOS_STATIC_SECTION;
+
+/* The idle tasks of the other cores, called with index 0 to
+configNUMBER_OF_CORES - 2. */
+void vApplicationGetPassiveIdleTaskMemory(StaticTask_t **ppxIdleTaskTCBBuffer, StackType_t **ppxIdleTaskStackBuffer, configSTACK_DEPTH_TYPE *puxIdleTaskStackSize, BaseType_t xPassiveIdleTaskIndex){
+	*ppxIdleTaskTCBBuffer = &xPassiveIdleTask_tcb[xPassiveIdleTaskIndex];
+	*ppxIdleTaskStackBuffer = xPassiveIdleTask_stack[xPassiveIdleTaskIndex];
+	*puxIdleTaskStackSize = configMINIMAL_STACK_SIZE;
+}
+#endif
+
+void vApplicationGetTimerTaskMemory(StaticTask_t **ppxTimerTaskTCBBuffer, StackType_t **ppxTimerTaskStackBuffer, configSTACK_DEPTH_TYPE *puxTimerTaskStackSize){
+	*ppxTimerTaskTCBBuffer = &xTimerTask_tcb;
+	*ppxTimerTaskStackBuffer = xTimerTask_stack;
+	*puxTimerTaskStackSize = configTIMER_TASK_STACK_DEPTH;
+}
+
+#if(configUSE_TICKLESS_IDLE == 1)
+// Global timer counts for one tick period, set by vConfigureTickInterrupt()
+static uint32_t ulTimerCountsPerTick;
+
+// The next tick is treated as already elapsed when a wake up leaves less than
+// this fraction of the tick period to it, so that the comparator is never set
+// to a time the counter has already passed
+#define TICKLESS_MIN_COUNTS_DIVISOR 16U
+#endif
+
 void vConfigureTickInterrupt(void){
 	alt_freq_t ulTempFrequency;
+#if(configUSE_TICKLESS_IDLE == 0)
 	const alt_freq_t ulMicroSecondsPerSecond = 1000000UL;
+#endif
 	void FreeRTOS_Tick_Handler(void);
 
 	/* Interrupts are disabled when this function is called. */
 
-	/* Initialise the general purpose timer modules. */
-	alt_gpt_all_tmr_init();
+#if(configNUMBER_OF_CORES > 1)
+	// With SMP this is called on each core as it starts, see
+	// vPortStartSecondaryCore() in port.c.  The yield interrupt is a banked
+	// SGI, so each core sets up its own.  Only core 0 sets up the tick, the
+	// kernel expects a single tick source and it yields the other cores itself
+	// for time slicing
+	vRegisterIRQHandler(configYIELD_INTERRUPT_ID, (alt_int_callback_t)FreeRTOS_Yield_Handler, NULL, pdFALSE);
+	alt_int_dist_priority_set(configYIELD_INTERRUPT_ID, portLOWEST_USABLE_INTERRUPT_PRIORITY << portPRIORITY_SHIFT);
+	alt_int_dist_enable(configYIELD_INTERRUPT_ID);
+
+	if(portGET_CORE_ID() != 0) return;
+#endif
+
+#if(configUSE_TICKLESS_IDLE == 1)
+	// The tick is generated by the global timer comparator, with auto-increment
+	// keeping it periodic.  Unlike the private timer the comparator can be set
+	// any number of ticks ahead, which vPortSuppressTicksAndSleep() uses to
+	// sleep through idle periods.  The counter is left running, it is also the
+	// run time stats clock.  The timer is accessed at the board address (see
+	// tru_board.h) and not with the HWLib functions, which are fixed to the
+	// Cyclone V SoC
+	ulTempFrequency = tru_board_periph_clk_hz();
+	ulTimerCountsPerTick = ulTempFrequency / (gtim_get_prescaler() + 1U) / configTICK_RATE_HZ;
+
+	gtim_irq_disable();
+	gtim_enable();
+	gtim_compare_disable();
+	gtim_set_autoinc(ulTimerCountsPerTick);
+	gtim_autoinc_enable();
+	gtim_set_compare(gtim_get_counter() + ulTimerCountsPerTick);
+	gtim_compare_enable();
+
+	vRegisterIRQHandler(ALT_INT_INTERRUPT_PPI_TIMER_GLOBAL, (alt_int_callback_t)FreeRTOS_Tick_Handler, NULL, pdFALSE);
+	alt_int_dist_priority_set(ALT_INT_INTERRUPT_PPI_TIMER_GLOBAL, portLOWEST_USABLE_INTERRUPT_PRIORITY << portPRIORITY_SHIFT);
+	alt_int_dist_enable(ALT_INT_INTERRUPT_PPI_TIMER_GLOBAL);
+
+	gtim_clear_event();
+	gtim_irq_enable();
+#else
+	// Note, alt_gpt_all_tmr_init() is not called, the private timer doesn't need
+	// it and it would reset the OSC1 and SP timers, one of which is used by the
+	// high resolution timer service (tru_hrtimer.c)
 
 	/* ALT_CLK_MPU_PERIPH = mpu_periph_clk */
-	alt_clk_freq_get(ALT_CLK_MPU_PERIPH, &ulTempFrequency);
+	ulTempFrequency = tru_board_periph_clk_hz();
 
 	/* Use the private timer. */
 	alt_gpt_counter_set(ALT_GPT_CPU_PRIVATE_TMR, ulTempFrequency / configTICK_RATE_HZ);
@@ -144,7 +265,7 @@ void vConfigureTickInterrupt(void){
 	/* Register the standard FreeRTOS Cortex-A tick handler as the timer's
 	interrupt handler.  The handler clears the interrupt using the
 	configCLEAR_TICK_INTERRUPT() macro, which is defined in FreeRTOSConfig.h. */
-	vRegisterIRQHandler(ALT_INT_INTERRUPT_PPI_TIMER_PRIVATE, (alt_int_callback_t)FreeRTOS_Tick_Handler, NULL);
+	vRegisterIRQHandler(ALT_INT_INTERRUPT_PPI_TIMER_PRIVATE, (alt_int_callback_t)FreeRTOS_Tick_Handler, NULL, pdFALSE);
 
 	/* This tick interrupt must run at the lowest priority. */
 	alt_int_dist_priority_set(ALT_INT_INTERRUPT_PPI_TIMER_PRIVATE, portLOWEST_USABLE_INTERRUPT_PRIORITY << portPRIORITY_SHIFT);
@@ -155,34 +276,578 @@ void vConfigureTickInterrupt(void){
 	/* Enable interrupt trigger of private timer. */
 	alt_gpt_int_clear_pending(ALT_GPT_CPU_PRIVATE_TMR);
 	alt_gpt_int_enable(ALT_GPT_CPU_PRIVATE_TMR);
+#endif
+}
+
+#if(configUSE_TICKLESS_IDLE == 1)
+// Called by the idle task, with the scheduler suspended, when no task is due
+// to unblock for at least configEXPECTED_IDLE_TIME_BEFORE_SLEEP ticks.  The
+// comparator is moved to the tick that ends the idle period and the core waits
+// in WFI, then the tick count is corrected for the ticks that were skipped.
+// Interrupts are masked with the CPSR I bit and not the GIC priority mask, an
+// interrupt masked by the GIC would not wake the core from WFI
+void vPortSuppressTicksAndSleep(TickType_t xExpectedIdleTime){
+	uint64_t ullLastTick;
+	uint64_t ullWakeTime;
+	uint64_t ullNow;
+	TickType_t xCompleteTicks;
+
+	__asm__ volatile("CPSID i" ::: "memory");
+
+	// A task was readied or a tick is waiting to be processed, don't sleep
+	if(eTaskConfirmSleepModeStatus() == eAbortSleep || gtim_is_event()){
+		__asm__ volatile("CPSIE i" ::: "memory");
+		return;
+	}
+
+	// With no tick pending the comparator holds the time of the next tick
+	ullLastTick = gtim_get_compare() - ulTimerCountsPerTick;
+	ullWakeTime = ullLastTick + (uint64_t)xExpectedIdleTime * ulTimerCountsPerTick;
+	gtim_set_compare(ullWakeTime);
+
+	__asm__ volatile(
+		"DSB  \n"
+		"WFI  \n"
+		"ISB  \n"
+		::: "memory"
+	);
+
+	// Stop comparing while the counter and the event flag are read, the
+	// comparator can't then match in between
+	gtim_compare_disable();
+	ullNow = gtim_get_counter();
+
+	if(gtim_is_event()){
+		// Woken by the tick at the end of the idle period.  Auto-increment has
+		// already moved the comparator to the tick after it, and the tick
+		// handler counts this tick once interrupts are enabled
+		xCompleteTicks = xExpectedIdleTime - 1U;
+	}else{
+		// Woken early by another interrupt.  Count the whole tick periods that
+		// have elapsed and move the comparator back to the next tick
+		xCompleteTicks = (TickType_t)((ullNow - ullLastTick) / ulTimerCountsPerTick);
+		if((ullLastTick + (uint64_t)(xCompleteTicks + 1U) * ulTimerCountsPerTick) - ullNow < ulTimerCountsPerTick / TICKLESS_MIN_COUNTS_DIVISOR){
+			xCompleteTicks++;
+		}
+		gtim_set_compare(ullLastTick + (uint64_t)(xCompleteTicks + 1U) * ulTimerCountsPerTick);
+	}
+
+	gtim_compare_enable();
+	vTaskStepTick(xCompleteTicks);
+
+	__asm__ volatile("CPSIE i" ::: "memory");
+}
+#endif
+
+#if(configNUMBER_OF_CORES > 1)
+// Runs on CPU1 after its startup (Reset_Handler_CPU1 in tru_startup.c), with
+// interrupts masked.  The GIC CPU interface is banked, so it is initialised
+// here the same as CPU0 does in main.c, then the first task of this core is
+// started
+static void prvSecondaryCoreMain(void){
+	alt_int_cpu_init();
+	alt_int_cpu_enable();
+	vConfigurePMU();
+	vConfigureProfiler();
+
+	vPortStartSecondaryCore();
+}
+
+// Called by core 0 as the scheduler starts, see configSTART_SECONDARY_CORES()
+// in FreeRTOSConfig.h
+void vStartSecondaryCores(void){
+	tru_smp_cpu1_start(prvSecondaryCoreMain);
+}
+
+// Interrupts another core so that it reschedules, see
+// configTRIGGER_YIELD_INTERRUPT() in FreeRTOSConfig.h
+void vTriggerYieldInterrupt(long xCoreID){
+	alt_int_sgi_trigger(configYIELD_INTERRUPT_ID, ALT_INT_SGI_TARGET_LIST, 1U << xCoreID, true);
+}
+#endif
+
+// Initialises the high resolution timer service (tru_hrtimer.c) and installs
+// its interrupt.  It is the highest priority that can call the interrupt safe
+// FreeRTOS API, so the timers are not delayed by the tick or other interrupts
+// that are allowed to use the API.  It is targeted at CPU0.  The timer is an
+// HPS SP timer, which the QEMU vexpress-a9 doesn't have
+void vConfigureHRTimer(void){
+#if(TRU_BOARD == TRU_BOARD_DE10NANO)
+	tru_hrtimer_init();
+
+	vRegisterIRQHandler(TRU_HRTIMER_IRQ, tru_hrtimer_isr, NULL, pdFALSE);
+	alt_int_dist_target_set(TRU_HRTIMER_IRQ, 0x1U);
+	alt_int_dist_priority_set(TRU_HRTIMER_IRQ, configMAX_API_CALL_INTERRUPT_PRIORITY << portPRIORITY_SHIFT);
+	alt_int_dist_enable(TRU_HRTIMER_IRQ);
+#endif
+}
+
+extern volatile uint32_t ulCriticalNesting[];
+extern volatile uint32_t ulPortInterruptNesting[];
+
+// Returns pdTRUE when called by a task that may block: the scheduler is
+// running and not suspended, and the caller is not in a critical section or an
+// interrupt handler.  IRQ is masked so the task can't move to the other core
+// between reading the core ID and its nesting counts.  Not with
+// portSET_INTERRUPT_MASK(), which unmasks IRQ on return, and this is also
+// called by the console output with IRQ masked
+BaseType_t xCanBlock(void){
+	uint32_t ulCPSR;
+	BaseType_t xCoreID;
+	BaseType_t xReturn;
+
+	__asm__ volatile(
+		"MRS   %0, cpsr                                      \n"
+		"CPSID i                                             \n"
+		: "=r" (ulCPSR) : : "memory"
+	);
+	xCoreID = portGET_CORE_ID();
+	xReturn = (ulCriticalNesting[xCoreID] == 0UL && ulPortInterruptNesting[xCoreID] == 0UL) ? pdTRUE : pdFALSE;
+	__asm__ volatile("MSR cpsr_c, %0" : : "r" (ulCPSR) : "memory");
+
+	return (xReturn == pdTRUE && xTaskGetSchedulerState() == taskSCHEDULER_RUNNING) ? pdTRUE : pdFALSE;
+}
+
+#if defined(TRU_UART_TX_IRQ) && TRU_UART_TX_IRQ == 1U
+#if defined(TRU_PRINT_UART1) && TRU_PRINT_UART1 == 1U
+	#define CONSOLE_UART_BASE TRU_HPS_UART1_BASE
+	#define CONSOLE_UART_IRQ  ALT_INT_INTERRUPT_UART1
+#else
+	#define CONSOLE_UART_BASE TRU_HPS_UART0_BASE
+	#define CONSOLE_UART_IRQ  ALT_INT_INTERRUPT_UART0
+#endif
+
+#define CONSOLE_UART_RING_SIZE 4096U  // A power of 2
+
+static tru_hps_uart_t xConsoleUART;
+static uint8_t ucConsoleUARTRing[CONSOLE_UART_RING_SIZE];
+static StaticSemaphore_t xConsoleUARTSpaceBuffer;
+static SemaphoreHandle_t xConsoleUARTSpace;
+
+// Called by a writer that finds the ring full.  A task blocks until the
+// interrupt handler has made room, anything else returns straight away and the
+// writer polls: before the scheduler runs, with it suspended, in a critical
+// section and in an interrupt handler
+static void prvConsoleUARTWait(tru_hps_uart_t *pxUART){
+	(void)pxUART;
+
+	if(xCanBlock()){
+		xSemaphoreTake(xConsoleUARTSpace, portMAX_DELAY);
+	}
+}
+
+static void prvConsoleUARTWake(tru_hps_uart_t *pxUART){
+	BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+	(void)pxUART;
+
+	xSemaphoreGiveFromISR(xConsoleUARTSpace, &xHigherPriorityTaskWoken);
+	portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+}
+
+#if defined(TRU_UART_RX_IRQ) && TRU_UART_RX_IRQ == 1U
+// About 44ms of input at 921600 baud
+#define CONSOLE_UART_RX_SIZE 4096U
+
+static uint8_t ucConsoleUARTRxStorage[CONSOLE_UART_RX_SIZE];
+static StaticStreamBuffer_t xConsoleUARTRxBuffer;
+static StreamBufferHandle_t xConsoleUARTRx;
+
+// Called by the interrupt handler, or by a polling reader, with the bytes
+// emptied from the RX FIFO.  Bytes that don't fit are counted by the driver
+static uint32_t prvConsoleUARTRx(tru_hps_uart_t *pxUART, const uint8_t *pucData, uint32_t ulLength){
+	BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+	size_t xSent;
+	(void)pxUART;
+
+	xSent = xStreamBufferSendFromISR(xConsoleUARTRx, pucData, ulLength, &xHigherPriorityTaskWoken);
+	portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+
+	return (uint32_t)xSent;
+}
+
+// Called by _read().  A task blocks until the stream buffer has at least 1
+// byte, which is its trigger level, anything else polls the RX FIFO as the
+// transmit writers do.  A stream buffer has one reader, so only one task at a
+// time may read the console
+static uint32_t prvConsoleUARTRead(tru_hps_uart_t *pxUART, uint8_t *pucData, uint32_t ulLength){
+	size_t xReceived;
+
+	if(xCanBlock()){
+		return (uint32_t)xStreamBufferReceive(xConsoleUARTRx, pucData, ulLength, portMAX_DELAY);
+	}
+
+	do{
+		tru_hps_uart_rx_poll(pxUART);
+		xReceived = xStreamBufferReceive(xConsoleUARTRx, pucData, ulLength, 0);
+	}while(xReceived == 0U);
+
+	return (uint32_t)xReceived;
 }
+#endif
 
-void vRegisterIRQHandler(uint32_t ulID, alt_int_callback_t pxHandlerFunction, void *pvContext){
+#if defined(TRU_UART_TX_DMA) && TRU_UART_TX_DMA == 1U
+#define CONSOLE_UART_DMA_EVENT ALT_DMA_EVENT_0
+#define CONSOLE_UART_DMA_IRQ   ALT_INT_INTERRUPT_DMA_IRQ0
+
+// A 64KB chunk takes under 6s at 115200 baud.  After the time out the driver
+// polls the channel, so a DMA fault doesn't leave the writer blocked
+#define CONSOLE_UART_DMA_TIMEOUT_MS 10000U
+
+static StaticSemaphore_t xConsoleUARTDMAMutexBuffer;
+static SemaphoreHandle_t xConsoleUARTDMAMutex;
+static TaskHandle_t xConsoleUARTDMATask;
+
+static void prvConsoleUARTDMAWait(tru_hps_uart_t *pxUART){
+	(void)pxUART;
+
+	if(xConsoleUARTDMATask != NULL){
+		ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(CONSOLE_UART_DMA_TIMEOUT_MS));
+	}
+}
+
+static void prvConsoleUARTDMADone(tru_hps_uart_t *pxUART){
+	BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+	TaskHandle_t xTask = xConsoleUARTDMATask;
+	(void)pxUART;
+
+	if(xTask != NULL){
+		vTaskNotifyGiveFromISR(xTask, &xHigherPriorityTaskWoken);
+		portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+	}
+}
+#endif
+#endif
+
+// Makes the console UART transmit interrupt driven (tru_c5soc_hps_uart.c), so
+// printing tasks queue their output rather than wait on the UART, and with
+// TRU_UART_RX_IRQ its receive, so reading tasks block rather than poll.  It is
+// the lowest priority interrupt, targeted at CPU0
+void vConfigureConsoleUART(void){
+#if defined(TRU_UART_TX_IRQ) && TRU_UART_TX_IRQ == 1U
+	xConsoleUARTSpace = xSemaphoreCreateBinaryStatic(&xConsoleUARTSpaceBuffer);
+	tru_hps_uart_init(&xConsoleUART, (void *)CONSOLE_UART_BASE, ucConsoleUARTRing, CONSOLE_UART_RING_SIZE, prvConsoleUARTWait, prvConsoleUARTWake, NULL);
+
+#if defined(TRU_UART_RX_IRQ) && TRU_UART_RX_IRQ == 1U
+	xConsoleUARTRx = xStreamBufferCreateStatic(CONSOLE_UART_RX_SIZE, 1U, ucConsoleUARTRxStorage, &xConsoleUARTRxBuffer);
+	tru_hps_uart_rx_init(&xConsoleUART, prvConsoleUARTRx, prvConsoleUARTRead);
+#endif
+
+	vRegisterIRQHandler(CONSOLE_UART_IRQ, tru_hps_uart_isr, &xConsoleUART, pdFALSE);
+	alt_int_dist_target_set(CONSOLE_UART_IRQ, 0x1U);
+	alt_int_dist_priority_set(CONSOLE_UART_IRQ, portLOWEST_USABLE_INTERRUPT_PRIORITY << portPRIORITY_SHIFT);
+	alt_int_dist_enable(CONSOLE_UART_IRQ);
+
+#if defined(TRU_UART_TX_DMA) && TRU_UART_TX_DMA == 1U
+	ALT_DMA_CFG_t xDMAConfig = { 0 };  // All at their defaults
+	ALT_DMA_CHANNEL_t xChannel;
+
+	xConsoleUARTDMAMutex = xSemaphoreCreateMutexStatic(&xConsoleUARTDMAMutexBuffer);
+	if(alt_dma_init(&xDMAConfig) == ALT_E_SUCCESS && alt_dma_channel_alloc_any(&xChannel) == ALT_E_SUCCESS){
+		alt_dma_event_int_select(CONSOLE_UART_DMA_EVENT, ALT_DMA_EVENT_SELECT_SIG_IRQ);
+		tru_hps_uart_dma_init(&xConsoleUART, xChannel, CONSOLE_UART_DMA_EVENT, prvConsoleUARTDMAWait, prvConsoleUARTDMADone);
+
+		vRegisterIRQHandler(CONSOLE_UART_DMA_IRQ, tru_hps_uart_dma_isr, &xConsoleUART, pdFALSE);
+		alt_int_dist_target_set(CONSOLE_UART_DMA_IRQ, 0x1U);
+		alt_int_dist_priority_set(CONSOLE_UART_DMA_IRQ, portLOWEST_USABLE_INTERRUPT_PRIORITY << portPRIORITY_SHIFT);
+		alt_int_dist_enable(CONSOLE_UART_DMA_IRQ);
+	}
+#endif
+
+	tru_hps_uart_console = &xConsoleUART;
+#endif
+}
+
+// Sends a buffer to the console UART with the DMA, the calling task blocks
+// until the DMA has read it and is woken by a direct to task notification.
+// Returns pdFAIL if the DMA failed or is not built in
+BaseType_t xConsoleUARTWriteDMA(const void *pvBuffer, uint32_t ulLength){
+#if defined(TRU_UART_TX_DMA) && TRU_UART_TX_DMA == 1U
+	BaseType_t xRunning = (xTaskGetSchedulerState() == taskSCHEDULER_RUNNING);
+	bool bOK;
+
+	if(xRunning){
+		xSemaphoreTake(xConsoleUARTDMAMutex, portMAX_DELAY);
+		xConsoleUARTDMATask = xTaskGetCurrentTaskHandle();
+	}
+
+	bOK = tru_hps_uart_write_dma(&xConsoleUART, pvBuffer, ulLength);
+
+	if(xRunning){
+		xConsoleUARTDMATask = NULL;
+		xSemaphoreGive(xConsoleUARTDMAMutex);
+	}
+
+	return bOK ? pdPASS : pdFAIL;
+#else
+	(void)pvBuffer;
+	(void)ulLength;
+
+	return pdFAIL;
+#endif
+}
+
+// A high resolution timer callback that wakes a task with a direct to task
+// notification, the task is passed as the timer context.  See bench_hrtimer.c,
+// which measures how accurately it wakes the task
+void vHRTimerNotifyTask(struct tru_hrtimer_s *pxTimer, void *pvTask){
+	BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+	(void)pxTimer;
+
+	vTaskNotifyGiveFromISR((TaskHandle_t)pvTask, &xHigherPriorityTaskWoken);
+	portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+}
+
+// Starts the kernel trace recorder, see tru_trace.h.  Called before any task
+// or queue is created so that their names and numbers are recorded
+void vConfigureTrace(void){
+#if defined(TRU_TRACE) && TRU_TRACE == 1U
+	tru_trace_init(tru_board_periph_clk_hz());
+#endif
+}
+
+// Sets up the performance monitor of the calling core, see tru_pmu.h.  Called
+// on each core before its first task
+void vConfigurePMU(void){
+#if defined(TRU_PMU) && TRU_PMU == 1U
+	tru_pmu_init(NULL);
+#else
+	// The cycle counter alone, the benchmarks time with it
+	tru_pmu_cycles_start();
+#endif
+}
+
+#if defined(TRU_PROF) && TRU_PROF == 1U
+// The profiler interrupt handler.  FreeRTOS_IRQ_Handler (portASM.S) pushes the
+// return address and the SPSR of the interrupted code to the IRQ mode stack,
+// so they are read from there.  The LR is the banked one of system mode, so it
+// is only that of the interrupted code when a task was interrupted, otherwise
+// it is recorded as 0
+static void prvProfilerISR(uint32_t ulICCIAR, void *pvContext){
+	// Fixed to r2 and r12, which are the same registers in the IRQ, System and
+	// SVC modes.  The compiler could otherwise pick lr, which is banked
+	register uint32_t *pulFrame __asm__("r2");
+	register uint32_t ulLR __asm__("r12");
+	uint32_t ulSPSRMode;
+	(void)ulICCIAR;
+	(void)pvContext;
+
+	__asm__ volatile(
+		"MRS   r3, cpsr                                      \n"
+		"CPSID i                                             \n"
+		"CPS   #0x12                                         \n"  // IRQ mode
+		"MOV   %0, sp                                        \n"
+		"CPS   #0x1f                                         \n"  // System mode
+		"MOV   %1, lr                                        \n"
+		"MSR   cpsr_c, r3                                    \n"  // Back to SVC mode
+		: "=&r" (pulFrame), "=&r" (ulLR) : : "r3", "memory"
+	);
+
+	ulSPSRMode = pulFrame[0] & 0x1fU;
+	if(ulSPSRMode != 0x1fU && ulSPSRMode != 0x10U) ulLR = 0U;
+
+	tru_prof_sample(pulFrame[1], ulLR, (uint32_t)xTaskGetCurrentTaskHandleForCore(portGET_CORE_ID()));
+}
+#endif
+
+// Starts the profiler on the calling core, see tru_prof.h.  Called on each
+// core before its first task
+void vConfigureProfiler(void){
+#if defined(TRU_PROF) && TRU_PROF == 1U
+	if(!tru_prof_init(configPROFILER_RATE_HZ)) return;
+
+	// A banked interrupt, so the priority and enable are set on each core
+	vRegisterIRQHandler(TRU_PROF_IRQ, prvProfilerISR, NULL, pdFALSE);
+	alt_int_dist_priority_set(TRU_PROF_IRQ, (configMAX_API_CALL_INTERRUPT_PRIORITY - 1) << portPRIORITY_SHIFT);
+	alt_int_dist_enable(TRU_PROF_IRQ);
+#endif
+}
+
+void vRegisterIRQHandler(uint32_t ulID, alt_int_callback_t pxHandlerFunction, void *pvContext, uint32_t ulUsesFPU){
 	if(ulID < ALT_INT_PROVISION_INT_COUNT){
 		xISRHandlers[ulID].pxISR = pxHandlerFunction;
 		xISRHandlers[ulID].pvContext = pvContext;
+		xISRHandlers[ulID].ulUsesFPU = ulUsesFPU;
 	}
 }
 
-//void vApplicationIRQHandler(uint32_t ulICCIAR){
-void vApplicationFPUSafeIRQHandler(uint32_t ulICCIAR){  // If using GCC and FreeRTOS V9.0.0 or later
+// Calls a handler that uses VFP/NEON, saving the FPU registers on entry and
+// restoring them on exit.  The FPU is also enabled for the duration of the
+// handler, because the interrupted task may be running with it disabled when
+// lazy FPU context switching is used (configUSE_TASK_FPU_SUPPORT == 3).
+// Inputs are passed through to the handler: r0 = ulICCIAR, r1 = pvContext, and
+// r2 = pxISR is the handler
+static void __attribute__ ((naked)) prvCallFPUSafeISR(uint32_t ulICCIAR, void *pvContext, alt_int_callback_t pxISR){
+	__asm__ volatile(
+		"VMRS  r3, FPEXC                                     \n"  // Save FPEXC
+		"PUSH  {r3, lr}                                      \n"
+		"ORR   r3, r3, #0x40000000                           \n"  // Enable the FPU
+		"VMSR  FPEXC, r3                                     \n"
+		"VMRS  r3, FPSCR                                     \n"  // Save FPSCR and the FPU registers.  r4 pushed to maintain alignment
+		"PUSH  {r3, r4}                                      \n"
+		"VPUSH {d0-d15}                                      \n"
+		"VPUSH {d16-d31}                                     \n"
+		"BLX   r2                                            \n"  // Call the handler
+		"VPOP  {d16-d31}                                     \n"  // Restore the FPU registers and FPSCR
+		"VPOP  {d0-d15}                                      \n"
+		"POP   {r3, r4}                                      \n"
+		"VMSR  FPSCR, r3                                     \n"
+		"POP   {r3, lr}                                      \n"  // Restore FPEXC
+		"VMSR  FPEXC, r3                                     \n"
+		"BX    lr                                            \n"
+	);
+}
+
+// Calls an interrupt handler registered as not using VFP/NEON with the FPU
+// disabled, so that the FPU registers need not be saved.  Should it execute a
+// VFP/NEON instruction after all, e.g. in a library memcpy(), the instruction
+// traps into FreeRTOS_Undef_Handler, which saves the registers into the save
+// area of the core and records the nesting level of this handler in
+// ulPortISRFPULevel, see port.c.  They are restored here on return.
+//
+// If the FPU is enabled because an interrupted handler at a lower nesting
+// level has taken the save area, its registers are stacked here instead
+static void __attribute__ ((naked)) prvCallIntegerISR(uint32_t ulICCIAR, void *pvContext, alt_int_callback_t pxISR){
+	__asm__ volatile(
+		"PUSH  {r4-r6, lr}                                   \n"
+		"VMRS  r4, FPEXC                                     \n"  // r4 = FPEXC on entry
+		"MRC   p15, 0, r5, c0, c0, 5                         \n"  // r5 = byte offset of the per core variables
+		"AND   r5, r5, #3                                    \n"
+		"LSL   r5, r5, #2                                    \n"
+		"MOV   r6, #0                                        \n"  // r6 = 1 if the registers are stacked
+		"TST   r4, #0x40000000                               \n"
+		"BEQ   2f                                            \n"  // Already disabled
+		"LDR   r3, =ulPortISRFPULevel                        \n"
+		"LDR   r3, [r3, r5]                                  \n"
+		"CMP   r3, #0                                        \n"
+		"BNE   1f                                            \n"
+		"BIC   r3, r4, #0x40000000                           \n"  // Disable the FPU
+		"VMSR  FPEXC, r3                                     \n"
+		"B     2f                                            \n"
+		"1:                                                  \n"
+		"VMRS  r3, FPSCR                                     \n"  // Stack FPSCR and the FPU registers.  r12 pushed to maintain alignment
+		"PUSH  {r3, r12}                                     \n"
+		"VPUSH {d0-d15}                                      \n"
+		"VPUSH {d16-d31}                                     \n"
+		"MOV   r6, #1                                        \n"
+		"2:                                                  \n"
+		"BLX   r2                                            \n"  // Call the handler
+		"CMP   r6, #0                                        \n"
+		"BEQ   3f                                            \n"
+		"VPOP  {d16-d31}                                     \n"  // Unstack the FPU registers and FPSCR
+		"VPOP  {d0-d15}                                      \n"
+		"POP   {r3, r12}                                     \n"
+		"VMSR  FPSCR, r3                                     \n"
+		"B     4f                                            \n"
+		"3:                                                  \n"
+		"LDR   r3, =ulPortISRFPULevel                        \n"  // Did the handler take the FPU?
+		"ADD   r3, r3, r5                                    \n"
+		"LDR   r0, [r3]                                      \n"
+		"LDR   r1, =ulPortInterruptNesting                   \n"
+		"LDR   r1, [r1, r5]                                  \n"
+		"CMP   r0, r1                                        \n"
+		"BNE   4f                                            \n"
+		"MOV   r0, #0                                        \n"
+		"STR   r0, [r3]                                      \n"
+		"MOV   r1, %[words]                                  \n"  // The save area of this core, portFPU_LAZY_AREA_WORDS each
+		"MUL   r1, r5, r1                                    \n"
+		"LDR   r0, =ulPortISRFPUContext                      \n"
+		"ADD   r0, r0, r1                                    \n"
+		"VLDMIA r0!, {d0-d15}                                \n"  // Restore the FPU registers and FPSCR
+		"VLDMIA r0!, {d16-d31}                               \n"
+		"LDR   r1, [r0]                                      \n"
+		"VMSR  FPSCR, r1                                     \n"
+		"4:                                                  \n"
+		"VMSR  FPEXC, r4                                     \n"  // Restore FPEXC
+		"POP   {r4-r6, pc}                                   \n"
+		".ltorg                                              \n"  // The literals of the LDR r, =symbol above
+		: : [words] "i" (portFPU_LAZY_AREA_WORDS)
+	);
+}
+
+// Interrupt handler time of each core in global timer counts, kept by
+// vApplicationIRQHandler() for the run time stats.  Nested interrupts are
+// counted once, from the entry of the outermost handler to its exit
+static volatile uint64_t ullISRTime[configNUMBER_OF_CORES];
+static uint64_t ullISREntry[configNUMBER_OF_CORES];
+static uint32_t ulISRNesting[configNUMBER_OF_CORES];
+
+// Run time stats counter of the calling core, see FreeRTOSConfig.h.  IRQ is
+// masked so the 64-bit values are read without an interrupt updating them
+uint64_t ullGetRunTimeCounterValue(void){
+	uint32_t ulCPSR;
+	uint64_t ullValue;
+
+	__asm__ volatile(
+		"MRS   %0, cpsr                                      \n"
+		"CPSID i                                             \n"
+		: "=r" (ulCPSR) : : "memory"
+	);
+	ullValue = gtim_get_counter() - ullISRTime[portGET_CORE_ID()];
+	__asm__ volatile("MSR cpsr_c, %0" : : "r" (ulCPSR) : "memory");
+
+	return ullValue;
+}
+
+// Total interrupt handler time of a core, in the same units
+uint64_t ullGetISRRunTimeCounterValue(uint32_t ulCoreID){
+	uint32_t ulCPSR;
+	uint64_t ullValue;
+
+	__asm__ volatile(
+		"MRS   %0, cpsr                                      \n"
+		"CPSID i                                             \n"
+		: "=r" (ulCPSR) : : "memory"
+	);
+	ullValue = ullISRTime[ulCoreID];
+	__asm__ volatile("MSR cpsr_c, %0" : : "r" (ulCPSR) : "memory");
+
+	return ullValue;
+}
+
+// Overrides the weak vApplicationIRQHandler in portASM.S, which saves the FPU
+// registers on every interrupt before calling vApplicationFPUSafeIRQHandler.
+// Here the FPU registers are only saved for the handlers registered as using
+// VFP/NEON, all other handlers are called with the FPU disabled.  Note, this
+// function runs with the FPU as the interrupted code left it, so it must not
+// use VFP/NEON itself
+void vApplicationIRQHandler(uint32_t ulICCIAR){
 	uint32_t ulInterruptID;
 	void *pvContext;
 	alt_int_callback_t pxISR;
+	BaseType_t xCoreID = portGET_CORE_ID();
 
-	/* Re-enable interrupts. */
-	__asm ("CPSIE i");
+	/* Start the interrupt time of this core, IRQ is still masked here. */
+	if(ulISRNesting[xCoreID]++ == 0U){
+		ullISREntry[xCoreID] = gtim_get_counter();
+	}
 
 	/* The ID of the interrupt is obtained by bitwise anding the ICCIAR value
 	with 0x3FF. */
 	ulInterruptID = ulICCIAR & 0x3FFUL;
+	tru_trace_record(TRU_TRACE_ISR_ENTER, ulInterruptID);
+
+	/* Re-enable interrupts. */
+	__asm ("CPSIE i");
 
 	if(ulInterruptID < ALT_INT_PROVISION_INT_COUNT){
 		/* Call the function installed in the array of installed handler
 		functions. */
 		pxISR = xISRHandlers[ulInterruptID].pxISR;
 		pvContext = xISRHandlers[ulInterruptID].pvContext;
-		pxISR(ulICCIAR, pvContext);
+		if(xISRHandlers[ulInterruptID].ulUsesFPU){
+			prvCallFPUSafeISR(ulICCIAR, pvContext, pxISR);
+		}else{
+			prvCallIntegerISR(ulICCIAR, pvContext, pxISR);
+		}
+	}
+
+	/* The caller masks IRQ again on return anyway, masking it here keeps a
+	nested interrupt from splitting the update. */
+	__asm ("CPSID i");
+
+	tru_trace_record(TRU_TRACE_ISR_EXIT, ulInterruptID);
+	if(--ulISRNesting[xCoreID] == 0U){
+		ullISRTime[xCoreID] += gtim_get_counter() - ullISREntry[xCoreID];
 	}
 }
 
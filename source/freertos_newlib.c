@@ -0,0 +1,290 @@
+/*
+	MIT License
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+
+
+	Developer: Truong Hy
+	Version  : 20261017
+
+	newlib support for FreeRTOS: with TRU_NEWLIB_REENTRANT the retargetable
+	locks that make stdio and the other shared newlib state safe between tasks,
+	and with TRU_MALLOC_RTOS malloc() from the FreeRTOS heap.
+
+	newlib is built with retargetable locking, it calls __retarget_lock_*()
+	around its shared state and defines empty ones, which these replace.  Each
+	lock is a FreeRTOS recursive mutex, so a task waiting for a stream another
+	task is printing to blocks with priority inheritance.  The locks are only
+	taken by a task that may block, see xCanBlock().  Before the scheduler
+	starts there is one thread, and an interrupt handler or critical section
+	cannot wait, so there they do nothing.  The mutexes of newlib's own locks
+	are created by vConfigureNewlibLocks() before the scheduler starts, the
+	stream locks when the stream is, so taking a lock never creates one.
+
+	With TRU_MALLOC_RTOS malloc(), free() and the rest go to pvPortMalloc() and
+	vPortFree(), including newlib's own allocations, e.g. the stdio buffers.
+	There is then one heap of configTOTAL_HEAP_SIZE, which
+	vPortGetHeapStats() reports, and the linker script .heap and _sbrk() are
+	not used.  Each block has an 8 byte header in front with its size, for
+	realloc(), and the start of the FreeRTOS block, for memalign().  Not
+	provided are mallinfo() and malloc_stats(), which would link newlib's
+	allocator back in.
+*/
+
+// FreeRTOS includes
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+
+// Other includes
+#include "tru_config.h"
+#include <errno.h>
+#include <reent.h>
+#include <stdint.h>
+#include <string.h>
+#include <sys/lock.h>
+
+#if defined(TRU_NEWLIB_REENTRANT) && TRU_NEWLIB_REENTRANT == 1U
+
+// ==============================================================================
+// Locks
+// ==============================================================================
+
+struct __lock{
+	StaticSemaphore_t xMutexBuffer;
+	SemaphoreHandle_t xMutex;
+};
+
+// newlib's own locks
+struct __lock __lock___sinit_recursive_mutex;
+struct __lock __lock___sfp_recursive_mutex;
+struct __lock __lock___atexit_recursive_mutex;
+struct __lock __lock___at_quick_exit_mutex;
+struct __lock __lock___malloc_recursive_mutex;
+struct __lock __lock___env_recursive_mutex;
+struct __lock __lock___tz_mutex;
+struct __lock __lock___dd_hash_mutex;
+struct __lock __lock___arc4random_mutex;
+
+static struct __lock * const pxNewlibLocks[] = {
+	&__lock___sinit_recursive_mutex,
+	&__lock___sfp_recursive_mutex,
+	&__lock___atexit_recursive_mutex,
+	&__lock___at_quick_exit_mutex,
+	&__lock___malloc_recursive_mutex,
+	&__lock___env_recursive_mutex,
+	&__lock___tz_mutex,
+	&__lock___dd_hash_mutex,
+	&__lock___arc4random_mutex
+};
+
+// Creates the mutexes of newlib's own locks.  Called by main() before the
+// scheduler starts, until then the locks do nothing
+void vConfigureNewlibLocks(void){
+	size_t i;
+
+	for(i = 0U; i < sizeof(pxNewlibLocks) / sizeof(pxNewlibLocks[0]); i++){
+		pxNewlibLocks[i]->xMutex = xSemaphoreCreateRecursiveMutexStatic(&pxNewlibLocks[i]->xMutexBuffer);
+	}
+}
+
+// Returns the mutex of a lock, NULL when it can't be taken here
+static SemaphoreHandle_t prvLockMutex(_LOCK_T xLock){
+	if(xLock == NULL || xCanBlock() == pdFALSE) return NULL;
+
+	return xLock->xMutex;
+}
+
+// Every lock is recursive, so newlib's normal and recursive locks are the same.
+// newlib creates a stream lock from a task or before the scheduler starts, so
+// the mutex is created here and not when the lock is first taken
+void __retarget_lock_init_recursive(_LOCK_T *pxLock){
+	*pxLock = pvPortMalloc(sizeof(struct __lock));
+	configASSERT(*pxLock != NULL);
+	if(*pxLock != NULL) (*pxLock)->xMutex = xSemaphoreCreateRecursiveMutexStatic(&(*pxLock)->xMutexBuffer);
+}
+
+void __retarget_lock_init(_LOCK_T *pxLock){
+	__retarget_lock_init_recursive(pxLock);
+}
+
+void __retarget_lock_close_recursive(_LOCK_T xLock){
+	if(xLock == NULL) return;
+	if(xLock->xMutex != NULL) vSemaphoreDelete(xLock->xMutex);
+	vPortFree(xLock);
+}
+
+void __retarget_lock_close(_LOCK_T xLock){
+	__retarget_lock_close_recursive(xLock);
+}
+
+void __retarget_lock_acquire_recursive(_LOCK_T xLock){
+	SemaphoreHandle_t xMutex;
+
+	xMutex = prvLockMutex(xLock);
+	if(xMutex != NULL) xSemaphoreTakeRecursive(xMutex, portMAX_DELAY);
+}
+
+void __retarget_lock_acquire(_LOCK_T xLock){
+	__retarget_lock_acquire_recursive(xLock);
+}
+
+// Returns 0 when the lock is taken
+int __retarget_lock_try_acquire_recursive(_LOCK_T xLock){
+	SemaphoreHandle_t xMutex;
+
+	xMutex = prvLockMutex(xLock);
+	if(xMutex == NULL) return 0;
+	return (xSemaphoreTakeRecursive(xMutex, 0) == pdTRUE) ? 0 : 1;
+}
+
+int __retarget_lock_try_acquire(_LOCK_T xLock){
+	return __retarget_lock_try_acquire_recursive(xLock);
+}
+
+void __retarget_lock_release_recursive(_LOCK_T xLock){
+	SemaphoreHandle_t xMutex;
+
+	xMutex = prvLockMutex(xLock);
+	if(xMutex != NULL) xSemaphoreGiveRecursive(xMutex);
+}
+
+void __retarget_lock_release(_LOCK_T xLock){
+	__retarget_lock_release_recursive(xLock);
+}
+
+#endif
+
+#if defined(TRU_MALLOC_RTOS) && TRU_MALLOC_RTOS == 1U
+
+// ==============================================================================
+// malloc() from the FreeRTOS heap
+// ==============================================================================
+
+// In front of each block, it keeps the 8 byte alignment of pvPortMalloc()
+typedef struct{
+	void *pvBlock;  // What pvPortMalloc() returned
+	size_t xSize;   // Bytes usable from the user pointer
+}xMallocHeader_t;
+
+#define mallocHEADER(pv) ((xMallocHeader_t *)(pv) - 1)
+
+static void *prvMalloc(size_t xAlignment, size_t xSize){
+	uint8_t *pucBlock;
+	uintptr_t xUser;
+	size_t xExtra = sizeof(xMallocHeader_t);
+
+	if(xAlignment > portBYTE_ALIGNMENT) xExtra += xAlignment;
+	if(xSize > SIZE_MAX - xExtra){
+		errno = ENOMEM;
+		return NULL;
+	}
+
+	pucBlock = pvPortMalloc(xSize + xExtra);
+	if(pucBlock == NULL){
+		errno = ENOMEM;
+		return NULL;
+	}
+
+	xUser = (uintptr_t)pucBlock + sizeof(xMallocHeader_t);
+	if(xAlignment > portBYTE_ALIGNMENT) xUser = (xUser + xAlignment - 1U) & ~(uintptr_t)(xAlignment - 1U);
+	mallocHEADER(xUser)->pvBlock = pucBlock;
+	mallocHEADER(xUser)->xSize = xSize;
+
+	return (void *)xUser;
+}
+
+void *_malloc_r(struct _reent *pxReent, size_t xSize){
+	(void)pxReent;
+	return prvMalloc(portBYTE_ALIGNMENT, xSize);
+}
+
+void _free_r(struct _reent *pxReent, void *pv){
+	(void)pxReent;
+	if(pv != NULL) vPortFree(mallocHEADER(pv)->pvBlock);
+}
+
+// A smaller size keeps the block, a larger one moves it
+void *_realloc_r(struct _reent *pxReent, void *pv, size_t xSize){
+	void *pvNew;
+
+	if(pv == NULL) return _malloc_r(pxReent, xSize);
+	if(xSize == 0U){
+		_free_r(pxReent, pv);
+		return NULL;
+	}
+	if(xSize <= mallocHEADER(pv)->xSize) return pv;
+
+	pvNew = _malloc_r(pxReent, xSize);
+	if(pvNew != NULL){
+		memcpy(pvNew, pv, mallocHEADER(pv)->xSize);
+		_free_r(pxReent, pv);
+	}
+	return pvNew;
+}
+
+void *_calloc_r(struct _reent *pxReent, size_t xNum, size_t xSize){
+	void *pv;
+
+	if(xSize != 0U && xNum > SIZE_MAX / xSize){
+		errno = ENOMEM;
+		return NULL;
+	}
+
+	pv = _malloc_r(pxReent, xNum * xSize);
+	if(pv != NULL) memset(pv, 0, xNum * xSize);
+	return pv;
+}
+
+// The alignment is a power of 2
+void *_memalign_r(struct _reent *pxReent, size_t xAlignment, size_t xSize){
+	(void)pxReent;
+	return prvMalloc(xAlignment, xSize);
+}
+
+size_t _malloc_usable_size_r(struct _reent *pxReent, void *pv){
+	(void)pxReent;
+	return (pv != NULL) ? mallocHEADER(pv)->xSize : 0U;
+}
+
+void *malloc(size_t xSize){
+	return _malloc_r(_REENT, xSize);
+}
+
+void free(void *pv){
+	_free_r(_REENT, pv);
+}
+
+void *realloc(void *pv, size_t xSize){
+	return _realloc_r(_REENT, pv, xSize);
+}
+
+void *calloc(size_t xNum, size_t xSize){
+	return _calloc_r(_REENT, xNum, xSize);
+}
+
+void *memalign(size_t xAlignment, size_t xSize){
+	return _memalign_r(_REENT, xAlignment, xSize);
+}
+
+size_t malloc_usable_size(void *pv){
+	return _malloc_usable_size_r(_REENT, pv);
+}
+
+#endif
@@ -0,0 +1,57 @@
+/*
+	MIT License
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+
+
+	Developer: Truong Hy
+	Version  : 20261017
+
+	Build-time allocation of FreeRTOS tasks and queues, see freertos_static.h.
+*/
+
+#include "freertos_static.h"
+
+// Creates every task in the table.  Returns false if one couldn't be created
+bool freertos_static_tasks_create(const freertos_static_task_t *table, size_t count){
+	TaskHandle_t handle;
+	size_t i;
+
+	for(i = 0U; i < count; i++){
+		handle = xTaskCreateStatic(table[i].function, table[i].name, table[i].stack_depth, table[i].parameters, table[i].priority, table[i].stack, table[i].tcb);
+		if(handle == NULL) return false;
+		if(table[i].handle != NULL) *table[i].handle = handle;
+	}
+
+	return true;
+}
+
+// Creates every queue in the table.  Returns false if one couldn't be created
+bool freertos_static_queues_create(const freertos_static_queue_t *table, size_t count){
+	QueueHandle_t handle;
+	size_t i;
+
+	for(i = 0U; i < count; i++){
+		handle = xQueueCreateStatic(table[i].length, table[i].item_size, table[i].storage, table[i].queue);
+		if(handle == NULL) return false;
+		if(table[i].handle != NULL) *table[i].handle = handle;
+	}
+
+	return true;
+}
@@ -0,0 +1,100 @@
+/*
+	MIT License
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+
+
+	Developer: Truong Hy
+	Version  : 20261017
+
+	Build-time allocation of FreeRTOS tasks and queues.
+
+	A module declares the memory of its objects with the _STORAGE macros, lists
+	them in a const table with the _ENTRY macros, and creates them from the
+	table with the *Static APIs.  Nothing comes from the FreeRTOS heap, so
+	startup takes the same time every boot and cannot fail for lack of memory.
+
+	All the memory is placed in the .bss.rtos_static section, which the linker
+	script puts at the start of .bss between __rtos_static_start and
+	__rtos_static_end.  The build prints its size after linking, and the linker
+	script can move it to faster memory, e.g. on-chip RAM.
+
+	Example:
+		FREERTOS_STATIC_TASK_STORAGE(my_task, configMINIMAL_STACK_SIZE);
+		static const freertos_static_task_t my_tasks[] = {
+			FREERTOS_STATIC_TASK_ENTRY(my_task, my_task_func, "T", configMINIMAL_STACK_SIZE, NULL, 1U, NULL)
+		};
+		freertos_static_tasks_create(my_tasks, FREERTOS_STATIC_COUNT(my_tasks));
+*/
+
+#ifndef FREERTOS_STATIC_H
+#define FREERTOS_STATIC_H
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include <stdbool.h>
+#include <stddef.h>
+
+// Places an object in the static kernel object section
+#define FREERTOS_STATIC_SECTION __attribute__((section(".bss.rtos_static")))
+
+// Declares the stack and TCB of a task
+#define FREERTOS_STATIC_TASK_STORAGE(name, stack_depth) \
+	static StackType_t name##_stack[stack_depth] FREERTOS_STATIC_SECTION __attribute__((aligned(portBYTE_ALIGNMENT))); \
+	static StaticTask_t name##_tcb FREERTOS_STATIC_SECTION
+
+// Declares the storage area and control block of a queue
+#define FREERTOS_STATIC_QUEUE_STORAGE(name, length, item_size) \
+	static uint8_t name##_storage[(length) * (item_size)] FREERTOS_STATIC_SECTION __attribute__((aligned(portBYTE_ALIGNMENT))); \
+	static StaticQueue_t name##_queue FREERTOS_STATIC_SECTION
+
+// Table entries for storage declared with the macros above.  handle points
+// to where the created handle is written, it can be NULL for a task
+#define FREERTOS_STATIC_TASK_ENTRY(name, function, task_name, stack_depth, parameters, priority, handle) \
+	{ (function), (task_name), (stack_depth), (parameters), (priority), name##_stack, &name##_tcb, (handle) }
+
+#define FREERTOS_STATIC_QUEUE_ENTRY(name, length, item_size, handle) \
+	{ (length), (item_size), name##_storage, &name##_queue, (handle) }
+
+#define FREERTOS_STATIC_COUNT(table) (sizeof(table) / sizeof((table)[0]))
+
+typedef struct{
+	TaskFunction_t function;
+	const char *name;
+	uint32_t stack_depth;
+	void *parameters;
+	UBaseType_t priority;
+	StackType_t *stack;
+	StaticTask_t *tcb;
+	TaskHandle_t *handle;
+}freertos_static_task_t;
+
+typedef struct{
+	UBaseType_t length;
+	UBaseType_t item_size;
+	uint8_t *storage;
+	StaticQueue_t *queue;
+	QueueHandle_t *handle;
+}freertos_static_queue_t;
+
+bool freertos_static_tasks_create(const freertos_static_task_t *table, size_t count);
+bool freertos_static_queues_create(const freertos_static_queue_t *table, size_t count);
+
+#endif
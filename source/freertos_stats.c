@@ -0,0 +1,130 @@
+/*
+	MIT License
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+
+
+	Developer: Truong Hy
+	Version  : 20261017
+
+	CPU utilisation over a window of time, see freertos_stats.h.
+*/
+
+#include "freertos_stats.h"
+
+// Other includes
+#include "tru_cortex_a9.h"
+#include <stdio.h>
+
+// Counts as hundredths of a percent of total, total 0 gives 0
+uint32_t freertos_stats_percent(uint64_t counts, uint64_t total){
+	if(total == 0U) return 0U;
+	if(counts > total) counts = total;
+
+	// counts * 10000 overflows after about 100 days of the 200MHz global
+	// timer, the total is then large enough to be scaled down instead
+	if(counts <= UINT64_MAX / 10000U) return (uint32_t)(counts * 10000U / total);
+	return (uint32_t)(counts / (total / 10000U));
+}
+
+void freertos_stats_snapshot(freertos_stats_snapshot_t *snapshot){
+	uint32_t i;
+
+	vTaskSuspendAll();
+	{
+		snapshot->time = gtim_get_counter();
+		snapshot->idle = ulTaskGetIdleRunTimeCounter();
+		for(i = 0U; i < configNUMBER_OF_CORES; i++){
+			snapshot->isr[i] = ullGetISRRunTimeCounterValue(i);
+		}
+	}
+	xTaskResumeAll();
+}
+
+void freertos_stats_util(const freertos_stats_snapshot_t *start, const freertos_stats_snapshot_t *end, freertos_stats_util_t *util){
+	uint64_t total;
+	uint64_t idle;
+	uint64_t isr = 0U;
+	uint64_t isr_core;
+	uint32_t i;
+
+	util->window = end->time - start->time;
+	total = util->window * configNUMBER_OF_CORES;
+	idle = end->idle - start->idle;
+
+	for(i = 0U; i < configNUMBER_OF_CORES; i++){
+		isr_core = end->isr[i] - start->isr[i];
+		util->isr_core[i] = freertos_stats_percent(isr_core, util->window);
+		isr += isr_core;
+	}
+
+	util->busy = 10000U - freertos_stats_percent(idle, total);
+	util->isr = freertos_stats_percent(isr, total);
+	util->task = (util->busy > util->isr) ? util->busy - util->isr : 0U;
+}
+
+// Writes the run time stats of every task, like vTaskGetRunTimeStats(), with
+// the interrupt handler time of each core as a row of its own.  A row is the
+// name, the counts and the share of the time of all cores since the global
+// timer started.  Returns the length, 0 if the task table can't be allocated
+size_t freertos_stats_table(char *buf, size_t size){
+	TaskStatus_t *status;
+	UBaseType_t count;
+	uint64_t total;
+	uint64_t counts;
+	uint32_t percent;
+	size_t len = 0U;
+	UBaseType_t i;
+	char name[configMAX_TASK_NAME_LEN + 2U];
+
+	if(size == 0U) return 0U;
+	buf[0] = '\0';
+
+	count = uxTaskGetNumberOfTasks();
+	status = pvPortMalloc(count * sizeof(TaskStatus_t));
+	if(status == NULL) return 0U;
+	count = uxTaskGetSystemState(status, count, NULL);
+	total = gtim_get_counter() * configNUMBER_OF_CORES;
+
+	for(i = 0U; i < count + configNUMBER_OF_CORES && len < size; i++){
+		if(i < count){
+			snprintf(name, sizeof(name), "%s", status[i].pcTaskName);
+			counts = status[i].ulRunTimeCounter;
+		}else{
+			snprintf(name, sizeof(name), "ISR%lu", (unsigned long)(i - count));
+			counts = ullGetISRRunTimeCounterValue(i - count);
+		}
+		percent = freertos_stats_percent(counts, total);
+		len += (size_t)snprintf(&buf[len], size - len, "%-*s %20llu %3lu.%02lu%%\n", configMAX_TASK_NAME_LEN, name, (unsigned long long)counts, (unsigned long)(percent / 100U), (unsigned long)(percent % 100U));
+	}
+	vPortFree(status);
+
+	return (len < size) ? len : size - 1U;
+}
+
+#if defined(TRU_PMU) && TRU_PMU == 1U
+// Performance monitor totals of a task, NULL for the calling task
+void freertos_stats_pmu(TaskHandle_t task, tru_pmu_counters_t *counters){
+	TaskStatus_t status;
+
+	if(task == NULL) task = xTaskGetCurrentTaskHandle();
+	vTaskGetInfo(task, &status, pdFALSE, eRunning);
+	tru_pmu_task_get(status.xTaskNumber, counters);
+}
+#endif
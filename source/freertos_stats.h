@@ -0,0 +1,84 @@
+/*
+	MIT License
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+
+
+	Developer: Truong Hy
+	Version  : 20261017
+
+	CPU utilisation over a window of time, from the FreeRTOS run time stats.
+
+	The run time counter is the global timer at full resolution less the time
+	spent in interrupt handlers, see FreeRTOSConfig.h, so the task counters
+	(ulTaskGetRunTimeCounter() or uxTaskGetSystemState()) only hold task
+	context time and the interrupt time of each core is kept apart.  All values
+	are in global timer counts and 64-bit, so they don't wrap.
+
+	Take a snapshot at the start and at the end of the window, then
+	freertos_stats_util() gives the share of the window spent in each context.
+	A task share is the difference of its counter over the window, converted
+	with freertos_stats_percent().  Shares are in hundredths of a percent of
+	the time of all cores.
+
+	The idle task counters are only updated when an idle task is switched out,
+	so a snapshot taken while another core is idle misses its current idle
+	period.  A window much longer than a tick keeps the error small.
+
+	freertos_stats_table() writes the run time stats of every task as a text
+	table, with the interrupt handler time of each core as its own row, which
+	vTaskGetRunTimeStats() would leave out.
+
+	freertos_stats_pmu() reads the performance monitor totals of a task, see
+	tru_pmu.h.  Like the run time counters, take them at the start and end of
+	a window and use the difference.
+*/
+
+#ifndef FREERTOS_STATS_H
+#define FREERTOS_STATS_H
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "tru_pmu.h"
+#include <stddef.h>
+#include <stdint.h>
+
+typedef struct{
+	uint64_t time;                        // Global timer counter
+	uint64_t idle;                        // Idle tasks run time, all cores
+	uint64_t isr[configNUMBER_OF_CORES];  // Interrupt handler time of each core
+}freertos_stats_snapshot_t;
+
+typedef struct{
+	uint64_t window;                      // Window length in counts
+	uint32_t busy;                        // Not idle, tasks and interrupts
+	uint32_t task;                        // Task context, including the kernel
+	uint32_t isr;                         // Interrupt handlers, all cores
+	uint32_t isr_core[configNUMBER_OF_CORES];  // Interrupt handlers of each core, share of that core
+}freertos_stats_util_t;
+
+void freertos_stats_snapshot(freertos_stats_snapshot_t *snapshot);
+void freertos_stats_util(const freertos_stats_snapshot_t *start, const freertos_stats_snapshot_t *end, freertos_stats_util_t *util);
+uint32_t freertos_stats_percent(uint64_t counts, uint64_t total);
+size_t freertos_stats_table(char *buf, size_t size);
+#if defined(TRU_PMU) && TRU_PMU == 1U
+void freertos_stats_pmu(TaskHandle_t task, tru_pmu_counters_t *counters);
+#endif
+
+#endif
@@ -0,0 +1,115 @@
+/*
+ * FreeRTOS V202212.01
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+#ifndef FREERTOS_CONFIG_H
+#define FREERTOS_CONFIG_H
+
+/*-----------------------------------------------------------
+ * Application specific definitions.
+ *
+ * These definitions should be adjusted for your particular hardware and
+ * application requirements.
+ *
+ * THESE PARAMETERS ARE DESCRIBED WITHIN THE 'CONFIGURATION' SECTION OF THE
+ * FreeRTOS API DOCUMENTATION AVAILABLE ON THE FreeRTOS.org WEB SITE.
+ *
+ * See http://www.freertos.org/a00110.html for a full list of configuration
+ * options.
+ *----------------------------------------------------------*/
+
+/*
+ * The host build, Makefile-host.mk, with the POSIX port of this folder,
+ * freertos_posix.c.  The include path puts this folder
+ * before the source folder, so this file is used instead of the target's
+ * FreeRTOSConfig.h.  The settings the application tasks depend on are the same
+ * as the target's: the tick rate, priorities and static allocation.  The
+ * target specific ones (interrupt controller, timers, FPU, tickless idle, run
+ * time stats) are left out.
+ */
+
+/* The kernel objects of the application are allocated at build time, see
+freertos_static.h.  The heap is for the host test task. */
+#define configSUPPORT_STATIC_ALLOCATION			1
+#define configSUPPORT_DYNAMIC_ALLOCATION		1
+
+/* The POSIX port is single core, and a task only gives up the CPU where it
+calls the kernel, see freertos_posix.c.  The idle hook must call
+vPortWaitForTick(). */
+#define configNUMBER_OF_CORES					1
+#define configUSE_PORT_OPTIMISED_TASK_SELECTION	0
+#define configUSE_TICKLESS_IDLE					0
+#define configUSE_IDLE_HOOK						1
+
+#define configTICK_RATE_HZ						( ( TickType_t ) 1000 )
+#define configUSE_PREEMPTION					1
+#define configMAX_PRIORITIES					( 7 )
+/* Each task runs on its own thread with its own stack, the task stack only
+holds the thread state of the port. */
+#define configMINIMAL_STACK_SIZE				( ( unsigned short ) 200 )
+#define configTOTAL_HEAP_SIZE					( 50 * 1024 )
+#define configMAX_TASK_NAME_LEN					( 10 )
+#define configUSE_TRACE_FACILITY				1
+#define configUSE_16_BIT_TICKS					0
+#define configIDLE_SHOULD_YIELD					1
+#define configUSE_MUTEXES						1
+#define configQUEUE_REGISTRY_SIZE				8
+#define configCHECK_FOR_STACK_OVERFLOW			0
+#define configUSE_RECURSIVE_MUTEXES				1
+#define configUSE_APPLICATION_TASK_TAG			0
+#define configUSE_COUNTING_SEMAPHORES			1
+#define configUSE_QUEUE_SETS					1
+#define configUSE_MALLOC_FAILED_HOOK			1
+#define configUSE_TICK_HOOK						0
+#define configUSE_DAEMON_TASK_STARTUP_HOOK		0
+
+/* Software timer definitions. */
+#define configUSE_TIMERS						1
+#define configTIMER_TASK_PRIORITY				( configMAX_PRIORITIES - 1 )
+#define configTIMER_QUEUE_LENGTH				5
+#define configTIMER_TASK_STACK_DEPTH			( configMINIMAL_STACK_SIZE * 2 )
+
+/* Set the following definitions to 1 to include the API function, or zero
+to exclude the API function. */
+#define INCLUDE_vTaskPrioritySet				1
+#define INCLUDE_uxTaskPriorityGet				1
+#define INCLUDE_vTaskDelete						1
+#define INCLUDE_vTaskCleanUpResources			1
+#define INCLUDE_vTaskSuspend					1
+#define INCLUDE_vTaskDelayUntil					1
+#define INCLUDE_vTaskDelay						1
+#define INCLUDE_xTimerPendFunctionCall			1
+#define INCLUDE_eTaskGetState					1
+#define INCLUDE_xTaskGetIdleTaskHandle			1
+#define INCLUDE_xTaskGetSchedulerState			1
+#define INCLUDE_xTaskGetCurrentTaskHandle		1
+#define INCLUDE_uxTaskGetStackHighWaterMark	1
+
+/* Normal assert() semantics without relying on the provision of an assert.h
+header file. */
+void vAssertCalled( const char * pcFile, unsigned long ulLine );
+#define configASSERT( x ) if( ( x ) == 0 ) vAssertCalled( __FILE__, __LINE__ );
+
+#endif /* FREERTOS_CONFIG_H */
@@ -0,0 +1,186 @@
+/*
+	MIT License
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+
+	Developer: Truong Hy
+	Version  : 20261017
+
+
+	The blinky demo on a Linux host, built with make -f Makefile-host.mk.  The
+	tasks of blinky_tasks.c and blinky_gpio.c run unmodified on the POSIX port
+	of freertos_posix.c, and the GPIO registers are the fake HPS register
+	blocks of tru_c5soc_hps_sim.h.
+
+	A test task plays the user: it reads the LED from the GPIO1 output register
+	and presses the key by writing the GPIO1 input register, then checks that:
+		- the LED blinks every BLINKY_BLINK_MSG_RATE_MILLISEC with the key up
+		- holding the key down stops the blinking with the LED on
+		- releasing the key resumes the blinking
+	It ends the scheduler when done, and the program exits with 0 when all
+	passed, else 1.  The log goes to stderr.
+*/
+
+// FreeRTOS includes
+#include "FreeRTOS.h"
+#include "task.h"
+
+// Trulib includes
+#include "tru_c5soc_hps_sim.h"
+
+// Other includes
+#include "blinky_gpio.h"
+#include "freertos_static.h"
+
+// Standard includes
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define HOST_TEST_TASK_PRIORITY (configMAX_PRIORITIES - 2U)
+
+#define HOST_SAMPLE_MS  10U    // LED sample period
+#define HOST_BLINK_MS   2000U  // Time the blinking is counted for, 10 blinks
+#define HOST_BLINKS_MIN 9U
+#define HOST_BLINKS_MAX 11U
+#define HOST_SETTLE_MS  250U   // Longer than the key poll period
+#define HOST_HOLD_MS    1000U  // Time the key is held down for
+
+extern bool blinky_setup(void);
+
+static void host_test_task(void *parameters);
+
+FREERTOS_STATIC_TASK_STORAGE(host_test, configMINIMAL_STACK_SIZE);
+FREERTOS_STATIC_TASK_STORAGE(xIdleTask, configMINIMAL_STACK_SIZE);
+FREERTOS_STATIC_TASK_STORAGE(xTimerTask, configTIMER_TASK_STACK_DEPTH);
+
+static const freertos_static_task_t host_tasks[] = {
+	FREERTOS_STATIC_TASK_ENTRY(host_test, host_test_task, "T", configMINIMAL_STACK_SIZE, NULL, HOST_TEST_TASK_PRIORITY, NULL)
+};
+
+static int host_result = 1;
+
+// The LED as the board would show it, the pin's bit of the output register
+static bool host_led(void){
+	return (TRU_HPS_GPIO1_REG->port_wr & (1U << (DE10N_LED_GPIO_PINNUM - TRU_HPS_GPIO1_FIRST_PINNUM))) != 0U;
+}
+
+// The key pulls its pin low while it is pressed
+static void host_key(bool down){
+	const uint32_t mask = 1U << (DE10N_KEY_GPIO_PINNUM - TRU_HPS_GPIO1_FIRST_PINNUM);
+
+	taskENTER_CRITICAL();
+	{
+		if(down){
+			TRU_HPS_GPIO1_REG->port_rd &= ~mask;
+		}else{
+			TRU_HPS_GPIO1_REG->port_rd |= mask;
+		}
+	}
+	taskEXIT_CRITICAL();
+}
+
+// Counts the LED changes over the time given
+static uint32_t host_count_blinks(uint32_t ms){
+	TickType_t last_wakeup_time = xTaskGetTickCount();
+	bool led = host_led();
+	uint32_t blinks = 0U;
+	uint32_t i;
+
+	for(i = 0U; i < ms / HOST_SAMPLE_MS; i++){
+		vTaskDelayUntil(&last_wakeup_time, pdMS_TO_TICKS(HOST_SAMPLE_MS));
+		if(host_led() != led){
+			led = !led;
+			blinks++;
+		}
+	}
+
+	return blinks;
+}
+
+static bool host_check(bool pass, const char *name, uint32_t value){
+	printf("%-36s %4u  %s\n", name, (unsigned int)value, pass ? "passed" : "FAILED");
+
+	return pass;
+}
+
+static void host_test_task(void *parameters){
+	bool pass = true;
+	uint32_t blinks;
+
+	// Suppress compiler unused parameter warning
+	(void)parameters;
+
+	blinks = host_count_blinks(HOST_BLINK_MS);
+	pass &= host_check(blinks >= HOST_BLINKS_MIN && blinks <= HOST_BLINKS_MAX, "LED changes with the key up", blinks);
+
+	host_key(true);
+	vTaskDelay(pdMS_TO_TICKS(HOST_SETTLE_MS));
+	pass &= host_check(host_led(), "LED on with the key down", host_led());
+	blinks = host_count_blinks(HOST_HOLD_MS);
+	pass &= host_check(blinks == 0U, "LED changes with the key down", blinks);
+
+	host_key(false);
+	blinks = host_count_blinks(HOST_BLINK_MS);
+	pass &= host_check(blinks >= HOST_BLINKS_MIN && blinks <= HOST_BLINKS_MAX + 1U, "LED changes after the key up", blinks);
+
+	host_result = pass ? 0 : 1;
+	printf("%s\n", pass ? "passed" : "FAILED");
+	vTaskEndScheduler();
+}
+
+void vApplicationIdleHook(void){
+	// The POSIX port only switches tasks where they call the kernel
+	vPortWaitForTick();
+}
+
+void vApplicationMallocFailedHook(void){
+	fprintf(stderr, "Out of FreeRTOS heap\n");
+	abort();
+}
+
+void vAssertCalled(const char *pcFile, unsigned long ulLine){
+	fprintf(stderr, "Assert failed, %s, %lu\n", pcFile, ulLine);
+	abort();
+}
+
+void vApplicationGetIdleTaskMemory(StaticTask_t **ppxIdleTaskTCBBuffer, StackType_t **ppxIdleTaskStackBuffer, configSTACK_DEPTH_TYPE *puxIdleTaskStackSize){
+	*ppxIdleTaskTCBBuffer = &xIdleTask_tcb;
+	*ppxIdleTaskStackBuffer = xIdleTask_stack;
+	*puxIdleTaskStackSize = configMINIMAL_STACK_SIZE;
+}
+
+void vApplicationGetTimerTaskMemory(StaticTask_t **ppxTimerTaskTCBBuffer, StackType_t **ppxTimerTaskStackBuffer, configSTACK_DEPTH_TYPE *puxTimerTaskStackSize){
+	*ppxTimerTaskTCBBuffer = &xTimerTask_tcb;
+	*ppxTimerTaskStackBuffer = xTimerTask_stack;
+	*puxTimerTaskStackSize = configTIMER_TASK_STACK_DEPTH;
+}
+
+int main(void){
+	// Reset values of the fake registers, and the key is up
+	tru_hps_sim_init();
+	host_key(false);
+
+	if(!blinky_setup()) return 1;
+	if(!freertos_static_tasks_create(host_tasks, FREERTOS_STATIC_COUNT(host_tasks))) return 1;
+
+	vTaskStartScheduler();
+
+	return host_result;
+}
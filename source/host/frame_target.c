@@ -0,0 +1,148 @@
+/*
+	MIT License
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+
+	Developer: Truong Hy
+	Version  : 20261017
+
+
+	Host program with the trulib framed transport (tru_frame.c), the target of
+	the loopback test of scripts-generic/tru_frame_client.py.  It is built with
+	make -f Makefile-host.mk and runs on the pseudo terminal given to it as
+	stdin and stdout:
+		frame_target [seed]
+
+	Like frame_task.c it echoes each 'P' ping command, and before the reply it
+	sends a log line, some garbage ending with a delimiter and a telemetry
+	report.  The frame_errors field of the report counts the frames that
+	tru_frame_rx() dropped, so the client can check the garbage it sent.  It
+	exits when the other side closes the terminal.
+*/
+
+// Trulib includes
+#include "tru_frame.h"
+
+// Standard includes
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#define FRAME_RX_SIZE     2048U  // Largest command frame
+#define FRAME_GARBAGE_MAX 8U
+
+#define FRAME_CMD_PING    'P'
+#define FRAME_CMD_UNKNOWN '?'
+
+// The telemetry report, the layout is read by tru_frame_client.py
+typedef struct{
+	uint32_t time_ms;
+	uint32_t heap_free;
+	uint32_t heap_min_free;
+	uint32_t rx_overruns;
+	uint32_t rx_dropped;
+	uint32_t frame_errors;
+}frame_telemetry_t;
+
+static tru_frame_t frame_link;
+static uint8_t frame_rx_buf[FRAME_RX_SIZE];
+static unsigned int frame_seed = 1U;
+static uint32_t frame_count;
+
+static void frame_write(tru_frame_t *link, const uint8_t *buf, uint32_t len){
+	ssize_t n;
+	(void)link;
+
+	while(len != 0U){
+		n = write(STDOUT_FILENO, buf, len);
+		if(n < 0){
+			if(errno == EINTR) continue;
+			exit(1);
+		}
+		buf += n;
+		len -= (uint32_t)n;
+	}
+}
+
+// Random non-zero bytes and a delimiter, the client must drop them
+static void frame_garbage(tru_frame_t *link){
+	uint8_t buf[FRAME_GARBAGE_MAX + 1U];
+	uint32_t len = (uint32_t)rand_r(&frame_seed) % (FRAME_GARBAGE_MAX + 1U);
+	uint32_t i;
+
+	for(i = 0U; i < len; i++){
+		buf[i] = (uint8_t)(1 + rand_r(&frame_seed) % 255);
+	}
+	buf[len] = TRU_FRAME_DELIM;
+	link->write(link, buf, len + 1U);
+}
+
+static void frame_command(tru_frame_t *link, uint32_t channel, const uint8_t *data, uint32_t len){
+	uint8_t unknown = FRAME_CMD_UNKNOWN;
+	tru_frame_iov_t iov[2] = {
+		{ .buf = &unknown, .len = 1U },
+		{ .buf = data, .len = len }
+	};
+	frame_telemetry_t report;
+	char text[32];
+
+	if(len == 0U) return;
+
+	snprintf(text, sizeof(text), "command %u\r\n", (unsigned int)frame_count);
+	tru_frame_send(link, TRU_FRAME_CH_LOG, text, (uint32_t)strlen(text));
+
+	frame_garbage(link);
+
+	memset(&report, 0, sizeof(report));
+	report.time_ms = frame_count;
+	report.frame_errors = link->rx_errors;
+	tru_frame_send(link, TRU_FRAME_CH_TELEMETRY, &report, sizeof(report));
+
+	// The ping reply goes out in two parts, as the zero-copy replies of
+	// frame_task.c do
+	if(data[0] == FRAME_CMD_PING){
+		iov[0].buf = data;
+		iov[1].buf = &data[1];
+		iov[1].len = len - 1U;
+	}
+	tru_frame_sendv(link, channel, iov, 2U);
+
+	frame_count++;
+}
+
+int main(int argc, char *argv[]){
+	uint8_t buf[256];
+	ssize_t len;
+
+	if(argc > 1) frame_seed = (unsigned int)strtoul(argv[1], NULL, 0);
+
+	tru_frame_init(&frame_link, frame_write, NULL, NULL, frame_rx_buf, FRAME_RX_SIZE, NULL);
+	tru_frame_handler_set(&frame_link, TRU_FRAME_CH_COMMAND, frame_command);
+
+	for(;;){
+		len = read(STDIN_FILENO, buf, sizeof(buf));
+		if(len < 0 && errno == EINTR) continue;
+		if(len <= 0) break;  // EIO on a pseudo terminal once the other side closes
+		tru_frame_rx(&frame_link, buf, (uint32_t)len);
+	}
+
+	return 0;
+}
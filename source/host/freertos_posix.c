@@ -0,0 +1,423 @@
+/*
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * Developer: Truong Hy
+ * Version  : 20261017
+ *
+ * POSIX (Linux) port for the host build, Makefile-host.mk.  It runs the
+ * application tasks on a developer machine against the fake HPS register blocks
+ * of tru_c5soc_hps_sim.h.  It is a small cooperative stand-in for the
+ * preemptive, signal driven GCC/Posix port of the FreeRTOS distribution, which
+ * this tree does not ship, and it is kept here with the host build rather than
+ * in the kernel's portable folder.  It is single core:
+ *
+ * - Each task runs on its own thread, and only the thread of the running task
+ *   runs task code, the others wait on their condition variable.
+ * - The CPU is a mutex.  Masking interrupts (a critical section) takes it, and
+ *   the tick thread takes it to run the tick, so the tick never interrupts
+ *   a critical section.
+ * - A context switch passes the mutex from the thread of one task to the
+ *   other, along with the critical nesting of the task.
+ * - No signals are used.  A task is switched out when it calls the kernel: at
+ *   the end of a critical section, a yield or a block.  A tick that unblocks a
+ *   higher priority task only sets a pending switch.  So a task that spins
+ *   without calling the kernel is not preempted, and the idle task waits for
+ *   the tick in vApplicationIdleHook(), see vPortWaitForTick().
+ *
+ * So it is for functional tests of tasks that block or delay, like the blinky
+ * tasks.  A task that busy polls hangs it, and it can't run throughput or
+ * stress tests.  The cost of switching between threads on each call is nothing
+ * like the target's, measure timing on the board.
+ */
+
+/* Standard includes. */
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+#if configNUMBER_OF_CORES != 1
+    #error "The POSIX host port is single core only"
+#endif
+
+#if configUSE_TICKLESS_IDLE != 0
+    #error "configUSE_TICKLESS_IDLE must be 0 with the POSIX host port"
+#endif
+
+/* The state of a task's thread, kept in the task's stack. */
+typedef struct THREAD
+{
+    pthread_t xThread;
+    pthread_cond_t xCond;            /* Signalled when xRunning or xExit is set. */
+    BaseType_t xRunning;             /* pdTRUE while the task owns the CPU. */
+    BaseType_t xExit;                /* pdTRUE when the task has been deleted. */
+    UBaseType_t uxCriticalNesting;   /* Saved while the task is switched out. */
+    TaskFunction_t pxCode;
+    void * pvParameters;
+} Thread_t;
+
+/* The CPU, held by whoever has interrupts masked. */
+static pthread_mutex_t xCpuMutex = PTHREAD_MUTEX_INITIALIZER;
+
+/* Signalled by the tick thread after each tick, and as the scheduler ends. */
+static pthread_cond_t xTickCond = PTHREAD_COND_INITIALIZER;
+
+/* The following belong to the holder of xCpuMutex.  xInterruptsMasked is the
+ * mask of the running task, only its thread reads it without the mutex. */
+static BaseType_t xInterruptsMasked = pdFALSE;
+static UBaseType_t uxCriticalNesting = 0;
+static BaseType_t xSwitchPending = pdFALSE;
+static BaseType_t xSchedulerEnded = pdFALSE;
+static uint32_t ulTickCount = 0;
+
+static pthread_t xTickThread;
+
+/*-----------------------------------------------------------*/
+
+/* The thread state is stored under the top of stack that the kernel saves in
+ * the TCB, which is the first member of a TCB.  This port never changes it. */
+static Thread_t * prvGetThread( void * pxTCB )
+{
+    StackType_t * pxTopOfStack = *( StackType_t ** ) pxTCB;
+
+    return ( Thread_t * ) ( pxTopOfStack + 1 );
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvIsTickThread( void )
+{
+    return ( xSchedulerEnded == pdFALSE && pthread_equal( pthread_self(), xTickThread ) ) ? pdTRUE : pdFALSE;
+}
+/*-----------------------------------------------------------*/
+
+/* Called with xCpuMutex held.  Selects the next task and, if it is another
+ * one, wakes its thread and waits until this task is switched in again. */
+static void prvSwitchContext( void )
+{
+    Thread_t * pxOld = prvGetThread( xTaskGetCurrentTaskHandle() );
+    Thread_t * pxNew;
+
+    xSwitchPending = pdFALSE;
+    vTaskSwitchContext();
+    pxNew = prvGetThread( xTaskGetCurrentTaskHandle() );
+
+    if( pxNew != pxOld )
+    {
+        pxOld->uxCriticalNesting = uxCriticalNesting;
+        pxOld->xRunning = pdFALSE;
+        pxNew->xRunning = pdTRUE;
+        pthread_cond_signal( &pxNew->xCond );
+
+        while( pxOld->xRunning == pdFALSE )
+        {
+            if( pxOld->xExit != pdFALSE )
+            {
+                pthread_mutex_unlock( &xCpuMutex );
+                pthread_exit( NULL );
+            }
+
+            pthread_cond_wait( &pxOld->xCond, &xCpuMutex );
+        }
+
+        /* Switched in by another task, which passed the CPU with interrupts
+         * masked. */
+        uxCriticalNesting = pxOld->uxCriticalNesting;
+        xInterruptsMasked = pdTRUE;
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void * prvTaskThread( void * pvParameters )
+{
+    Thread_t * pxThread = ( Thread_t * ) pvParameters;
+
+    pthread_mutex_lock( &xCpuMutex );
+
+    while( pxThread->xRunning == pdFALSE )
+    {
+        if( pxThread->xExit != pdFALSE )
+        {
+            pthread_mutex_unlock( &xCpuMutex );
+            return NULL;
+        }
+
+        pthread_cond_wait( &pxThread->xCond, &xCpuMutex );
+    }
+
+    /* A task starts with interrupts enabled. */
+    uxCriticalNesting = 0;
+    xInterruptsMasked = pdFALSE;
+    pthread_mutex_unlock( &xCpuMutex );
+
+    pxThread->pxCode( pxThread->pvParameters );
+
+    /* A task must not return, see configTASK_RETURN_ADDRESS on the target. */
+    fprintf( stderr, "A task returned from its function\n" );
+    abort();
+
+    return NULL;
+}
+/*-----------------------------------------------------------*/
+
+static void * prvTickThread( void * pvParameters )
+{
+    struct timespec xNext;
+    const long lPeriodNs = 1000000000L / configTICK_RATE_HZ;
+
+    ( void ) pvParameters;
+
+    clock_gettime( CLOCK_MONOTONIC, &xNext );
+
+    for( ; ; )
+    {
+        xNext.tv_nsec += lPeriodNs;
+
+        if( xNext.tv_nsec >= 1000000000L )
+        {
+            xNext.tv_nsec -= 1000000000L;
+            xNext.tv_sec++;
+        }
+
+        clock_nanosleep( CLOCK_MONOTONIC, TIMER_ABSTIME, &xNext, NULL );
+
+        pthread_mutex_lock( &xCpuMutex );
+
+        if( xSchedulerEnded != pdFALSE )
+        {
+            pthread_mutex_unlock( &xCpuMutex );
+            break;
+        }
+
+        if( xTaskIncrementTick() != pdFALSE )
+        {
+            xSwitchPending = pdTRUE;
+        }
+
+        ulTickCount++;
+        pthread_cond_broadcast( &xTickCond );
+        pthread_mutex_unlock( &xCpuMutex );
+    }
+
+    return NULL;
+}
+/*-----------------------------------------------------------*/
+
+StackType_t * pxPortInitialiseStack( StackType_t * pxTopOfStack,
+                                     TaskFunction_t pxCode,
+                                     void * pvParameters )
+{
+    Thread_t * pxThread;
+    pthread_attr_t xAttr;
+
+    /* The thread state goes at the aligned top of the stack. */
+    pxThread = ( Thread_t * ) ( ( ( portPOINTER_SIZE_TYPE ) ( pxTopOfStack + 1 ) - sizeof( Thread_t ) ) & ~( ( portPOINTER_SIZE_TYPE ) portBYTE_ALIGNMENT_MASK ) );
+    pxThread->xRunning = pdFALSE;
+    pxThread->xExit = pdFALSE;
+    pxThread->uxCriticalNesting = 0;
+    pxThread->pxCode = pxCode;
+    pxThread->pvParameters = pvParameters;
+    pthread_cond_init( &pxThread->xCond, NULL );
+
+    pthread_attr_init( &xAttr );
+
+    if( pthread_create( &pxThread->xThread, &xAttr, prvTaskThread, pxThread ) != 0 )
+    {
+        fprintf( stderr, "Failed to create the thread of a task\n" );
+        abort();
+    }
+
+    pthread_attr_destroy( &xAttr );
+
+    return ( ( StackType_t * ) pxThread ) - 1;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xPortStartScheduler( void )
+{
+    Thread_t * pxFirst;
+
+    /* Interrupts were masked by vTaskStartScheduler(), so this thread holds the
+     * CPU until it waits below. */
+    if( pthread_create( &xTickThread, NULL, prvTickThread, NULL ) != 0 )
+    {
+        return pdFALSE;
+    }
+
+    pxFirst = prvGetThread( xTaskGetCurrentTaskHandle() );
+    pxFirst->xRunning = pdTRUE;
+    pthread_cond_signal( &pxFirst->xCond );
+
+    while( xSchedulerEnded == pdFALSE )
+    {
+        pthread_cond_wait( &xTickCond, &xCpuMutex );
+    }
+
+    xInterruptsMasked = pdFALSE;
+    pthread_mutex_unlock( &xCpuMutex );
+    pthread_join( xTickThread, NULL );
+
+    return pdTRUE;
+}
+/*-----------------------------------------------------------*/
+
+void vPortEndScheduler( void )
+{
+    /* Called by a task through vTaskEndScheduler() with interrupts masked.
+     * vTaskStartScheduler() returns in the thread that called it, and the
+     * calling task's thread ends here. */
+    xSchedulerEnded = pdTRUE;
+    pthread_cond_broadcast( &xTickCond );
+    pthread_mutex_unlock( &xCpuMutex );
+    pthread_exit( NULL );
+}
+/*-----------------------------------------------------------*/
+
+void vPortDisableInterrupts( void )
+{
+    if( xInterruptsMasked == pdFALSE )
+    {
+        pthread_mutex_lock( &xCpuMutex );
+        xInterruptsMasked = pdTRUE;
+    }
+}
+/*-----------------------------------------------------------*/
+
+void vPortEnableInterrupts( void )
+{
+    if( xInterruptsMasked != pdFALSE )
+    {
+        /* The kernel calls are done, switch now if a tick asked for it. */
+        if( ( xSwitchPending != pdFALSE ) && ( xTaskGetSchedulerState() == taskSCHEDULER_RUNNING ) )
+        {
+            prvSwitchContext();
+        }
+
+        xInterruptsMasked = pdFALSE;
+        pthread_mutex_unlock( &xCpuMutex );
+    }
+}
+/*-----------------------------------------------------------*/
+
+void vPortEnterCritical( void )
+{
+    vPortDisableInterrupts();
+    uxCriticalNesting++;
+}
+/*-----------------------------------------------------------*/
+
+void vPortExitCritical( void )
+{
+    configASSERT( uxCriticalNesting > 0 );
+
+    uxCriticalNesting--;
+
+    if( uxCriticalNesting == 0 )
+    {
+        vPortEnableInterrupts();
+    }
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxPortSetInterruptMask( void )
+{
+    /* The tick thread already holds the CPU. */
+    if( prvIsTickThread() != pdFALSE )
+    {
+        return pdTRUE;
+    }
+
+    if( xInterruptsMasked != pdFALSE )
+    {
+        return pdTRUE;
+    }
+
+    vPortDisableInterrupts();
+
+    return pdFALSE;
+}
+/*-----------------------------------------------------------*/
+
+void vPortClearInterruptMask( UBaseType_t uxNewMaskValue )
+{
+    if( uxNewMaskValue == pdFALSE )
+    {
+        vPortEnableInterrupts();
+    }
+}
+/*-----------------------------------------------------------*/
+
+void vPortYield( void )
+{
+    vPortEnterCritical();
+    prvSwitchContext();
+    vPortExitCritical();
+}
+/*-----------------------------------------------------------*/
+
+void vPortYieldFromISR( void )
+{
+    if( prvIsTickThread() != pdFALSE )
+    {
+        xSwitchPending = pdTRUE;
+    }
+    else
+    {
+        vPortYield();
+    }
+}
+/*-----------------------------------------------------------*/
+
+void vPortWaitForTick( void )
+{
+    uint32_t ulTick;
+
+    vPortEnterCritical();
+    ulTick = ulTickCount;
+
+    while( ulTick == ulTickCount )
+    {
+        pthread_cond_wait( &xTickCond, &xCpuMutex );
+    }
+
+    vPortExitCritical();
+}
+/*-----------------------------------------------------------*/
+
+void vPortCleanUpTCB( void * pxTCB )
+{
+    Thread_t * pxThread = prvGetThread( pxTCB );
+
+    /* The kernel frees a TCB outside of a critical section, the thread is
+     * waiting to be switched in and ends when it is told to exit. */
+    configASSERT( xInterruptsMasked == pdFALSE );
+
+    pthread_mutex_lock( &xCpuMutex );
+    pxThread->xExit = pdTRUE;
+    pthread_cond_signal( &pxThread->xCond );
+    pthread_mutex_unlock( &xCpuMutex );
+
+    pthread_join( pxThread->xThread, NULL );
+    pthread_cond_destroy( &pxThread->xCond );
+}
+/*-----------------------------------------------------------*/
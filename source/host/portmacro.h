@@ -0,0 +1,141 @@
+/*
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * Developer: Truong Hy
+ * Version  : 20261017
+ *
+ * POSIX (Linux) port for the host build, see freertos_posix.c.
+ */
+
+#ifndef PORTMACRO_H
+#define PORTMACRO_H
+
+/* *INDENT-OFF* */
+#ifdef __cplusplus
+    extern "C" {
+#endif
+/* *INDENT-ON* */
+
+#include <stdint.h>
+
+/*-----------------------------------------------------------
+ * Port specific definitions.
+ *
+ * The settings in this file configure FreeRTOS correctly for the given hardware
+ * and compiler.
+ *
+ * These settings should not be altered.
+ *-----------------------------------------------------------
+ */
+
+/* Type definitions. */
+#define portCHAR          char
+#define portFLOAT         float
+#define portDOUBLE        double
+#define portLONG          long
+#define portSHORT         short
+#define portSTACK_TYPE    unsigned long
+#define portBASE_TYPE     long
+#define portPOINTER_SIZE_TYPE    uintptr_t
+
+typedef portSTACK_TYPE   StackType_t;
+typedef long             BaseType_t;
+typedef unsigned long    UBaseType_t;
+
+typedef uint32_t         TickType_t;
+#define portMAX_DELAY              ( TickType_t ) 0xffffffffUL
+
+/* The tick count is only written by the tick thread and read in one access. */
+#define portTICK_TYPE_IS_ATOMIC    1
+
+/*-----------------------------------------------------------*/
+
+/* Host specifics.  Each task runs on its own thread, which has its own stack,
+ * so the task stack only holds the thread state, see pxPortInitialiseStack(). */
+#define portSTACK_GROWTH      ( -1 )
+#define portTICK_PERIOD_MS    ( ( TickType_t ) 1000 / configTICK_RATE_HZ )
+#define portBYTE_ALIGNMENT    8
+
+/*-----------------------------------------------------------*/
+
+/* Task utilities. */
+
+/* Called by a simulated interrupt handler, i.e. the tick hook, that can cause a
+ * context switch.  The switch happens when the running task next calls the
+ * kernel. */
+extern void vPortYieldFromISR( void );
+#define portEND_SWITCHING_ISR( xSwitchRequired ) \
+    {                                            \
+        if( xSwitchRequired != pdFALSE )         \
+        {                                        \
+            vPortYieldFromISR();                 \
+        }                                        \
+    }
+#define portYIELD_FROM_ISR( x )    portEND_SWITCHING_ISR( x )
+
+extern void vPortYield( void );
+#define portYIELD()    vPortYield()
+
+/*-----------------------------------------------------------
+ * Critical section control.  Masking interrupts means holding the mutex that
+ * the tick thread takes to run the tick.
+ *----------------------------------------------------------*/
+
+extern void vPortEnterCritical( void );
+extern void vPortExitCritical( void );
+extern void vPortDisableInterrupts( void );
+extern void vPortEnableInterrupts( void );
+extern UBaseType_t uxPortSetInterruptMask( void );
+extern void vPortClearInterruptMask( UBaseType_t uxNewMaskValue );
+
+#define portENTER_CRITICAL()                      vPortEnterCritical()
+#define portEXIT_CRITICAL()                       vPortExitCritical()
+#define portDISABLE_INTERRUPTS()                  vPortDisableInterrupts()
+#define portENABLE_INTERRUPTS()                   vPortEnableInterrupts()
+#define portSET_INTERRUPT_MASK_FROM_ISR()         uxPortSetInterruptMask()
+#define portCLEAR_INTERRUPT_MASK_FROM_ISR( x )    vPortClearInterruptMask( x )
+
+/*-----------------------------------------------------------*/
+
+/* Task function macros as described on the FreeRTOS.org WEB site.  These are
+ * not required for this port but included in case common demo code that uses
+ * these macros is used. */
+#define portTASK_FUNCTION_PROTO( vFunction, pvParameters )    void vFunction( void * pvParameters )
+#define portTASK_FUNCTION( vFunction, pvParameters )          void vFunction( void * pvParameters )
+
+/* The thread of a deleted task is ended when the kernel frees its TCB. */
+extern void vPortCleanUpTCB( void * pxTCB );
+#define portCLEAN_UP_TCB( pxTCB )    vPortCleanUpTCB( pxTCB )
+
+/* A task is only switched out where it calls the kernel, so the idle task must
+ * call this from vApplicationIdleHook(), it sleeps until the next tick and then
+ * lets a task that the tick unblocked run. */
+extern void vPortWaitForTick( void );
+
+#define portNOP()
+#define portMEMORY_BARRIER()    __sync_synchronize()
+
+/* *INDENT-OFF* */
+#ifdef __cplusplus
+    } /* extern C */
+#endif
+/* *INDENT-ON* */
+
+#endif /* PORTMACRO_H */
@@ -0,0 +1,81 @@
+/*
+	MIT License
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+
+	Developer: Truong Hy
+	Version  : 20261017
+
+	The deferred logger task, which sends the records of LOG() to the console
+	UART, see tru_dlog.h.
+
+	It runs at the idle priority, so the wait on the UART only takes time that
+	no other task wants.  It polls the rings rather than being woken by LOG(),
+	so that a record costs the caller no FreeRTOS API call.
+*/
+
+// FreeRTOS includes
+#include "FreeRTOS.h"
+#include "task.h"
+
+// Other includes
+#include "freertos_static.h"
+#include "tru_logger.h"
+
+// Standard includes
+#include <stdbool.h>
+
+#if defined(TRU_LOG) && TRU_LOG == 1U && defined(TRU_LOG_DEFER) && TRU_LOG_DEFER == 1U
+
+#define LOG_TASK_PRIORITY tskIDLE_PRIORITY
+
+// How often the rings are checked, a ring holds TRU_DLOG_RING_LENGTH records
+// meanwhile
+#define LOG_TASK_RATE_MILLISEC 10U
+#define LOG_TASK_RATE_TICK     (LOG_TASK_RATE_MILLISEC / portTICK_PERIOD_MS)
+
+static void log_task(void *parameters);
+
+FREERTOS_STATIC_TASK_STORAGE(log, configMINIMAL_STACK_SIZE);
+
+static const freertos_static_task_t log_tasks[] = {
+	FREERTOS_STATIC_TASK_ENTRY(log, log_task, "L", configMINIMAL_STACK_SIZE, NULL, LOG_TASK_PRIORITY, NULL)
+};
+
+static void log_task(void *parameters){
+	// Suppress compiler unused parameter warning
+	(void)parameters;
+
+	for(;;){
+		tru_dlog_drain();
+		vTaskDelay(LOG_TASK_RATE_TICK);
+	}
+}
+
+bool log_setup(void){
+	return freertos_static_tasks_create(log_tasks, FREERTOS_STATIC_COUNT(log_tasks));
+}
+
+#else
+
+bool log_setup(void){
+	return true;
+}
+
+#endif
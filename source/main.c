@@ -89,6 +89,10 @@
 		- FreeRTOS/Source/portable/MemMang/heap_4.c   (copy entire folder and
 		                                               delete the other
 		                                               heap_[n].c files)
+
+	The host build, Makefile-host.mk, uses its own cooperative POSIX port,
+	source/host/freertos_posix.c, instead of the ARM_CA9 port, see
+	source/host/blinky_host.c.
 */
 
 // FreeRTOS includes
@@ -98,20 +102,53 @@
 // Intel HWLIB library includes
 #include "alt_interrupt.h"
 
+// Trulib includes
+#include "tru_pl011_ll.h"
+
+// Other includes
+#include "bench.h"
+
+extern bool log_setup(void);
+extern bool frame_setup(void);
 extern bool blinky_setup(void);
 
 static void c5soc_setup(void){
+#if defined(TRU_NEWLIB_REENTRANT) && TRU_NEWLIB_REENTRANT == 1U
+	// The mutexes of newlib's own locks, see freertos_newlib.c
+	vConfigureNewlibLocks();
+#endif
+
+#if(TRU_BOARD == TRU_BOARD_VEXPA9)
+	// The console UART, on the DE10-Nano it is set up by U-Boot
+	tru_pl011_ll_init((void *)TRU_BOARD_UART0_BASE);
+#endif
+
 	// Initialise the interrupt system (GIC)
 	alt_int_global_init();
 	alt_int_cpu_init();
 	alt_int_cpu_enable();
 	alt_int_global_enable();
 	//alt_int_cpu_binary_point_set(0);  // The default is already 0
+
+	// Interrupt driven console UART transmit, see tru_c5soc_hps_uart.h
+	vConfigureConsoleUART();
+
+	// Kernel trace recorder, see tru_trace.h
+	vConfigureTrace();
+
+	// Performance monitor counts per task, see tru_pmu.h
+	vConfigurePMU();
+
+	// PC sampling profiler, see tru_prof.h
+	vConfigureProfiler();
+
+	// High resolution timer service, see tru_hrtimer.h
+	vConfigureHRTimer();
 }
 
 int main(void){
 	c5soc_setup();
-	if(blinky_setup()){
+	if(log_setup() && frame_setup() && blinky_setup() && bench_setup()){
 		vTaskStartScheduler();  // Start the FreeRTOS preemptive scheduler
 	}
 
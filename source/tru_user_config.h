@@ -35,17 +35,38 @@
 // User config settings
 // ====================
 
+// The demo as it was, the optional subsystems added to it are off and each is
+// opted into by setting it to 1U
+
 #define TRU_CFG_TARGET                  TRU_TARGET_C5SOC
+#define TRU_CFG_BOARD                   TRU_BOARD_DE10NANO  // TRU_BOARD_VEXPA9 for QEMU, see tru_board.h
 #define TRU_CFG_CMSIS                   0U
 #define TRU_CFG_CMSIS_WEAK_IRQH         0U  // This is to support FreeRTOS with CMSIS, set to 1 when using FreeRTOS, else set to 0
 #define TRU_CFG_STARTUP                 1U
 #define TRU_CFG_EXIT_TO_UBOOT           0U
+#define TRU_CFG_SMP                     0U  // 1U runs FreeRTOS on both CPUs, without tickless idle or a newlib _reent per task, see FreeRTOSConfig.h
+#define TRU_CFG_TICKLESS                0U  // Tickless idle, the tick from the global timer comparator, single CPU only
+#define TRU_CFG_NEWLIB_REENTRANT        0U  // newlib locks of freertos_newlib.c, and on a single CPU a struct _reent in each TCB (about 1 KB each)
 #define TRU_CFG_NEON                    1U
 #define TRU_CFG_UNALIGNED_ACCESS        1U
 #define TRU_CFG_PRINT_UART0             1U
+#define TRU_CFG_UART_TX_IRQ             0U  // Buffered console UART transmit from its interrupt, see tru_c5soc_hps_uart.h
+#define TRU_CFG_UART_TX_DMA             0U  // Large console writes by the PL330 DMA, see tru_hps_uart_write_dma()
+#define TRU_CFG_UART_RX_IRQ             0U  // Console UART receive from its interrupt into a stream buffer, for _read()
+#define TRU_CFG_MALLOC_RTOS             0U  // malloc() from the FreeRTOS heap, see freertos_newlib.c
+#define TRU_CFG_FRAME                   0U  // Console output and commands in COBS frames, see tru_frame.h and frame_task.c
 #define TRU_CFG_LOG                     1U
 #define TRU_CFG_LOG_RN                  1U
 #define TRU_CFG_LOG_LOC                 0U
+#define TRU_CFG_LOG_DEFER               0U  // LOG() sends binary records from a low priority task, needs tru_dlog_decode.py, see tru_dlog.h
+#define TRU_CFG_LOG_FMT                 0U  // LOG_SYNC() formats with tru_fmt.h rather than newlib's fprintf()
+#define TRU_CFG_LOG_LEVEL               4U  // Levels above it are compiled out: 1 error, 2 warn, 3 info, 4 debug
+#define TRU_CFG_LOG_LEVEL_RUN           3U  // Threshold of every module at start, it can be changed at run time
+#define TRU_CFG_LOG_MODULES             8U  // Entries of the level table, see tru_logger.h
 #define TRU_CFG_DMA_BUFFER_NONCACHEABLE 0U
+#define TRU_CFG_TRACE                   0U  // Record kernel events, see tru_trace.h
+#define TRU_CFG_PMU                     0U  // Count PMU events per task, see tru_pmu.h
+#define TRU_CFG_PROF                    0U  // PC sampling profiler, see tru_prof.h
+#define TRU_CFG_HPS_SIM                 0U  // Fake HPS register blocks, Makefile-host.mk sets it for the host build
 
 #endif
@@ -0,0 +1,53 @@
+/*
+	MIT License
+
+	Copyright (c) 2025 Truong Hy
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+
+	Version: 20261017
+
+	Board selection.  Includes the header of the board set by TRU_BOARD, which
+	gives the addresses and clocks that differ between boards with the same
+	Cortex-A9 MPCore: the private memory region, the L2C-310 cache controller,
+	the RAM and the console UART.
+
+	Boards:
+		- TRU_BOARD_DE10NANO: Terasic DE10-Nano, Cyclone V SoC HPS
+		- TRU_BOARD_VEXPA9  : QEMU vexpress-a9 machine, see tru_board_vexpa9.h
+*/
+
+#ifndef TRU_BOARD_H
+#define TRU_BOARD_H
+
+#include "tru_config.h"
+
+#if(TRU_BOARD == TRU_BOARD_DE10NANO)
+	#include "tru_board_de10nano.h"
+#elif(TRU_BOARD == TRU_BOARD_VEXPA9)
+	#include "tru_board_vexpa9.h"
+#else
+	#error "TRU_BOARD define has an unsupported value!"
+#endif
+
+// The Cortex-A9 MPCore private memory region offsets are the same on all boards
+#define TRU_BOARD_GTIM_BASE     (TRU_BOARD_PERIPH_BASE + 0x0200UL)  // Global timer
+#define TRU_BOARD_GIC_DIST_BASE (TRU_BOARD_PERIPH_BASE + 0x1000UL)  // GIC distributor, the CPU interface is at +0x100
+
+#endif
@@ -0,0 +1,74 @@
+/*
+	MIT License
+
+	Copyright (c) 2025 Truong Hy
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+
+	Version: 20261017
+
+	Terasic DE10-Nano board, Cyclone V SoC HPS.
+
+	References:
+		- Cyclone V SoC: Cyclone V Hard Processor System Technical Reference Manual
+*/
+
+#ifndef TRU_BOARD_DE10NANO_H
+#define TRU_BOARD_DE10NANO_H
+
+#define TRU_BOARD_NAME "de10nano"
+
+#define TRU_BOARD_PERIPH_BASE 0xfffec000UL  // Cortex-A9 MPCore private memory region (SCU, GIC, timers).  Can also be read from the CBAR: MRC p15, 4, r0, c15, c0, 0
+#define TRU_BOARD_L2C310_BASE 0xfffef000UL  // L2C-310 cache controller
+
+// L2C-310 RAM latencies (vendor specific)
+#define TRU_BOARD_L2C310_TAGRAM_LATENCY  0x0U
+#define TRU_BOARD_L2C310_DATARAM_LATENCY 0x10U
+
+// DDR-3 SDRAM, the lower 1MB is remapped to it by U-Boot
+#define TRU_BOARD_RAM_BASE 0x00000000UL
+#define TRU_BOARD_RAM_SIZE 0x40000000UL
+
+// HPS UART0 and UART1 (Synopsys DW UART), see tru_c5soc_hps_uart_ll.h.  The
+// console is UART0.  With TRU_HPS_SIM they are faked by tru_c5soc_hps_sim.h
+#if !defined(TRU_HPS_SIM) || TRU_HPS_SIM == 0U
+	#define TRU_HPS_UART0_BASE 0xffc02000UL
+	#define TRU_HPS_UART1_BASE 0xffc03000UL
+#endif
+
+#include "alt_clock_manager.h"
+#include <stdint.h>
+
+// Processor clock, set up by U-Boot
+static inline uint32_t tru_board_cpu_clk_hz(void){
+	alt_freq_t freq;
+
+	alt_clk_freq_get(ALT_CLK_MPU, &freq);
+	return freq;
+}
+
+// Peripheral base clock of the global and private timers, 1/4 of the processor clock
+static inline uint32_t tru_board_periph_clk_hz(void){
+	alt_freq_t freq;
+
+	alt_clk_freq_get(ALT_CLK_MPU_PERIPH, &freq);
+	return freq;
+}
+
+#endif
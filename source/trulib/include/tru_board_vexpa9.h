@@ -0,0 +1,77 @@
+/*
+	MIT License
+
+	Copyright (c) 2025 Truong Hy
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+
+	Version: 20261017
+
+	QEMU vexpress-a9 machine, i.e. the Arm Versatile Express with a
+	CoreTile Express A9x4 daughterboard, in the legacy memory map.
+
+	Runs the same image logic as the DE10-Nano on any Linux machine, e.g. for
+	repeatable benchmark runs:
+		qemu-system-arm -M vexpress-a9 -smp 1 -m 1G -nographic -kernel <elf>
+
+	Limitations:
+		- the HPS peripherals do not exist: the blinky LED and key are not
+		  connected, the high resolution timer and the profiler are off
+		- one core only, TRU_SMP is set to 0, so the tick is the tickless
+		  global timer comparator
+		- the timings are of the emulator, not of the silicon
+
+	References:
+		- ARM DUI 0448: Motherboard Express uATX Technical Reference Manual
+		- ARM DUI 0449: CoreTile Express A9x4 Technical Reference Manual
+		- ARM DDI 0183: PrimeCell UART (PL011) Technical Reference Manual
+*/
+
+#ifndef TRU_BOARD_VEXPA9_H
+#define TRU_BOARD_VEXPA9_H
+
+#define TRU_BOARD_NAME "vexpa9"
+
+#define TRU_BOARD_PERIPH_BASE 0x1e000000UL  // Cortex-A9 MPCore private memory region (SCU, GIC, timers)
+#define TRU_BOARD_L2C310_BASE 0x1e00a000UL  // L2C-310 cache controller
+
+// L2C-310 RAM latencies, QEMU ignores them
+#define TRU_BOARD_L2C310_TAGRAM_LATENCY  0x0U
+#define TRU_BOARD_L2C310_DATARAM_LATENCY 0x0U
+
+// DDR2 on the daughterboard, QEMU -m 1G
+#define TRU_BOARD_RAM_BASE 0x60000000UL
+#define TRU_BOARD_RAM_SIZE 0x40000000UL
+
+// Console, motherboard UART0 (PL011), see tru_pl011_ll.h
+#define TRU_BOARD_UART0_BASE 0x10009000UL
+
+#include <stdint.h>
+
+// There is no clock manager.  QEMU counts the PMU cycle counter in nanoseconds,
+// i.e. at 1GHz, and clocks the global and private timers at 100MHz
+static inline uint32_t tru_board_cpu_clk_hz(void){
+	return 1000000000UL;
+}
+
+static inline uint32_t tru_board_periph_clk_hz(void){
+	return 100000000UL;
+}
+
+#endif
@@ -50,10 +50,12 @@
 // Hardware registers
 // ==================
 
-// Hardware HPS GPIO module registers
-#define TRU_HPS_GPIO0_BASE 0xff708000UL
-#define TRU_HPS_GPIO1_BASE 0xff709000UL
-#define TRU_HPS_GPIO2_BASE 0xff70a000UL
+// Hardware HPS GPIO module registers, unless faked by tru_c5soc_hps_sim.h
+#ifndef TRU_HPS_GPIO0_BASE
+	#define TRU_HPS_GPIO0_BASE 0xff708000UL
+	#define TRU_HPS_GPIO1_BASE 0xff709000UL
+	#define TRU_HPS_GPIO2_BASE 0xff70a000UL
+#endif
 
 #define TRU_HPS_GPIO0_FIRST_PINNUM 0
 #define TRU_HPS_GPIO1_FIRST_PINNUM 29
@@ -33,10 +33,20 @@
 
 #if(TRU_TARGET == TRU_TARGET_C5SOC)
 
+#include "tru_c5soc_hps_sim.h"
 #include <stdint.h>
 
 // Reset Manager Register
-#define TRU_HPS_RSTMGR_BASE 0xffd05000UL
+#ifndef TRU_HPS_RSTMGR_BASE
+	#define TRU_HPS_RSTMGR_BASE 0xffd05000UL
+#endif
+
+// MPU Module Reset Register
+#define TRU_HPS_RSTMGR_MPUMODRST              (TRU_HPS_RSTMGR_BASE + 0x10U)
+#define TRU_HPS_RSTMGR_MPUMODRST_CPU0_POS     0U
+#define TRU_HPS_RSTMGR_MPUMODRST_CPU1_POS     1U
+#define TRU_HPS_RSTMGR_MPUMODRST_CPU0_SET_MSK (1U << TRU_HPS_RSTMGR_MPUMODRST_CPU0_POS)
+#define TRU_HPS_RSTMGR_MPUMODRST_CPU1_SET_MSK (1U << TRU_HPS_RSTMGR_MPUMODRST_CPU1_POS)
 
 // Peripheral Module Reset Register
 #define TRU_HPS_RSTMGR_PERMODRST               (TRU_HPS_RSTMGR_BASE + 0x14U)
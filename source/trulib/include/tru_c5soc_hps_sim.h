@@ -0,0 +1,68 @@
+/*
+	MIT License
+
+	Copyright (c) 2025 Truong Hy
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+
+	Version: 20261017
+
+	Fake Cyclone V SoC HPS register blocks, for building the HPS low-level code
+	on a host where the peripheral addresses do not exist.
+
+	With TRU_HPS_SIM set to 1 the Reset Manager, GPIO and UART base addresses
+	of the low-level headers point at the RAM blocks below instead, so code
+	that uses them, e.g. blinky_gpio.c and the UART logger, builds and runs
+	unmodified.  The blocks are plain memory: a write stays there, and a read
+	gives the last write or what the test put there.  tru_hps_sim_init() sets
+	the reset values that the low-level code waits on, e.g. the UART line
+	status says the transmitter is empty.
+
+	The host build (Makefile-host.mk) uses them to run the blinky tasks on its
+	POSIX port, which provides the tick instead of the Cortex-A9 private timer,
+	see source/host/blinky_host.c.
+*/
+
+#ifndef TRU_C5SOC_HPS_SIM_H
+#define TRU_C5SOC_HPS_SIM_H
+
+#include "tru_config.h"
+
+#if defined(TRU_HPS_SIM) && TRU_HPS_SIM == 1U
+
+#include <stdint.h>
+
+#define TRU_HPS_SIM_BLOCK_WORDS 64U  // 256 bytes, covers the registers used
+
+extern volatile uint32_t tru_hps_sim_rstmgr[TRU_HPS_SIM_BLOCK_WORDS];
+extern volatile uint32_t tru_hps_sim_gpio[3][TRU_HPS_SIM_BLOCK_WORDS];
+extern volatile uint32_t tru_hps_sim_uart[2][TRU_HPS_SIM_BLOCK_WORDS];
+
+#define TRU_HPS_RSTMGR_BASE ((uintptr_t)tru_hps_sim_rstmgr)
+#define TRU_HPS_GPIO0_BASE  ((uintptr_t)tru_hps_sim_gpio[0])
+#define TRU_HPS_GPIO1_BASE  ((uintptr_t)tru_hps_sim_gpio[1])
+#define TRU_HPS_GPIO2_BASE  ((uintptr_t)tru_hps_sim_gpio[2])
+#define TRU_HPS_UART0_BASE  ((uintptr_t)tru_hps_sim_uart[0])
+#define TRU_HPS_UART1_BASE  ((uintptr_t)tru_hps_sim_uart[1])
+
+void tru_hps_sim_init(void);
+
+#endif
+
+#endif
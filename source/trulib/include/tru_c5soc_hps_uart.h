@@ -0,0 +1,171 @@
+/*
+	MIT License
+
+	Copyright (c) 2025 Truong Hy
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+
+	Version: 20261017
+
+	Interrupt driven driver for the Cyclone V SoC HPS UART.
+*/
+
+#ifndef TRU_C5SOC_HPS_UART_H
+#define TRU_C5SOC_HPS_UART_H
+
+#include "tru_config.h"
+
+#if(TRU_TARGET == TRU_TARGET_C5SOC)
+
+#include "tru_c5soc_hps_uart_ll.h"
+#include "tru_lock.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+#if defined(TRU_UART_TX_DMA) && TRU_UART_TX_DMA == 1U
+	#include "alt_dma.h"
+	#include "alt_16550_uart.h"
+#endif
+
+// Writers copy bytes into a RAM ring and return, the transmit holding register
+// empty (THRE) interrupt moves them into the 128 byte FIFO.  The FIFO is used
+// in programmable THRE mode, so the interrupt comes when the FIFO drains to a
+// quarter full and there is room for 96 bytes, not once per byte.  The
+// interrupt is enabled only while the ring has bytes in it.
+//
+// The driver doesn't depend on an RTOS.  A writer that finds the ring full
+// either returns with what it has queued or calls the wait function, which the
+// interrupt handler ends by calling the wake function once the ring is half
+// empty, e.g. a semaphore take and give.  Without a wait function, or when the
+// wait function returns straight away, e.g. before the scheduler is started,
+// the writer moves bytes to the FIFO itself by polling
+//
+// With TRU_UART_TX_DMA a large buffer can instead be handed to a PL330 DMA
+// channel, see tru_hps_uart_write_dma()
+//
+// Receive is optional, see tru_hps_uart_rx_init().  The receive data available
+// interrupt comes when the RX FIFO is a quarter full and the character timeout
+// interrupt when fewer bytes have sat in it for 4 character times.  Either way
+// the handler empties the FIFO and passes the bytes to the rx function, e.g. a
+// stream buffer send.  The driver keeps no receive buffer of its own, readers
+// call the read function, e.g. a stream buffer receive.  At 921600 baud the
+// FIFO has room for another 96 bytes, about 1ms, after the interrupt is raised
+typedef struct tru_hps_uart_s tru_hps_uart_t;
+
+typedef void (*tru_hps_uart_callback_t)(tru_hps_uart_t *uart);
+
+// Returns the number of bytes taken
+typedef uint32_t (*tru_hps_uart_rx_callback_t)(tru_hps_uart_t *uart, const uint8_t *buf, uint32_t len);
+typedef uint32_t (*tru_hps_uart_read_callback_t)(tru_hps_uart_t *uart, uint8_t *buf, uint32_t len);
+
+typedef enum{
+	TRU_HPS_UART_NOWAIT,  // Queue what fits and return
+	TRU_HPS_UART_WAIT     // Return when all of it is queued
+}tru_hps_uart_wait_t;
+
+struct tru_hps_uart_s{
+	volatile tru_hps_uart_reg_t *reg;
+	uint8_t *buf;
+	uint32_t mask;
+	uint32_t head;                   // Written by the writers
+	uint32_t tail;                   // Written by the interrupt handler
+	uint32_t waiters;
+	tru_spinlock_t lock;
+	tru_hps_uart_callback_t wait;    // Called by a writer, NULL to poll
+	tru_hps_uart_callback_t wake;    // Called by the interrupt handler
+	void *context;                   // Free for the callback functions
+	tru_hps_uart_rx_callback_t rx;   // Called by the interrupt handler with received bytes, NULL without receive
+	tru_hps_uart_read_callback_t read;  // Called by _read() for the console
+	tru_spinlock_t rx_lock;
+	uint32_t rx_overruns;            // Times bytes were lost in the FIFO, the handler was too late
+	uint32_t rx_dropped;             // Bytes not taken by the rx function
+#if defined(TRU_UART_TX_DMA) && TRU_UART_TX_DMA == 1U
+	ALT_DMA_PROGRAM_t program;
+	ALT_16550_HANDLE_t handle;       // Only the location and FCR are read by alt_dma.c
+	ALT_DMA_CHANNEL_t channel;
+	ALT_DMA_EVENT_t event;
+	ALT_DMA_PERIPH_t periph;
+	volatile uint32_t dma_busy;      // The FIFO belongs to the DMA, the ring is held back
+	tru_hps_uart_callback_t dma_wait;  // Called by the writer after starting a transfer, NULL to poll
+	tru_hps_uart_callback_t dma_done;  // Called by the DMA interrupt handler
+#endif
+};
+
+// The console UART, NULL until the application sets it.  When set _write()
+// writes to it, and _read() reads from it if it has a read function, see
+// tru_newlib_ext.c
+extern tru_hps_uart_t *tru_hps_uart_console;
+
+// buf holds size bytes, size must be a power of 2.  Enables the FIFO in
+// programmable THRE mode, the line settings are left as they are.  The
+// application then registers tru_hps_uart_isr() as the handler of the UART
+// interrupt, with the driver as its context, and enables it
+void tru_hps_uart_init(tru_hps_uart_t *uart, void *uart_base, uint8_t *buf, uint32_t size, tru_hps_uart_callback_t wait, tru_hps_uart_callback_t wake, void *context);
+void tru_hps_uart_isr(uint32_t icciar, void *context);
+
+// Returns the number of bytes queued, which is len with TRU_HPS_UART_WAIT
+uint32_t tru_hps_uart_write(tru_hps_uart_t *uart, const uint8_t *buf, uint32_t len, tru_hps_uart_wait_t wait);
+
+// Moves bytes from the ring to the FIFO, as the interrupt handler does.  For a
+// writer that cannot wait, e.g. with interrupts disabled
+void tru_hps_uart_poll(tru_hps_uart_t *uart);
+
+// Polls until the ring is empty and the FIFO has gone out
+void tru_hps_uart_flush(tru_hps_uart_t *uart);
+
+#if defined(TRU_UART_TX_DMA) && TRU_UART_TX_DMA == 1U
+
+// Transfers are split into programs of this many bytes
+#define TRU_HPS_UART_DMA_CHUNK 65536U
+
+// Sets up DMA transmit on an initialised driver.  The application has called
+// alt_dma_init() and allocated the channel, and routes the event to its
+// interrupt with alt_dma_event_int_select().  It then registers
+// tru_hps_uart_dma_isr() as the handler of that interrupt, with the driver as
+// its context, and enables it
+void tru_hps_uart_dma_init(tru_hps_uart_t *uart, ALT_DMA_CHANNEL_t channel, ALT_DMA_EVENT_t event, tru_hps_uart_callback_t dma_wait, tru_hps_uart_callback_t dma_done);
+void tru_hps_uart_dma_isr(uint32_t icciar, void *context);
+
+// Sends a buffer with the DMA in bursts of 96 bytes, paced by the UART DMA
+// handshake, and returns when it has been read.  Bytes already in the ring go
+// out first, bytes queued by other writers meanwhile wait in the ring until
+// the end.  The buffer is cleaned from the caches here.  Only one DMA writer at
+// a time.  Returns false if the DMA failed
+bool tru_hps_uart_write_dma(tru_hps_uart_t *uart, const void *buf, uint32_t len);
+
+#endif
+
+// Enables receive on an initialised driver.  The interrupt handler gives the
+// received bytes to rx, read is what the console _read() calls, it may block
+// and returns at least 1 byte
+void tru_hps_uart_rx_init(tru_hps_uart_t *uart, tru_hps_uart_rx_callback_t rx, tru_hps_uart_read_callback_t read);
+
+// Empties the RX FIFO to the rx function, as the interrupt handler does.  For
+// a reader that cannot wait, e.g. with interrupts disabled
+void tru_hps_uart_rx_poll(tru_hps_uart_t *uart);
+
+// Flushes and puts the UART back in the polled mode that U-Boot and the
+// tru_hps_uart_ll functions expect: no UART interrupts and no programmable THRE
+// mode.  If it is the console _write() goes back to polling and _read() to
+// failing
+void tru_hps_uart_stop(tru_hps_uart_t *uart);
+
+#endif
+
+#endif
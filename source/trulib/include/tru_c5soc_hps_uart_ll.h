@@ -33,6 +33,8 @@
 
 #if(TRU_TARGET == TRU_TARGET_C5SOC)
 
+#include "tru_c5soc_hps_sim.h"
+#include "tru_board.h"
 #include "tru_util_ll.h"
 #include <stdint.h>
 
@@ -47,16 +49,31 @@
 #define TRU_HPS_UART_STET_OFFSET        0xa0U
 #define TRU_HPS_UART_LSR_TEMT_SET_MSK   0x00000040UL
 #define TRU_HPS_UART_LSR_THRE_SET_MSK   0x00000020UL
+#define TRU_HPS_UART_LSR_OE_SET_MSK     0x00000002UL  // Overrun error, a received byte was lost
+#define TRU_HPS_UART_IER_ERBFI_SET_MSK  0x00000001UL  // Received data available and character timeout interrupts
+#define TRU_HPS_UART_IER_ETBEI_SET_MSK  0x00000002UL  // Transmit holding register empty interrupt
+#define TRU_HPS_UART_IER_ELSI_SET_MSK   0x00000004UL  // Receiver line status interrupt
+#define TRU_HPS_UART_IER_PTIME_SET_MSK  0x00000080UL  // Programmable THRE interrupt mode, at the FIFO threshold
+#define TRU_HPS_UART_IIR_IID_MSK        0x0000000fUL
+#define TRU_HPS_UART_IIR_IID_THRE       0x00000002UL
+#define TRU_HPS_UART_IIR_IID_RLS        0x00000006UL  // Receiver line status, cleared by reading LSR
+#define TRU_HPS_UART_IIR_IID_BUSY       0x00000007UL  // Busy detect, cleared by reading USR
+#define TRU_HPS_UART_FCR_FIFOE_SET_MSK  0x00000001UL
+#define TRU_HPS_UART_FCR_DMAM_SET_MSK   0x00000008UL  // DMA mode 1, requests a burst at the FIFO threshold
+#define TRU_HPS_UART_FCR_TET_QUARTER    0x00000020UL  // Transmit empty trigger at a quarter full
+#define TRU_HPS_UART_FCR_RT_QUARTER     0x00000040UL  // Receive trigger at a quarter full
+#define TRU_HPS_UART_FIFO_DEPTH         128U
+
+// The HPS UART base addresses, TRU_HPS_UART0_BASE and TRU_HPS_UART1_BASE, are
+// in the board header, see tru_board_de10nano.h
 
 // HPS UART0 registers
-#define TRU_HPS_UART0_BASE              0xffc02000UL
 #define TRU_HPS_UART0_RBR_THR_DLL_ADDR  (TRU_HPS_UART0_BASE + TRU_HPS_UART_RBR_THR_DLL_OFFSET)
 #define TRU_HPS_UART0_LSR_ADDR          (TRU_HPS_UART0_BASE + TRU_HPS_UART_LSR_OFFSET)
 #define TRU_HPS_UART0_SFE_ADDR          (TRU_HPS_UART0_BASE + TRU_HPS_UART_SFE_OFFSET)
 #define TRU_HPS_UART0_STET_ADDR         (TRU_HPS_UART0_BASE + TRU_HPS_UART_STET_OFFSET)
 
 // HPS UART1 registers
-#define TRU_HPS_UART1_BASE              0xffc03000UL
 #define TRU_HPS_UART1_RBR_THR_DLL_ADDR  (TRU_HPS_UART1_BASE + TRU_HPS_UART_RBR_THR_DLL_OFFSET)
 #define TRU_HPS_UART1_LSR_ADDR          (TRU_HPS_UART1_BASE + TRU_HPS_UART_LSR_OFFSET)
 #define TRU_HPS_UART1_SFE_ADDR          (TRU_HPS_UART1_BASE + TRU_HPS_UART_SFE_OFFSET)
@@ -103,6 +120,7 @@ typedef struct{
 
 void tru_hps_uart_ll_wait_empty(void *uart_base);
 void tru_hps_uart_ll_write_str(void *uart_base, const char *str, uint32_t len);
+void tru_hps_uart_ll_write_bin(void *uart_base, const uint8_t *buf, uint32_t len);
 void tru_hps_uart_ll_write_char(void *uart_base, const char c);
 void tru_hps_uart_ll_write_hex_nibble(void *uart_base, unsigned char nibble);
 void tru_hps_uart_ll_write_inthex(void *uart_base, int num, unsigned int bits);
@@ -164,6 +164,14 @@ static inline bool tru_l2_is_enabled(void){
 }
 #endif
 
+#if defined(TRU_CMSIS) && TRU_CMSIS == 0U
+// Waits until the L2 operations are done, the same as alt_cache_l2_sync() but at the board address of the L2C-310
+static inline void tru_l2_sync(void){
+	tru_iom_wr32((uint32_t *)(L2C310_BASE + L2C310_CACHE_SYNC_OFFSET), 0U);
+	while(tru_iom_rd32((uint32_t *)(L2C310_BASE + L2C310_CACHE_SYNC_OFFSET)) & 0x1U);
+}
+#endif
+
 #if defined(TRU_CMSIS) && TRU_CMSIS == 1U
 static inline void tru_l2_data_clean_range(void *buf, uint32_t len){
 	uint32_t limit = (uint32_t)buf + len;
@@ -185,7 +193,7 @@ static inline void tru_l2_data_clean_range(void *buf, uint32_t len){
 		tru_iom_wr32((uint32_t *)(L2C310_BASE + L2C310_CACHE_SYNC_OFFSET), 0U);
 		addr += CACHELINE_SIZE;  // Increment index
 	}
-	alt_cache_l2_sync();
+	tru_l2_sync();
 	__dsb();
 }
 #endif
@@ -211,7 +219,7 @@ static inline void tru_l2_data_inv_range(void *buf, uint32_t len){
 		tru_iom_wr32((uint32_t *)(L2C310_BASE + L2C310_CACHE_SYNC_OFFSET), 0U);
 		addr += CACHELINE_SIZE;  // Increment index
 	}
-	alt_cache_l2_sync();
+	tru_l2_sync();
 	__dsb();
 }
 #endif
@@ -237,7 +245,7 @@ static inline void tru_l2_data_cleaninv_range(void *buf, uint32_t len){
 		tru_iom_wr32((uint32_t *)(L2C310_BASE + L2C310_CACHE_SYNC_OFFSET), 0U);
 		addr += CACHELINE_SIZE;  // Increment index
 	}
-	alt_cache_l2_sync();
+	tru_l2_sync();
 	__dsb();
 }
 #endif
@@ -33,7 +33,9 @@
 
 #if(TRU_TARGET == TRU_TARGET_C5SOC)
 
-#define L2C310_BASE                 0xfffef000UL
+#include "tru_board.h"
+
+#define L2C310_BASE                 TRU_BOARD_L2C310_BASE
 #define L2C310_CTRL_OFFSET          0x100U
 #define L2C310_AUX_CTRL_OFFSET      0x104U
 #define L2C310_TAGRAM_OFFSET        0x108U
@@ -49,9 +51,9 @@
 
 #define L2C310_CACHELINE_SIZE 32U
 
-// Cyclone V SoC latency (vendor specific)
-#define L2C310_TAGRAM_LATENCY  0x0U
-#define L2C310_DATARAM_LATENCY 0x10U
+// Latency (vendor specific)
+#define L2C310_TAGRAM_LATENCY  TRU_BOARD_L2C310_TAGRAM_LATENCY
+#define L2C310_DATARAM_LATENCY TRU_BOARD_L2C310_DATARAM_LATENCY
 
 #endif
 
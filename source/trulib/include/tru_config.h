@@ -75,6 +75,17 @@
 	#endif
 #endif
 
+// Board of the C5SOC target, see tru_board.h.  The QEMU vexpress-a9 machine has the same Cortex-A9 MPCore, GIC and L2C-310 at other addresses
+#if(TRU_TARGET == TRU_TARGET_C5SOC)
+	#ifndef TRU_BOARD
+		#if defined(TRU_CFG_BOARD)
+			#define TRU_BOARD TRU_CFG_BOARD
+		#else
+			#define TRU_BOARD TRU_BOARD_DE10NANO
+		#endif
+	#endif
+#endif
+
 // Use CMSIS for startup and CPU stuff
 #if !defined(TRU_CMSIS) && defined(TRU_CFG_CMSIS)
 	#define TRU_CMSIS TRU_CFG_CMSIS
@@ -94,6 +105,26 @@
 	#define TRU_EXIT_TO_UBOOT TRU_CFG_EXIT_TO_UBOOT
 #endif
 
+// Run on both CPUs (SMP), CPU1 is started with tru_smp_cpu1_start().  Not supported with exit to U-Boot or on the QEMU vexpress-a9 (CPU1 is released by the Cyclone V Reset Manager), so it is turned off
+#if !defined(TRU_SMP) && defined(TRU_CFG_SMP)
+	#if defined(TRU_EXIT_TO_UBOOT) && TRU_EXIT_TO_UBOOT == 1U
+		#define TRU_SMP 0U
+	#elif defined(TRU_BOARD) && TRU_BOARD == TRU_BOARD_VEXPA9
+		#define TRU_SMP 0U
+	#else
+		#define TRU_SMP TRU_CFG_SMP
+	#endif
+#endif
+
+// Tickless idle, see FreeRTOSConfig.h.  Not supported with SMP, so it is turned off
+#if !defined(TRU_TICKLESS) && defined(TRU_CFG_TICKLESS)
+	#if defined(TRU_SMP) && TRU_SMP == 1U
+		#define TRU_TICKLESS 0U
+	#else
+		#define TRU_TICKLESS TRU_CFG_TICKLESS
+	#endif
+#endif
+
 #ifdef SEMIHOSTING
 	#define TRU_PRINT_UART0 0U
 	#define TRU_PRINT_UART1 0U
@@ -105,6 +136,52 @@
 	#define TRU_PRINT_UART1 TRU_CFG_PRINT_UART1
 #endif
 
+// Interrupt driven console UART transmit, see tru_c5soc_hps_uart.h.  The QEMU vexpress-a9 console is a PL011, which stays polled, so it is turned off
+#if !defined(TRU_UART_TX_IRQ) && defined(TRU_CFG_UART_TX_IRQ)
+	#if defined(TRU_BOARD) && TRU_BOARD == TRU_BOARD_VEXPA9
+		#define TRU_UART_TX_IRQ 0U
+	#else
+		#define TRU_UART_TX_IRQ TRU_CFG_UART_TX_IRQ
+	#endif
+#endif
+
+// PL330 DMA transmit for the interrupt driven console UART, see tru_c5soc_hps_uart.h
+#if !defined(TRU_UART_TX_DMA) && defined(TRU_CFG_UART_TX_DMA)
+	#if defined(TRU_UART_TX_IRQ) && TRU_UART_TX_IRQ == 1U
+		#define TRU_UART_TX_DMA TRU_CFG_UART_TX_DMA
+	#else
+		#define TRU_UART_TX_DMA 0U
+	#endif
+#endif
+
+// Interrupt driven console UART receive, it uses the driver set up for transmit
+#if !defined(TRU_UART_RX_IRQ) && defined(TRU_CFG_UART_RX_IRQ)
+	#if defined(TRU_UART_TX_IRQ) && TRU_UART_TX_IRQ == 1U
+		#define TRU_UART_RX_IRQ TRU_CFG_UART_RX_IRQ
+	#else
+		#define TRU_UART_RX_IRQ 0U
+	#endif
+#endif
+
+// Framed transport on the console UART, it needs the interrupt driven receive
+// for the commands
+#if !defined(TRU_FRAME) && defined(TRU_CFG_FRAME)
+	#if defined(TRU_UART_RX_IRQ) && TRU_UART_RX_IRQ == 1U
+		#define TRU_FRAME TRU_CFG_FRAME
+	#else
+		#define TRU_FRAME 0U
+	#endif
+#endif
+
+// newlib's malloc() from the FreeRTOS heap, so there is one heap
+#if !defined(TRU_MALLOC_RTOS) && defined(TRU_CFG_MALLOC_RTOS)
+	#define TRU_MALLOC_RTOS TRU_CFG_MALLOC_RTOS
+#endif
+
+#if !defined(TRU_NEWLIB_REENTRANT) && defined(TRU_CFG_NEWLIB_REENTRANT)
+	#define TRU_NEWLIB_REENTRANT TRU_CFG_NEWLIB_REENTRANT
+#endif
+
 #if !defined(TRU_LOG) && defined(TRU_CFG_LOG)
 	#define TRU_LOG TRU_CFG_LOG
 #endif
@@ -118,11 +195,59 @@
 	#define TRU_LOG_LOC TRU_CFG_LOG_LOC
 #endif
 
+// 1U == LOG() records to the deferred binary logger, see tru_dlog.h
+#if !defined(TRU_LOG_DEFER) && defined(TRU_CFG_LOG_DEFER)
+	#define TRU_LOG_DEFER TRU_CFG_LOG_DEFER
+#endif
+
+// 1U == LOG_SYNC() formats with tru_fmt.h, 0U == with newlib's fprintf()
+#if !defined(TRU_LOG_FMT) && defined(TRU_CFG_LOG_FMT)
+	#define TRU_LOG_FMT TRU_CFG_LOG_FMT
+#endif
+
+// Levels above TRU_LOG_LEVEL are compiled out of LOG_ERROR() etc., see
+// tru_logger.h.  TRU_LOG_LEVEL_RUN is the threshold of every module at start
+#if !defined(TRU_LOG_LEVEL) && defined(TRU_CFG_LOG_LEVEL)
+	#define TRU_LOG_LEVEL TRU_CFG_LOG_LEVEL
+#endif
+
+#if !defined(TRU_LOG_LEVEL_RUN) && defined(TRU_CFG_LOG_LEVEL_RUN)
+	#define TRU_LOG_LEVEL_RUN TRU_CFG_LOG_LEVEL_RUN
+#endif
+
+#if !defined(TRU_LOG_MODULES) && defined(TRU_CFG_LOG_MODULES)
+	#define TRU_LOG_MODULES TRU_CFG_LOG_MODULES
+#endif
+
 // Tells this library to use non-cacheable memory region for DMA buffers
 #if !defined(TRU_DMA_BUFFER_NONCACHEABLE) && defined(TRU_CFG_DMA_BUFFER_NONCACHEABLE)
 	#define TRU_DMA_BUFFER_NONCACHEABLE TRU_CFG_DMA_BUFFER_NONCACHEABLE
 #endif
 
+// Binary event trace recorder, see tru_trace.h
+#if !defined(TRU_TRACE) && defined(TRU_CFG_TRACE)
+	#define TRU_TRACE TRU_CFG_TRACE
+#endif
+
+// Performance monitor counts per task, see tru_pmu.h
+#if !defined(TRU_PMU) && defined(TRU_CFG_PMU)
+	#define TRU_PMU TRU_CFG_PMU
+#endif
+
+// Statistical PC sampling profiler, see tru_prof.h.  It needs the Cyclone V Reset Manager, so it is turned off on the QEMU vexpress-a9
+#if !defined(TRU_PROF) && defined(TRU_CFG_PROF)
+	#if defined(TRU_BOARD) && TRU_BOARD == TRU_BOARD_VEXPA9
+		#define TRU_PROF 0U
+	#else
+		#define TRU_PROF TRU_CFG_PROF
+	#endif
+#endif
+
+// Fake HPS register blocks for a host build, see tru_c5soc_hps_sim.h
+#if !defined(TRU_HPS_SIM) && defined(TRU_CFG_HPS_SIM)
+	#define TRU_HPS_SIM TRU_CFG_HPS_SIM
+#endif
+
 #if !defined(TRU_USB_LOG_INIT) && defined(TRU_CFG_USB_LOG_INIT)
 	#define TRU_USB_LOG_INIT TRU_CFG_USB_LOG_INIT
 #endif
@@ -270,6 +395,8 @@
 		#if defined(TRU_SMP_COHERENCY_PRESENT) && TRU_SMP_COHERENCY_PRESENT == 1U
 			#if !defined(TRU_SMP_COHERENCY) && defined(TRU_CFG_SMP_COHERENCY)
 				#define TRU_SMP_COHERENCY TRU_CFG_SMP_COHERENCY
+			#elif defined(TRU_SMP) && TRU_SMP == 1U
+				#define TRU_SMP_COHERENCY 1U  // Needed by SMP
 			#else
 				#define TRU_SMP_COHERENCY 0U
 			#endif
@@ -277,6 +404,8 @@
 		#if defined(TRU_L1_CACHE_PRESENT) && TRU_L1_CACHE_PRESENT == 1U
 			#if !defined(TRU_L1_CACHE) && defined(TRU_CFG_L1_CACHE)
 				#define TRU_L1_CACHE TRU_CFG_L1_CACHE
+			#elif defined(TRU_SMP) && TRU_SMP == 1U
+				#define TRU_L1_CACHE 1U  // Needed by SMP
 			#else
 				#define TRU_L1_CACHE 0U
 			#endif
@@ -291,6 +420,8 @@
 		#if defined(TRU_SCU_PRESENT) && TRU_SCU_PRESENT == 1U
 			#if !defined(TRU_SCU) && defined(TRU_CFG_SCU)
 				#define TRU_SCU TRU_CFG_SCU
+			#elif defined(TRU_SMP) && TRU_SMP == 1U
+				#define TRU_SCU 1U  // Needed by SMP
 			#else
 				#define TRU_SCU 0U
 			#endif
@@ -341,6 +472,16 @@
 	#endif
 #endif
 
+// SMP needs the CPUs to be cache coherent for the shared data and the LDREX/STREX spinlocks, and CPU1 startup is in tru_startup.c
+#if defined(TRU_SMP) && TRU_SMP == 1U
+	#if !defined(TRU_STARTUP) || TRU_STARTUP != 1U
+		#error "TRU_SMP requires TRU_STARTUP set to 1"
+	#endif
+	#if TRU_MMU != 1U || TRU_L1_CACHE != 1U || TRU_SCU != 1U || TRU_SMP_COHERENCY != 1U
+		#error "TRU_SMP requires TRU_MMU, TRU_L1_CACHE, TRU_SCU and TRU_SMP_COHERENCY set to 1"
+	#endif
+#endif
+
 // This should match with your compiler/linker flag
 #if defined(TRU_NEON_PRESENT) && TRU_NEON_PRESENT == 1U
 	#if !defined(TRU_NEON) && defined(TRU_CFG_NEON)
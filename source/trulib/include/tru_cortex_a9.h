@@ -33,10 +33,12 @@
 
 #if(TRU_CPU_FAMILY == TRU_CPU_FAMILY_CORTEXA9)
 
+#include "tru_board.h"
 #include <stdint.h>
+#include <stdbool.h>
 
-#define TRU_PERIPH_BASE       0xfffec000UL
-#define TRU_GLOBAL_TIMER_BASE (TRU_PERIPH_BASE + 0x0200U)
+#define TRU_PERIPH_BASE       TRU_BOARD_PERIPH_BASE
+#define TRU_GLOBAL_TIMER_BASE TRU_BOARD_GTIM_BASE
 
 // GCC inline assembly macros
 //===========================
@@ -59,16 +61,33 @@
 #define __read_ccsidr(result) __asm__ volatile("MRC p15, 1, %0, c0, c0, 0" : "=r" (result) : : "memory")
 #define __read_clidr(result)  __asm__ volatile("MRC p15, 1, %0, c0, c0, 1" : "=r" (result) : : "memory")
 #define __read_mpidr(mpidr)   __asm__ volatile("MRC p15, 0, %0, c0, c0, 5" : "=r" (mpidr) : : "memory")
+#define __read_vbar(result)   __asm__ volatile("MRC p15, 0, %0, c12, c0, 0" : "=r" (result) : : "memory")
 
 // MMU related
 #define __write_tlbimvaa(va)  __asm__ volatile("MRC p15, 0, %0, c8, c7, 3" : : "r" (va) : "memory")
 
+// Performance monitor (PMU) related, see tru_pmu.h
+#define __read_pmcr(result)        __asm__ volatile("MRC p15, 0, %0, c9, c12, 0" : "=r" (result) : : "memory")
+#define __write_pmcr(value)        __asm__ volatile("MCR p15, 0, %0, c9, c12, 0" : : "r" (value) : "memory")
+#define __write_pmcntenset(mask)   __asm__ volatile("MCR p15, 0, %0, c9, c12, 1" : : "r" (mask) : "memory")
+#define __write_pmcntenclr(mask)   __asm__ volatile("MCR p15, 0, %0, c9, c12, 2" : : "r" (mask) : "memory")
+#define __read_pmovsr(result)      __asm__ volatile("MRC p15, 0, %0, c9, c12, 3" : "=r" (result) : : "memory")
+#define __write_pmovsr(mask)       __asm__ volatile("MCR p15, 0, %0, c9, c12, 3" : : "r" (mask) : "memory")
+#define __write_pmselr(index)      __asm__ volatile("MCR p15, 0, %0, c9, c12, 5" : : "r" (index) : "memory")
+#define __read_pmccntr(result)     __asm__ volatile("MRC p15, 0, %0, c9, c13, 0" : "=r" (result) : : "memory")
+#define __write_pmxevtyper(event)  __asm__ volatile("MCR p15, 0, %0, c9, c13, 1" : : "r" (event) : "memory")
+#define __read_pmxevcntr(result)   __asm__ volatile("MRC p15, 0, %0, c9, c13, 2" : "=r" (result) : : "memory")
+#define __write_pmintenclr(mask)   __asm__ volatile("MCR p15, 0, %0, c9, c14, 2" : : "r" (mask) : "memory")
+#define __read_sder(result)        __asm__ volatile("MRC p15, 0, %0, c1, c1, 1" : "=r" (result) : : "memory")
+#define __write_sder(value)        __asm__ volatile("MCR p15, 0, %0, c1, c1, 1" : : "r" (value) : "memory")
+
 // Global timer
 // ============
 
 // The clock source of the global and private timer is the peripheral base clock
 // The peripheral base clock is 1/4 of the processor clock
 // On the DE10-Nano processor, U-Boot (Quartus Prime handoff files) normally sets the clock up for 800MHz so the peripheral base clock is 800/4 = 200MHz
+// On the QEMU vexpress-a9 it is fixed at 100MHz, see tru_board_vexpa9.h
 
 typedef struct{
   volatile uint32_t counterl;
@@ -137,6 +156,58 @@ static inline void gtim_set_counter(uint64_t counter){
 	GTIM_REG->counterh = (uint32_t)(counter >> 32U);
 }
 
+static inline uint32_t gtim_get_prescaler(void){
+	return (GTIM_REG->control & GTIM_CONTROL_PRESCALER_MSK) >> GTIM_CONTROL_PRESCALER_POS;
+}
+
+static inline void gtim_compare_enable(void){
+	GTIM_REG->control |= GTIM_CONTROL_COMPARE_ENABLE_MSK;
+}
+
+static inline void gtim_compare_disable(void){
+	GTIM_REG->control &= ~(uint32_t)GTIM_CONTROL_COMPARE_ENABLE_MSK;
+}
+
+static inline uint64_t gtim_get_compare(void){
+	return (uint64_t)GTIM_REG->compareh << 32U | GTIM_REG->comparel;
+}
+
+// The comparator is turned off while the two halves are written, so it cannot match a half written value
+static inline void gtim_set_compare(uint64_t compare){
+	uint32_t control = GTIM_REG->control;
+
+	GTIM_REG->control = control & ~(uint32_t)GTIM_CONTROL_COMPARE_ENABLE_MSK;
+	GTIM_REG->comparel = (uint32_t)compare;
+	GTIM_REG->compareh = (uint32_t)(compare >> 32U);
+	GTIM_REG->control = control;
+}
+
+// With auto-increment the comparator adds this value to itself after each match
+static inline void gtim_set_autoinc(uint32_t autoinc){
+	GTIM_REG->autoinc = autoinc;
+}
+
+static inline void gtim_autoinc_enable(void){
+	GTIM_REG->control |= GTIM_CONTROL_AUTOINC_MSK;
+}
+
+static inline void gtim_irq_enable(void){
+	GTIM_REG->control |= GTIM_CONTROL_IRQ_ENABLE_MSK;
+}
+
+static inline void gtim_irq_disable(void){
+	GTIM_REG->control &= ~(uint32_t)GTIM_CONTROL_IRQ_ENABLE_MSK;
+}
+
+// The event flag is set on a comparator match, and stays set until cleared by writing 1
+static inline bool gtim_is_event(void){
+	return GTIM_REG->isr & GTIM_ISR_EVENTFLAG_MSK;
+}
+
+static inline void gtim_clear_event(void){
+	GTIM_REG->isr = GTIM_ISR_EVENTFLAG_MSK;
+}
+
 #endif
 
 #endif
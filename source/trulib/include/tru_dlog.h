@@ -0,0 +1,79 @@
+/*
+	MIT License
+
+	Copyright (c) 2025 Truong Hy
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+
+	Version: 20261017
+
+	Deferred binary logger, records a format string pointer, a timestamp and the
+	raw arguments in a RAM ring per CPU for a low priority task to send out.
+*/
+
+#ifndef TRU_DLOG_H
+#define TRU_DLOG_H
+
+#include "tru_config.h"
+
+#if(TRU_CPU_FAMILY == TRU_CPU_FAMILY_CORTEXA9)
+
+#include "tru_cortex_a9.h"
+#include "tru_spsc.h"
+#include <stdint.h>
+
+// The record layout.  Only the pointer to the format string is kept, the
+// string itself stays in .rodata and the host decoder reads it from the ELF
+// file, see scripts-generic/tru_dlog_decode.py.  So the format string must be
+// a string literal, as must any %s argument, and each argument must fit in 32
+// bits: integers up to long, char and pointers, but not double or long long
+#define TRU_DLOG_ARGS_MAX    12U
+#define TRU_DLOG_RING_LENGTH 128U  // Records per CPU, a power of 2
+#define TRU_DLOG_CPUS        2U
+
+typedef struct{
+	const char *fmt;                   // NULL for a dropped records report, arg[0] is the count
+	uint32_t cpu_nargs;                // Bits 7..4: CPU, bits 3..0: number of arguments
+	uint64_t time;                     // Global timer
+	uint32_t arg[TRU_DLOG_ARGS_MAX];
+}tru_dlog_rec_t;
+
+// Counts the arguments of TRU_DLOG(), 0 to 20.  More than TRU_DLOG_ARGS_MAX
+// fails the assert in TRU_DLOG(), as does more than 20, which doesn't give a
+// constant.  Note, LOG() with TRU_LOG_LOC adds 3 arguments of its own
+#define TRU_DLOG_NARGS(args...) TRU_DLOG_NARGS_(0, ##args, 20, 19, 18, 17, 16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0)
+#define TRU_DLOG_NARGS_(_0, _1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11, _12, _13, _14, _15, _16, _17, _18, _19, _20, n, ...) n
+
+// Records a log message, e.g. TRU_DLOG("Key %lu\n", (unsigned long)key).  It
+// never waits for the UART, the record is dropped and counted if the ring of
+// this CPU is full.  Callable from tasks and interrupt handlers on either CPU,
+// and before the scheduler is started
+#define TRU_DLOG(fmt, args...) do{ \
+	_Static_assert(TRU_DLOG_NARGS(args) <= TRU_DLOG_ARGS_MAX, "TRU_DLOG() has more than TRU_DLOG_ARGS_MAX arguments"); \
+	tru_dlog_record(fmt, TRU_DLOG_NARGS(args), ##args); \
+}while(0)
+
+// Called by TRU_DLOG().  A record of more than TRU_DLOG_ARGS_MAX arguments is
+// dropped and counted
+void tru_dlog_record(const char *fmt, uint32_t nargs, ...) __attribute__((format(printf, 1, 3)));
+uint32_t tru_dlog_drain(void);
+
+#endif
+
+#endif
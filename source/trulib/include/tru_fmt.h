@@ -0,0 +1,86 @@
+/*
+	MIT License
+
+	Copyright (c) 2025 Truong Hy
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+
+	Version: 20261017
+
+	Small printf style formatter for logging, reentrant, with no heap and a
+	bounded stack.
+*/
+
+#ifndef TRU_FMT_H
+#define TRU_FMT_H
+
+#include "tru_config.h"
+
+#if(TRU_CPU_FAMILY == TRU_CPU_FAMILY_CORTEXA9)
+
+#include <stdarg.h>
+#include <stddef.h>
+
+// newlib's vfprintf() takes over 1KB of stack, more with floating point, and
+// keeps conversion buffers in the struct _reent of the task.  tru_fmt uses
+// about 100 bytes of stack besides the output buffer, keeps no state between
+// calls and writes straight into the caller's buffer, so it can be called
+// from any task or interrupt handler on either CPU.
+//
+// The conversions are the printf ones that logging uses:
+//   %d %i %u %x %X %o %c %s %p %%
+//   with the flags - 0 + space #, a width and a precision, either may be *,
+//   and the sizes hh h l ll j z t
+//   %f %F in fixed point notation, with a precision up to 9 (default 6).  It
+//   is formatted from the integer and fraction parts, not with newlib's
+//   dtoa, so the last digit may differ from printf().  A value too large for
+//   64 bits prints as ovf
+// Anything else, e.g. %e, %g or %n, is printed as it is written
+typedef struct tru_fmt_out_s tru_fmt_out_t;
+
+// Called when buf is full, it sends out the pos bytes in buf and sets pos to 0
+typedef void (*tru_fmt_flush_t)(tru_fmt_out_t *out);
+
+struct tru_fmt_out_s{
+	char *buf;
+	size_t size;             // Bytes in buf
+	size_t pos;              // Bytes in buf so far
+	size_t count;            // Characters formatted, including those that didn't fit
+	tru_fmt_flush_t flush;   // NULL to drop what doesn't fit
+	void *context;           // Free for the flush function
+};
+
+// Formats to out, leaving the last part in buf for the caller to send out.
+// Returns the number of characters formatted by this call
+size_t tru_fmt_vformat(tru_fmt_out_t *out, const char *fmt, va_list ap);
+
+// Like vsnprintf() and snprintf(): buf is always terminated if size isn't 0,
+// and the return is the length the whole output would have had
+int tru_fmt_vsnprintf(char *buf, size_t size, const char *fmt, va_list ap);
+int tru_fmt_snprintf(char *buf, size_t size, const char *fmt, ...) __attribute__((format(printf, 3, 4)));
+
+// Like dprintf(): formats in a TRU_FMT_DPRINTF_BUF byte buffer on the stack
+// and writes it with _write(), e.g. to the console UART, see tru_newlib_ext.c.
+// A longer output is written in parts.  Returns the number of characters
+#define TRU_FMT_DPRINTF_BUF 128U
+int tru_fmt_dprintf(int fd, const char *fmt, ...) __attribute__((format(printf, 2, 3)));
+
+#endif
+
+#endif
@@ -0,0 +1,119 @@
+/*
+	MIT License
+
+	Copyright (c) 2025 Truong Hy
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+
+	Version: 20261017
+
+	Framed transport over the console UART: COBS encoded frames with a CRC-32,
+	on a few logical channels.
+*/
+
+#ifndef TRU_FRAME_H
+#define TRU_FRAME_H
+
+#include "tru_config.h"
+
+#if(TRU_CPU_FAMILY == TRU_CPU_FAMILY_CORTEXA9)
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// A frame on the wire is
+//   COBS(channel, payload, CRC-32 of channel and payload, little endian) 0x00
+// COBS replaces every 0x00 in the frame, so 0x00 only ever ends a frame and a
+// receiver that starts in the middle, or loses bytes, is back in step at the
+// next one.  It adds 1 byte per 254.  The CRC is the one of Ethernet and
+// zlib.crc32().  The host side is scripts-generic/tru_frame_client.py
+//
+// Sending is zero-copy: the encoder reads the caller's buffers, a list of
+// them for a header and a body, and writes each run of non-zero bytes
+// straight from them to the write function, e.g. into the UART driver ring.
+// There is no frame buffer.  A frame is written as a whole under the lock
+// functions, so frames from different tasks don't interleave.
+//
+// Receiving is a byte at a time into a buffer given by the application, a
+// good frame is passed to the handler of its channel.  Both are
+// RTOS agnostic, the application provides the write, lock and unlock
+// functions and calls tru_frame_rx() with the received bytes
+#define TRU_FRAME_DELIM    0x00U
+#define TRU_FRAME_CRC_SIZE 4U
+#define TRU_FRAME_IOV_MAX  4U    // Buffers per frame
+
+typedef enum{
+	TRU_FRAME_CH_LOG,        // Text, what _write() would have printed
+	TRU_FRAME_CH_DLOG,       // Deferred logger records, tru_dlog.h frames without the sync and check bytes
+	TRU_FRAME_CH_TELEMETRY,  // Status sent by the target on its own
+	TRU_FRAME_CH_COMMAND,    // Requests from the host and their replies
+	TRU_FRAME_CH_TRACE,      // Kernel trace dump, tru_trace.h, an empty frame ends it
+	TRU_FRAME_CHANNELS
+}tru_frame_channel_t;
+
+typedef struct tru_frame_s tru_frame_t;
+
+typedef struct{
+	const void *buf;
+	uint32_t len;
+}tru_frame_iov_t;
+
+typedef void (*tru_frame_callback_t)(tru_frame_t *link);
+typedef void (*tru_frame_write_t)(tru_frame_t *link, const uint8_t *buf, uint32_t len);
+typedef void (*tru_frame_handler_t)(tru_frame_t *link, uint32_t channel, const uint8_t *data, uint32_t len);
+
+struct tru_frame_s{
+	tru_frame_write_t write;
+	tru_frame_callback_t lock;       // NULL when only one context sends
+	tru_frame_callback_t unlock;
+	void *context;                   // Free for the callback functions
+	tru_frame_handler_t handler[TRU_FRAME_CHANNELS];
+	uint8_t *rx_buf;
+	uint32_t rx_size;
+	uint32_t rx_len;
+	uint32_t rx_left;                // Bytes left in the COBS block, 0 when a code byte is next
+	uint32_t rx_code;                // Code byte of the last block, 0 before the first
+	bool rx_drop;                    // Too long, ignored up to the next delimiter
+	uint32_t rx_frames;              // Good frames received
+	uint32_t rx_errors;              // Frames dropped for their CRC, length or a missing byte
+};
+
+// The link that _write() and the deferred logger send through when set, see
+// tru_newlib_ext.c and tru_dlog.c.  NULL until the application sets it
+extern tru_frame_t *tru_frame_console;
+
+// rx_buf holds the largest frame to receive, channel and CRC included.  Set
+// the channel handlers with tru_frame_handler_set()
+void tru_frame_init(tru_frame_t *link, tru_frame_write_t write, tru_frame_callback_t lock, tru_frame_callback_t unlock, uint8_t *rx_buf, uint32_t rx_size, void *context);
+void tru_frame_handler_set(tru_frame_t *link, uint32_t channel, tru_frame_handler_t handler);
+
+// Sends the buffers as the payload of one frame
+void tru_frame_sendv(tru_frame_t *link, uint32_t channel, const tru_frame_iov_t *iov, uint32_t iov_count);
+void tru_frame_send(tru_frame_t *link, uint32_t channel, const void *buf, uint32_t len);
+
+// Decodes received bytes, calling the channel handlers as frames complete
+void tru_frame_rx(tru_frame_t *link, const uint8_t *buf, uint32_t len);
+
+// CRC-32 (reflected 0xedb88320), start with crc 0 and feed it back to continue
+uint32_t tru_frame_crc32(uint32_t crc, const void *buf, uint32_t len);
+
+#endif
+
+#endif
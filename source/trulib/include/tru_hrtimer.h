@@ -0,0 +1,88 @@
+/*
+	MIT License
+
+	Copyright (c) 2025 Truong Hy
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+
+	Version: 20261017
+
+	High resolution (microsecond) timer service for the Intel Cyclone V SoC (HPS).
+*/
+
+#ifndef TRU_HRTIMER_H
+#define TRU_HRTIMER_H
+
+#include "tru_config.h"
+
+#if(TRU_TARGET == TRU_TARGET_C5SOC)
+
+#include "alt_timers.h"
+#include "alt_interrupt.h"
+#include <stdint.h>
+
+// Any number of one-shot and periodic timers are multiplexed onto one SP
+// timer, which runs at the L4 SP clock (100MHz on the DE10-Nano).  Deadlines
+// are kept as 64-bit global timer counts, so they don't drift when the SP timer
+// is reprogrammed.  The global timer is left running, it is shared with the
+// FreeRTOS run time stats and tickless idle
+#define TRU_HRTIMER_GPT ALT_GPT_SP_TMR1
+#define TRU_HRTIMER_IRQ ALT_INT_INTERRUPT_TIMER_L4SP_1_IRQ
+
+// Timers due within this time of the current one are called in the same
+// interrupt, it is about the time it takes to take another interrupt
+#define TRU_HRTIMER_SLACK_US 2U
+
+// Shortest period, a shorter one is raised to it by tru_hrtimer_start()
+#define TRU_HRTIMER_PERIOD_MIN_US (TRU_HRTIMER_SLACK_US + 1U)
+
+typedef struct tru_hrtimer_s tru_hrtimer_t;
+
+// Called in interrupt context, see tru_hrtimer_isr()
+typedef void (*tru_hrtimer_callback_t)(tru_hrtimer_t *timer, void *context);
+
+struct tru_hrtimer_s{
+	uint64_t expiry;  // Global timer count
+	uint64_t period;  // Global timer counts, 0 = one-shot
+	tru_hrtimer_callback_t callback;
+	void *context;
+	tru_hrtimer_t *next;
+	uint32_t active;
+};
+
+// Initialises the SP timer.  The application then registers tru_hrtimer_isr()
+// as the handler of TRU_HRTIMER_IRQ and enables it, and its callbacks can only
+// call interrupt safe functions of the RTOS if its priority allows it
+void tru_hrtimer_init(void);
+void tru_hrtimer_isr(uint32_t icciar, void *context);
+
+void tru_hrtimer_create(tru_hrtimer_t *timer, tru_hrtimer_callback_t callback, void *context);
+
+// Starts or restarts a timer, expiring delay_us from now and then every
+// period_us if it isn't 0.  The period is at least TRU_HRTIMER_PERIOD_MIN_US
+void tru_hrtimer_start(tru_hrtimer_t *timer, uint32_t delay_us, uint32_t period_us);
+void tru_hrtimer_stop(tru_hrtimer_t *timer);
+
+// Current time, in global timer counts, and conversion from microseconds
+uint64_t tru_hrtimer_now(void);
+uint64_t tru_hrtimer_us_to_counts(uint32_t us);
+
+#endif
+
+#endif
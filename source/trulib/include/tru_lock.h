@@ -0,0 +1,92 @@
+/*
+	MIT License
+
+	Copyright (c) 2025 Truong Hy
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+
+	Version: 20261017
+
+	Short critical sections that are safe against interrupts and the other CPU.
+*/
+
+#ifndef TRU_LOCK_H
+#define TRU_LOCK_H
+
+#include "tru_config.h"
+
+#if(TRU_CPU_FAMILY == TRU_CPU_FAMILY_CORTEXA9)
+
+#include "tru_cortex_a9.h"
+#include <stdint.h>
+
+// Masks IRQ on this CPU and, with SMP, spins on the lock word against the
+// other CPU.  The critical section must be short, nothing else runs on this
+// CPU meanwhile.  Works the same in a task, an interrupt handler or without an
+// RTOS, so it is used by trulib modules that are shared between them
+typedef volatile uint32_t tru_spinlock_t;
+
+// Returns the previous CPSR, which is passed to tru_unlock_irqrestore()
+static inline uint32_t tru_lock_irqsave(tru_spinlock_t *lock){
+	uint32_t cpsr;
+
+	__asm__ volatile(
+		"MRS   %0, cpsr                                      \n"
+		"CPSID i                                             \n"
+		: "=r" (cpsr) : : "memory"
+	);
+
+#if defined(TRU_SMP) && TRU_SMP == 1U
+	uint32_t tmp;
+
+	__asm__ volatile(
+		"1:                                                  \n"
+		"LDREX %0, [%1]                                      \n"
+		"CMP   %0, #0                                        \n"
+		"WFENE                                               \n"
+		"BNE   1b                                            \n"
+		"STREX %0, %2, [%1]                                  \n"
+		"CMP   %0, #0                                        \n"
+		"BNE   1b                                            \n"
+		"DMB                                                 \n"
+		: "=&r" (tmp) : "r" (lock), "r" (1U) : "cc", "memory"
+	);
+#else
+	(void)lock;
+#endif
+
+	return cpsr;
+}
+
+static inline void tru_unlock_irqrestore(tru_spinlock_t *lock, uint32_t cpsr){
+#if defined(TRU_SMP) && TRU_SMP == 1U
+	__dmb();
+	*lock = 0U;
+	__dsb();
+	__sev();
+#else
+	(void)lock;
+#endif
+
+	__asm__ volatile("MSR cpsr_c, %0" : : "r" (cpsr) : "memory");
+}
+
+#endif
+
+#endif
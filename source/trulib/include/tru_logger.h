@@ -21,7 +21,7 @@
 	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 	SOFTWARE.
 
-	Version: 20241124
+	Version: 20261017
 
 	Provides debug logging support for bare-metal program development.
 */
@@ -32,14 +32,112 @@
 #include "tru_config.h"
 #include <stdio.h>
 
+#define TRU_LOG_LEVEL_NONE  0U
+#define TRU_LOG_LEVEL_ERROR 1U
+#define TRU_LOG_LEVEL_WARN  2U
+#define TRU_LOG_LEVEL_INFO  3U
+#define TRU_LOG_LEVEL_DEBUG 4U
+
+#ifndef TRU_LOG_LEVEL
+	#define TRU_LOG_LEVEL TRU_LOG_LEVEL_DEBUG
+#endif
+#ifndef TRU_LOG_LEVEL_RUN
+	#define TRU_LOG_LEVEL_RUN TRU_LOG_LEVEL
+#endif
+#ifndef TRU_LOG_MODULES
+	#define TRU_LOG_MODULES 8U
+#endif
+
+// Modules of the level table, the application numbers its own from
+// TRU_LOG_MOD_APP up to TRU_LOG_MODULES - 1
+#define TRU_LOG_MOD_DEFAULT 0U
+#define TRU_LOG_MOD_TRULIB  1U
+#define TRU_LOG_MOD_RTOS    2U
+#define TRU_LOG_MOD_APP     3U
+
 #if defined(TRU_LOG) && TRU_LOG == 1U
+	// Formats in the caller, which waits for the console UART, or for room in
+	// its ring when it is interrupt driven.  With TRU_LOG_FMT the formatter is
+	// tru_fmt.h, which needs much less stack than newlib's fprintf() and
+	// writes to stderr's file descriptor without going through stdio
+	#if defined(TRU_LOG_FMT) && TRU_LOG_FMT == 1U
+		#include "tru_fmt.h"
+
+		#define TRU_LOG_PRINTF(fmt, args...) tru_fmt_dprintf(2, fmt, ##args)
+	#else
+		#define TRU_LOG_PRINTF(fmt, args...) fprintf(stderr, fmt, ##args)
+	#endif
+
 	#if defined(TRU_LOG_LOC) && TRU_LOG_LOC == 1U
-		#define LOG(fmt, args...) fprintf(stderr, "%s, %d, %s(), " fmt, __FILE__, __LINE__, __func__, ##args)
+		#define LOG_SYNC(fmt, args...) TRU_LOG_PRINTF("%s, %d, %s(), " fmt, __FILE__, __LINE__, __func__, ##args)
 	#else
-		#define LOG(fmt, args...) fprintf(stderr, fmt, ##args)
+		#define LOG_SYNC(fmt, args...) TRU_LOG_PRINTF(fmt, ##args)
+	#endif
+
+	// Records for a low priority task to send out, see tru_dlog.h.  Use
+	// LOG_SYNC() for a fatal error, or for a report too long for the ring
+	#if defined(TRU_LOG_DEFER) && TRU_LOG_DEFER == 1U
+		#include "tru_dlog.h"
+
+		#if defined(TRU_LOG_LOC) && TRU_LOG_LOC == 1U
+			#define LOG(fmt, args...) TRU_DLOG("%s, %d, %s(), " fmt, __FILE__, __LINE__, __func__, ##args)
+		#else
+			#define LOG(fmt, args...) TRU_DLOG(fmt, ##args)
+		#endif
+	#else
+		#define LOG(fmt, args...) LOG_SYNC(fmt, ##args)
+	#endif
+
+	// Levelled logging, a message is logged by LOG() when its level is at most
+	// the threshold of its module.  Levels above TRU_LOG_LEVEL are compiled
+	// out, the others cost a byte load and a compare when off, and the
+	// arguments are only evaluated when on.  The thresholds are in a table,
+	// which may be changed at run time.  A file sets its module before it
+	// includes this header, else it is TRU_LOG_MOD_DEFAULT, e.g.:
+	//   #define TRU_LOG_MODULE TRU_LOG_MOD_APP
+	//   #include "tru_logger.h"
+	#include <stdint.h>
+
+	#ifndef TRU_LOG_MODULE
+		#define TRU_LOG_MODULE TRU_LOG_MOD_DEFAULT
+	#endif
+
+	extern uint8_t tru_log_level[TRU_LOG_MODULES];
+
+	#define TRU_LOG_ON(module, level) ((level) <= tru_log_level[(module)])
+	#define TRU_LOG_AT(level, fmt, args...) do{ if(TRU_LOG_ON(TRU_LOG_MODULE, level)) LOG(fmt, ##args); }while(0)
+
+	#if TRU_LOG_LEVEL >= TRU_LOG_LEVEL_ERROR
+		#define LOG_ERROR(fmt, args...) TRU_LOG_AT(TRU_LOG_LEVEL_ERROR, fmt, ##args)
+	#endif
+	#if TRU_LOG_LEVEL >= TRU_LOG_LEVEL_WARN
+		#define LOG_WARN(fmt, args...) TRU_LOG_AT(TRU_LOG_LEVEL_WARN, fmt, ##args)
+	#endif
+	#if TRU_LOG_LEVEL >= TRU_LOG_LEVEL_INFO
+		#define LOG_INFO(fmt, args...) TRU_LOG_AT(TRU_LOG_LEVEL_INFO, fmt, ##args)
 	#endif
+	#if TRU_LOG_LEVEL >= TRU_LOG_LEVEL_DEBUG
+		#define LOG_DEBUG(fmt, args...) TRU_LOG_AT(TRU_LOG_LEVEL_DEBUG, fmt, ##args)
+	#endif
+
+	// Sets the threshold of a module, or of all with TRU_LOG_MODULES
+	void tru_log_level_set(uint32_t module, uint32_t level);
 #else
 	#define LOG(fmt, args...)  do {} while(0) // Do nothing
+	#define LOG_SYNC(fmt, args...)  do {} while(0) // Do nothing
+#endif
+
+#ifndef LOG_ERROR
+	#define LOG_ERROR(fmt, args...) do {} while(0) // Do nothing
+#endif
+#ifndef LOG_WARN
+	#define LOG_WARN(fmt, args...) do {} while(0) // Do nothing
+#endif
+#ifndef LOG_INFO
+	#define LOG_INFO(fmt, args...) do {} while(0) // Do nothing
+#endif
+#ifndef LOG_DEBUG
+	#define LOG_DEBUG(fmt, args...) do {} while(0) // Do nothing
 #endif
 
 #endif
@@ -0,0 +1,99 @@
+/*
+	MIT License
+
+	Copyright (c) 2025 Truong Hy
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+
+	Version: 20261017
+
+	Fixed size block memory pool, for passing messages without copying them.
+*/
+
+#ifndef TRU_MPOOL_H
+#define TRU_MPOOL_H
+
+#include "tru_config.h"
+
+#if(TRU_CPU_FAMILY == TRU_CPU_FAMILY_CORTEXA9)
+
+#include "tru_lock.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+// A producer allocates a block, fills it in place and passes only the pointer
+// on, e.g. through a FreeRTOS queue of pointers or a tru_spsc ring.  The
+// consumer frees the block back to the pool when it is done with it.  Alloc
+// and free take constant time and can be called from tasks and interrupt
+// handlers on either CPU.
+//
+// Blocks are rounded up to a multiple of 8 bytes.  The blocks are followed by
+// a bitmap of the allocated ones, so a block freed twice is caught.  The
+// storage can be declared with TRU_MPOOL_STORAGE(), e.g.
+//   TRU_MPOOL_STORAGE(frame_pool_buf, sizeof(frame_t), 16);
+//   tru_mpool_init(&frame_pool, frame_pool_buf, sizeof(frame_t), 16);
+#define TRU_MPOOL_BLOCK_SIZE(size) (((size) + 7U) & ~7U)
+#define TRU_MPOOL_MAP_SIZE(count) ((((count) + 63U) / 64U) * 8U)
+#define TRU_MPOOL_BUF_SIZE(size, count) (TRU_MPOOL_BLOCK_SIZE(size) * (count) + TRU_MPOOL_MAP_SIZE(count))
+#define TRU_MPOOL_STORAGE(name, size, count) \
+	static uint64_t name[TRU_MPOOL_BUF_SIZE(size, count) / 8U]
+
+typedef struct tru_mpool_block_s{
+	struct tru_mpool_block_s *next;
+}tru_mpool_block_t;
+
+typedef struct{
+	tru_spinlock_t lock;
+	tru_mpool_block_t *free_list;
+	uint8_t *buf;
+	uint32_t *map;         // Bit per block, set while it is allocated
+	uint32_t block_size;
+	uint32_t block_count;
+	uint32_t used;         // Blocks allocated now
+	uint32_t high_water;   // Most blocks allocated at once
+	uint32_t alloc_fails;  // Allocations that found the pool empty
+	uint32_t free_fails;   // Frees of a block not from the pool or not allocated
+}tru_mpool_t;
+
+typedef struct{
+	uint32_t block_size;
+	uint32_t block_count;
+	uint32_t used;
+	uint32_t high_water;
+	uint32_t alloc_fails;
+	uint32_t free_fails;
+}tru_mpool_stats_t;
+
+// buf holds TRU_MPOOL_BUF_SIZE(block_size, block_count) bytes and must be 8
+// byte aligned
+void tru_mpool_init(tru_mpool_t *pool, void *buf, uint32_t block_size, uint32_t block_count);
+
+// Returns NULL when the pool is empty
+void *tru_mpool_alloc(tru_mpool_t *pool);
+
+// Returns false, and does nothing but count it in free_fails, if the block
+// isn't from this pool or isn't allocated, e.g. it was already freed
+bool tru_mpool_free(tru_mpool_t *pool, void *block);
+
+void tru_mpool_get_stats(tru_mpool_t *pool, tru_mpool_stats_t *stats);
+void tru_mpool_reset_high_water(tru_mpool_t *pool);
+
+#endif
+
+#endif
@@ -7,4 +7,7 @@
 #define TRU_CPU_FAMILY_CORTEXA9 0
 #define TRU_CPU_FAMILY_CORTEXM7 1
 
+#define TRU_BOARD_DE10NANO 0
+#define TRU_BOARD_VEXPA9   1
+
 #endif
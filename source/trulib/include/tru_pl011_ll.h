@@ -0,0 +1,84 @@
+/*
+	MIT License
+
+	Copyright (c) 2025 Truong Hy
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+
+	Version: 20261017
+
+	Low-level code for the Arm PrimeCell UART (PL011), the console of the QEMU
+	vexpress-a9 board, see tru_board_vexpa9.h.
+
+	The UART is polled, the same as the HPS UART in tru_c5soc_hps_uart_ll.h.
+	QEMU transmits at once and ignores the baud rate, so only the enable bits
+	are set up.
+
+	References:
+		- ARM DDI 0183: PrimeCell UART (PL011) Technical Reference Manual
+*/
+
+#ifndef TRU_PL011_LL_H
+#define TRU_PL011_LL_H
+
+#include "tru_config.h"
+
+#if(TRU_TARGET == TRU_TARGET_C5SOC) && (TRU_BOARD == TRU_BOARD_VEXPA9)
+
+#include "tru_board.h"
+#include <stdint.h>
+
+#define TRU_PL011_FR_BUSY_MSK   (0x1U << 3U)  // Transmitting, until the FIFO is empty and the last bit is sent
+#define TRU_PL011_FR_TXFF_MSK   (0x1U << 5U)  // Transmit FIFO full
+#define TRU_PL011_CR_UARTEN_MSK (0x1U << 0U)
+#define TRU_PL011_CR_TXE_MSK    (0x1U << 8U)
+#define TRU_PL011_CR_RXE_MSK    (0x1U << 9U)
+
+typedef struct{
+	volatile uint32_t dr;
+	volatile uint32_t rsr_ecr;  // Has dual functionality: read = rsr, write = ecr
+	volatile uint32_t reserved[4];
+	volatile uint32_t fr;
+	volatile uint32_t reserved2;
+	volatile uint32_t ilpr;
+	volatile uint32_t ibrd;
+	volatile uint32_t fbrd;
+	volatile uint32_t lcr_h;
+	volatile uint32_t cr;
+	volatile uint32_t ifls;
+	volatile uint32_t imsc;
+	volatile uint32_t ris;
+	volatile uint32_t mis;
+	volatile uint32_t icr;
+	volatile uint32_t dmacr;
+}tru_pl011_reg_t;
+
+// UART registers as type representation
+#define TRU_PL011_UART0_REG ((volatile tru_pl011_reg_t *const)TRU_BOARD_UART0_BASE)
+#define TRU_PL011_REG(base_addr) ((volatile tru_pl011_reg_t *const)base_addr)
+
+void tru_pl011_ll_init(void *uart_base);
+void tru_pl011_ll_wait_empty(void *uart_base);
+void tru_pl011_ll_write_str(void *uart_base, const char *str, uint32_t len);
+void tru_pl011_ll_write_bin(void *uart_base, const uint8_t *buf, uint32_t len);
+void tru_pl011_ll_write_char(void *uart_base, const char c);
+
+#endif
+
+#endif
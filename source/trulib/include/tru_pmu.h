@@ -0,0 +1,135 @@
+/*
+	MIT License
+
+	Copyright (c) 2025 Truong Hy
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+
+	Version: 20261017
+
+	Cortex-A9 performance monitor (PMU), counts per task.
+*/
+
+#ifndef TRU_PMU_H
+#define TRU_PMU_H
+
+#include "tru_config.h"
+
+#if(TRU_CPU_FAMILY == TRU_CPU_FAMILY_CORTEXA9)
+
+#include "tru_cortex_a9.h"
+#include <stdint.h>
+
+#define PMCR_E_MSK        0x1U         // Enable all counters
+#define PMCR_P_MSK        0x2U         // Reset the event counters
+#define PMCR_C_MSK        0x4U         // Reset the cycle counter
+#define PMCR_D_MSK        0x8U         // Cycle counter counts every 64th cycle
+#define PMCNT_CYCLES_MSK  0x80000000U  // Cycle counter bit in the enable and overflow registers
+#define SDER_SUNIDEN_MSK  0x2U
+
+// Each CPU has a cycle counter and six event counters, each counter can count
+// any one of these events.  The Cortex-A9 has no architectural instructions
+// executed event (0x08), TRU_PMU_INST_RENAME is the nearest
+typedef enum{
+	TRU_PMU_ICACHE_REFILL   = 0x01U,
+	TRU_PMU_ITLB_REFILL     = 0x02U,
+	TRU_PMU_DCACHE_REFILL   = 0x03U,
+	TRU_PMU_DCACHE_ACCESS   = 0x04U,
+	TRU_PMU_DTLB_REFILL     = 0x05U,
+	TRU_PMU_LOAD            = 0x06U,
+	TRU_PMU_STORE           = 0x07U,
+	TRU_PMU_EXCEPTION       = 0x09U,
+	TRU_PMU_EXCEPTION_RET   = 0x0aU,
+	TRU_PMU_PC_WRITE        = 0x0cU,
+	TRU_PMU_BRANCH_IMM      = 0x0dU,
+	TRU_PMU_UNALIGNED       = 0x0fU,
+	TRU_PMU_BRANCH_MISPRED  = 0x10U,
+	TRU_PMU_BRANCH_PRED     = 0x12U,
+	TRU_PMU_STALL_ICACHE    = 0x60U,  // Cycles stalled on an instruction fetch
+	TRU_PMU_STALL_DATA      = 0x61U,  // Cycles stalled on a data access
+	TRU_PMU_STALL_TLB       = 0x62U,  // Cycles stalled on a main TLB miss
+	TRU_PMU_DATA_EVICTION   = 0x65U,
+	TRU_PMU_ISSUE_STALL     = 0x66U,  // Cycles no instruction was dispatched
+	TRU_PMU_INST_RENAME     = 0x68U,  // Instructions out of the register rename stage
+	TRU_PMU_EXT_IRQ         = 0x93U   // External interrupts
+}tru_pmu_event_t;
+
+#define TRU_PMU_COUNTERS 6U
+#define TRU_PMU_TASKS    64U  // Tasks counted, by task number
+
+// The events counted when tru_pmu_init() is given NULL, in counter order
+#define TRU_PMU_DEFAULT_EVENTS { \
+	TRU_PMU_INST_RENAME, \
+	TRU_PMU_DCACHE_REFILL, \
+	TRU_PMU_ICACHE_REFILL, \
+	TRU_PMU_BRANCH_MISPRED, \
+	TRU_PMU_DTLB_REFILL, \
+	TRU_PMU_EXCEPTION \
+}
+
+typedef struct{
+	uint64_t cycles;
+	uint64_t event[TRU_PMU_COUNTERS];
+}tru_pmu_counters_t;
+
+// Starts only the cycle counter of the calling CPU, for timing code without
+// the per task counts.  tru_pmu_init() starts it as well
+static inline void tru_pmu_cycles_start(void){
+	uint32_t reg;
+
+	__read_sder(reg);
+	__write_sder(reg | SDER_SUNIDEN_MSK);
+
+	__read_pmcr(reg);
+	__write_pmcr((reg & ~PMCR_D_MSK) | PMCR_E_MSK);
+	__write_pmcntenset(PMCNT_CYCLES_MSK);
+	__isb();
+}
+
+// The cycle counter of the calling CPU, it wraps every 2^32 cycles
+static inline uint32_t tru_pmu_cycles(void){
+	uint32_t cycles;
+
+	__read_pmccntr(cycles);
+	return cycles;
+}
+
+#if defined(TRU_PMU) && TRU_PMU == 1U
+
+void tru_pmu_init(const uint32_t *events);
+void tru_pmu_switch_in(uint32_t task);
+void tru_pmu_switch_out(uint32_t task);
+void tru_pmu_task_get(uint32_t task, tru_pmu_counters_t *counters);
+uint32_t tru_pmu_event_get(uint32_t counter);
+
+#else
+
+static inline void tru_pmu_switch_in(uint32_t task){
+	(void)task;
+}
+
+static inline void tru_pmu_switch_out(uint32_t task){
+	(void)task;
+}
+
+#endif
+
+#endif
+
+#endif
@@ -0,0 +1,96 @@
+/*
+	MIT License
+
+	Copyright (c) 2025 Truong Hy
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+
+	Version: 20261017
+
+	Statistical PC sampling profiler for the Intel Cyclone V SoC (HPS).
+*/
+
+#ifndef TRU_PROF_H
+#define TRU_PROF_H
+
+#include "tru_config.h"
+
+#if(TRU_TARGET == TRU_TARGET_C5SOC)
+
+#include "tru_cache.h"
+#include "alt_interrupt.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+// The private watchdog of each CPU, in timer mode.  It is a banked PPI, so
+// each CPU samples itself
+#define TRU_PROF_IRQ ALT_INT_INTERRUPT_PPI_TIMER_WATCHDOG
+
+#define TRU_PROF_MAGIC        0x464f5250U  // "PROF"
+#define TRU_PROF_ENTRIES_LOG2 11U
+#define TRU_PROF_ENTRIES      (1U << TRU_PROF_ENTRIES_LOG2)  // Histogram entries per CPU
+#define TRU_PROF_PROBES       16U          // Entries tried before a sample is dropped
+#define TRU_PROF_CPUS         2U
+
+// A histogram entry, samples with the same PC, LR and context are counted
+// together.  An entry with a count of 0 is free
+typedef struct{
+	uint32_t pc;
+	uint32_t lr;
+	uint32_t context;                     // E.g. the running task
+	uint32_t count;
+}tru_prof_entry_t;
+
+typedef struct{
+	uint32_t samples;
+	uint32_t dropped;                     // Samples lost to a full histogram
+	tru_prof_entry_t table[TRU_PROF_ENTRIES];
+}__attribute__((aligned(CACHELINE_SIZE))) tru_prof_cpu_t;
+
+typedef struct{
+	uint32_t magic;
+	uint32_t entries;
+	uint32_t cpus;
+	uint32_t rate_hz;
+	volatile uint32_t enabled;
+	tru_prof_cpu_t cpu[TRU_PROF_CPUS];
+}tru_prof_t;
+
+extern tru_prof_t tru_prof;
+
+#if defined(TRU_PROF) && TRU_PROF == 1U
+
+// Sets up and starts the private watchdog of the calling CPU, so it is called
+// on each CPU.  The application then registers a handler for TRU_PROF_IRQ
+// that calls tru_prof_sample() with the interrupted PC and LR, and enables
+// the interrupt on each CPU.  Returns false, and starts nothing, if rate_hz is
+// 0 or above the watchdog clock
+bool tru_prof_init(uint32_t rate_hz);
+void tru_prof_sample(uint32_t pc, uint32_t lr, uint32_t context);
+
+void tru_prof_start(void);
+void tru_prof_stop(void);
+void tru_prof_clear(void);
+void tru_prof_print(void);
+
+#endif
+
+#endif
+
+#endif
@@ -0,0 +1,50 @@
+/*
+	MIT License
+
+	Copyright (c) 2025 Truong Hy
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+
+	Version: 20261017
+
+	Dual CPU (SMP) support for the Intel Cyclone V SoC (HPS), ARM Cortex-A9 MPCore.
+*/
+
+#ifndef TRU_SMP_H
+#define TRU_SMP_H
+
+#include "tru_config.h"
+
+#if(TRU_TARGET == TRU_TARGET_C5SOC)
+
+#if defined(TRU_SMP) && TRU_SMP == 1U
+
+#include <stdint.h>
+
+// Releases CPU1 from reset.  CPU1 runs Reset_Handler_CPU1 (see tru_startup.c),
+// which sets up its own exception stacks, VFP/NEON, MMU and L1 cache, then
+// calls entry with IRQ and FIQ masked.  CPU0 must have completed its startup,
+// i.e. this is called from main() or later
+void tru_smp_cpu1_start(void (*entry)(void));
+
+#endif
+
+#endif
+
+#endif
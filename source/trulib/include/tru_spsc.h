@@ -0,0 +1,119 @@
+/*
+	MIT License
+
+	Copyright (c) 2025 Truong Hy
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+
+	Version: 20261017
+
+	Lock-free single-producer single-consumer (SPSC) ring buffer.
+*/
+
+#ifndef TRU_SPSC_H
+#define TRU_SPSC_H
+
+#include "tru_config.h"
+
+#if(TRU_CPU_FAMILY == TRU_CPU_FAMILY_CORTEXA9)
+
+#include "tru_cortex_a9.h"
+#include "tru_cache.h"
+#include <stdint.h>
+#include <string.h>
+
+// Passes fixed size items from one producer to one consumer without locking or
+// masking interrupts, e.g. from an interrupt handler to a task.  The producer
+// only writes head and the consumer only writes tail, each index has a cache
+// line of its own so that the two sides don't bounce a line between them.
+// The indices are free running and wrap at 2^32, so the number of items must
+// be a power of 2.
+//
+// To avoid a notification per item, push tells the producer when the ring was
+// empty, which is the only time the consumer may be waiting.  The consumer
+// pops until the ring is empty before it waits, e.g. with FreeRTOS:
+//   ISR : if(tru_spsc_push(&ring, &item) == TRU_SPSC_PUSHED_FIRST) vTaskNotifyGiveFromISR(task, &woken);
+//   Task: if(tru_spsc_pop(&ring, items, n) == 0U) ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+typedef struct{
+	volatile uint32_t head __attribute__((aligned(CACHELINE_SIZE)));  // Written by the producer
+	volatile uint32_t tail __attribute__((aligned(CACHELINE_SIZE)));  // Written by the consumer
+	uint8_t *buf __attribute__((aligned(CACHELINE_SIZE)));
+	uint32_t mask;
+	uint32_t item_size;
+}tru_spsc_t;
+
+typedef enum{
+	TRU_SPSC_FULL,         // Not pushed
+	TRU_SPSC_PUSHED,       // Pushed
+	TRU_SPSC_PUSHED_FIRST  // Pushed into an empty ring, wake the consumer
+}tru_spsc_push_t;
+
+// buf holds count items of item_size bytes, count must be a power of 2
+void tru_spsc_init(tru_spsc_t *ring, void *buf, uint32_t count, uint32_t item_size);
+
+// Producer side
+static inline tru_spsc_push_t tru_spsc_push(tru_spsc_t *ring, const void *item){
+	uint32_t head = ring->head;
+
+	if(head - ring->tail > ring->mask) return TRU_SPSC_FULL;
+	__dmb();  // The consumer has finished reading the slot before it is overwritten
+
+	memcpy(&ring->buf[(head & ring->mask) * ring->item_size], item, ring->item_size);
+	__dmb();  // The item is written before it is published
+	ring->head = head + 1U;
+
+	// The barrier orders the store of head before the load of tail, and the
+	// consumer does the same with tail and head.  So either this sees that the
+	// consumer has emptied the ring, or the consumer sees this item before it
+	// waits
+	__dmb();
+	return (ring->tail == head) ? TRU_SPSC_PUSHED_FIRST : TRU_SPSC_PUSHED;
+}
+
+// Consumer side.  Pops up to max items into items, returns the number popped
+static inline uint32_t tru_spsc_pop(tru_spsc_t *ring, void *items, uint32_t max){
+	uint32_t tail = ring->tail;
+	uint32_t n = ring->head - tail;
+	uint32_t first;
+	uint32_t i;
+
+	if(n == 0U) return 0U;
+	if(n > max) n = max;
+	__dmb();  // The items are read after head
+
+	// Copied in at most two parts, up to the end of the buffer then from the start
+	i = tail & ring->mask;
+	first = ring->mask + 1U - i;
+	if(first > n) first = n;
+	memcpy(items, &ring->buf[i * ring->item_size], first * ring->item_size);
+	memcpy((uint8_t *)items + first * ring->item_size, ring->buf, (n - first) * ring->item_size);
+
+	__dmb();  // The items are read before their slots are released
+	ring->tail = tail + n;
+	__dmb();  // See tru_spsc_push()
+	return n;
+}
+
+static inline uint32_t tru_spsc_count(tru_spsc_t *ring){
+	return ring->head - ring->tail;
+}
+
+#endif
+
+#endif
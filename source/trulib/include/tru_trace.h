@@ -0,0 +1,140 @@
+/*
+	MIT License
+
+	Copyright (c) 2025 Truong Hy
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+
+	Version: 20261017
+
+	Binary event trace recorder, one 64-bit record per event in a RAM ring per CPU.
+*/
+
+#ifndef TRU_TRACE_H
+#define TRU_TRACE_H
+
+#include "tru_config.h"
+
+#if(TRU_CPU_FAMILY == TRU_CPU_FAMILY_CORTEXA9)
+
+#include "tru_cortex_a9.h"
+#include "tru_cache.h"
+#include <stdint.h>
+
+// Event types, the record layout is:
+//   bits 63..58: event type
+//   bits 57..40: argument, e.g. a task, queue or timer number, or interrupt ID
+//   bits 39..0 : low 40 bits of the global timer
+// At 200MHz the timestamp wraps every 91 minutes, the decoder unwraps it
+// backwards from the full timer value written by tru_trace_stop(), so there
+// must be an event at least that often
+typedef enum{
+	TRU_TRACE_TASK_CREATE = 1,
+	TRU_TRACE_TASK_IN,
+	TRU_TRACE_TASK_OUT,
+	TRU_TRACE_QUEUE_CREATE,
+	TRU_TRACE_QUEUE_SEND,
+	TRU_TRACE_QUEUE_SEND_FROM_ISR,
+	TRU_TRACE_QUEUE_RECEIVE,
+	TRU_TRACE_QUEUE_RECEIVE_FROM_ISR,
+	TRU_TRACE_ISR_ENTER,
+	TRU_TRACE_ISR_EXIT,
+	TRU_TRACE_TIMER_CREATE,
+	TRU_TRACE_TIMER_COMMAND,
+	TRU_TRACE_TIMER_EXPIRED,
+	TRU_TRACE_USER                      // Free for the application, arg is its own
+}tru_trace_event_t;
+
+#define TRU_TRACE_MAGIC       0x54525443U  // "TRTC"
+#define TRU_TRACE_RING_LENGTH 4096U        // Records per CPU, a power of 2
+#define TRU_TRACE_CPUS        2U
+#define TRU_TRACE_NAMES       64U          // Task names kept for the decoder
+#define TRU_TRACE_NAME_LEN    16U
+#define TRU_TRACE_ARG_MSK     0x3ffffU
+#define TRU_TRACE_TIME_MSK    0xffffffffffULL
+
+typedef struct{
+	volatile uint32_t head __attribute__((aligned(CACHELINE_SIZE)));  // Records written, free running
+	uint64_t buf[TRU_TRACE_RING_LENGTH] __attribute__((aligned(CACHELINE_SIZE)));
+}tru_trace_ring_t;
+
+// The whole recorder state, which is what is dumped for the decoder.  The
+// layout is read by scripts-generic/tru_trace_decode.py, keep them in step
+typedef struct{
+	uint32_t magic;
+	uint32_t ring_length;
+	uint32_t cpus;
+	uint32_t timer_hz;                    // Global timer frequency
+	uint64_t stop_time;                   // Global timer when stopped
+	volatile uint32_t enabled;
+	uint32_t next_id;                     // Last queue or timer number given out
+	char names[TRU_TRACE_NAMES][TRU_TRACE_NAME_LEN];  // Task names by number
+	tru_trace_ring_t ring[TRU_TRACE_CPUS];
+}tru_trace_t;
+
+extern tru_trace_t tru_trace;
+
+#if defined(TRU_TRACE) && TRU_TRACE == 1U
+
+void tru_trace_init(uint32_t timer_hz);
+void tru_trace_stop(void);
+uint32_t tru_trace_new_id(void);
+void tru_trace_task_create(uint32_t task, const char *name);
+
+// Writes a record to the ring of this CPU.  Each CPU only writes its own ring,
+// and IRQ is masked for the few instructions that take the timestamp and the
+// slot, so records are in time order without a lock.  The oldest records are
+// overwritten when the ring is full
+static inline void tru_trace_record(uint32_t event, uint32_t arg){
+	tru_trace_ring_t *ring;
+	uint32_t cpsr;
+	uint32_t mpidr;
+	uint32_t head;
+	uint64_t time;
+
+	if(!tru_trace.enabled) return;
+
+	__asm__ volatile(
+		"MRS   %0, cpsr                                      \n"
+		"CPSID i                                             \n"
+		: "=r" (cpsr) : : "memory"
+	);
+
+	__read_mpidr(mpidr);
+	ring = &tru_trace.ring[mpidr & 0x1U];
+	time = gtim_get_counter();
+	head = ring->head;
+	ring->buf[head & (TRU_TRACE_RING_LENGTH - 1U)] = (uint64_t)event << 58U | (uint64_t)(arg & TRU_TRACE_ARG_MSK) << 40U | (time & TRU_TRACE_TIME_MSK);
+	ring->head = head + 1U;
+
+	__asm__ volatile("MSR cpsr_c, %0" : : "r" (cpsr) : "memory");
+}
+
+#else
+
+static inline void tru_trace_record(uint32_t event, uint32_t arg){
+	(void)event;
+	(void)arg;
+}
+
+#endif
+
+#endif
+
+#endif
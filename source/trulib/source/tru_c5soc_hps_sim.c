@@ -0,0 +1,56 @@
+/*
+	MIT License
+
+	Copyright (c) 2025 Truong Hy
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+
+	Version: 20261017
+
+	Fake Cyclone V SoC HPS register blocks, see tru_c5soc_hps_sim.h.
+*/
+
+#include "tru_c5soc_hps_sim.h"
+
+#if defined(TRU_HPS_SIM) && TRU_HPS_SIM == 1U
+
+#include "tru_c5soc_hps_uart_ll.h"
+
+volatile uint32_t tru_hps_sim_rstmgr[TRU_HPS_SIM_BLOCK_WORDS];
+volatile uint32_t tru_hps_sim_gpio[3][TRU_HPS_SIM_BLOCK_WORDS];
+volatile uint32_t tru_hps_sim_uart[2][TRU_HPS_SIM_BLOCK_WORDS];
+
+// Clears the blocks and sets the reset values the low-level code depends on
+void tru_hps_sim_init(void){
+	uint32_t i;
+	uint32_t j;
+
+	for(i = 0U; i < TRU_HPS_SIM_BLOCK_WORDS; i++){
+		tru_hps_sim_rstmgr[i] = 0U;
+		for(j = 0U; j < 3U; j++) tru_hps_sim_gpio[j][i] = 0U;
+		for(j = 0U; j < 2U; j++) tru_hps_sim_uart[j][i] = 0U;
+	}
+
+	// The transmitter is always empty, so writes never wait
+	for(j = 0U; j < 2U; j++){
+		TRU_HPS_UART_REG(tru_hps_sim_uart[j])->lsr = TRU_HPS_UART_LSR_TEMT_SET_MSK | TRU_HPS_UART_LSR_THRE_SET_MSK;
+	}
+}
+
+#endif
@@ -0,0 +1,307 @@
+/*
+	MIT License
+
+	Copyright (c) 2025 Truong Hy
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+
+	Version: 20261017
+
+	Interrupt driven driver for the Cyclone V SoC HPS UART, see
+	tru_c5soc_hps_uart.h.
+*/
+
+#include "tru_c5soc_hps_uart.h"
+
+#if(TRU_TARGET == TRU_TARGET_C5SOC)
+
+#include "tru_cache.h"
+#include <stddef.h>
+
+// FIFO on with the transmit empty trigger at a quarter full, and the DMA
+// request at the same level.  The receive trigger is also at a quarter full.
+// FCR is write only, so all of it is written each time
+#define TRU_HPS_UART_FCR (TRU_HPS_UART_FCR_FIFOE_SET_MSK | TRU_HPS_UART_FCR_TET_QUARTER | TRU_HPS_UART_FCR_RT_QUARTER | TRU_HPS_UART_FCR_DMAM_SET_MSK)
+
+tru_hps_uart_t *tru_hps_uart_console;
+
+void tru_hps_uart_init(tru_hps_uart_t *uart, void *uart_base, uint8_t *buf, uint32_t size, tru_hps_uart_callback_t wait, tru_hps_uart_callback_t wake, void *context){
+	uart->reg = TRU_HPS_UART_REG(uart_base);
+	uart->buf = buf;
+	uart->mask = size - 1U;
+	uart->head = 0U;
+	uart->tail = 0U;
+	uart->waiters = 0U;
+	uart->lock = 0U;
+	uart->wait = wait;
+	uart->wake = wake;
+	uart->context = context;
+	uart->rx = NULL;
+	uart->read = NULL;
+	uart->rx_lock = 0U;
+	uart->rx_overruns = 0U;
+	uart->rx_dropped = 0U;
+#if defined(TRU_UART_TX_DMA) && TRU_UART_TX_DMA == 1U
+	uart->dma_busy = 0U;
+#endif
+
+	// The FIFOs are not reset, so bytes already written by the polled functions
+	// still go out
+	uart->reg->iir_fcr = TRU_HPS_UART_FCR;
+	uart->reg->ier_dlh = (uart->reg->ier_dlh & ~TRU_HPS_UART_IER_ETBEI_SET_MSK) | TRU_HPS_UART_IER_PTIME_SET_MSK;
+}
+
+// Moves bytes from the ring to the FIFO, up to the room given by the transmit
+// FIFO level, and enables the THRE interrupt while bytes are left.  Called with
+// the lock held
+static void tru_hps_uart_fill(tru_hps_uart_t *uart){
+	uint32_t room;
+
+#if defined(TRU_UART_TX_DMA) && TRU_UART_TX_DMA == 1U
+	if(uart->dma_busy){
+		uart->reg->ier_dlh &= ~TRU_HPS_UART_IER_ETBEI_SET_MSK;
+		return;
+	}
+#endif
+
+	room = TRU_HPS_UART_FIFO_DEPTH - uart->reg->tfl;
+
+	while(room && uart->tail != uart->head){
+		uart->reg->rbr_thr_dll = uart->buf[uart->tail & uart->mask];
+		uart->tail++;
+		room--;
+	}
+
+	if(uart->tail != uart->head){
+		uart->reg->ier_dlh |= TRU_HPS_UART_IER_ETBEI_SET_MSK;
+	}else{
+		uart->reg->ier_dlh &= ~TRU_HPS_UART_IER_ETBEI_SET_MSK;
+	}
+}
+
+// Empties the RX FIFO to the rx function.  A received data available or
+// character timeout interrupt is cleared once the FIFO is below the trigger
+static void tru_hps_uart_rx_drain(tru_hps_uart_t *uart){
+	uint8_t buf[TRU_HPS_UART_FIFO_DEPTH];
+	uint32_t cpsr;
+	uint32_t taken;
+	uint32_t n;
+
+	cpsr = tru_lock_irqsave(&uart->rx_lock);
+	n = uart->reg->rfl;
+	if(n){
+		for(uint32_t i = 0U; i < n; i++){
+			buf[i] = (uint8_t)uart->reg->rbr_thr_dll;
+		}
+		taken = uart->rx(uart, buf, n);
+		uart->rx_dropped += n - taken;
+	}
+	tru_unlock_irqrestore(&uart->rx_lock, cpsr);
+}
+
+void tru_hps_uart_isr(uint32_t icciar, void *context){
+	tru_hps_uart_t *uart = context;
+	uint32_t cpsr;
+	uint32_t wake;
+	uint32_t iid;
+
+	(void)icciar;
+
+	// Reading IIR clears a THRE interrupt, a busy detect is cleared by reading
+	// USR and a line status by reading LSR
+	iid = uart->reg->iir_fcr & TRU_HPS_UART_IIR_IID_MSK;
+	if(iid == TRU_HPS_UART_IIR_IID_BUSY) (void)uart->reg->usr;
+	if(iid == TRU_HPS_UART_IIR_IID_RLS && (uart->reg->lsr & TRU_HPS_UART_LSR_OE_SET_MSK)) uart->rx_overruns++;
+
+	if(uart->rx != NULL) tru_hps_uart_rx_drain(uart);
+
+	cpsr = tru_lock_irqsave(&uart->lock);
+	tru_hps_uart_fill(uart);
+	wake = (uart->waiters != 0U) && (uart->head - uart->tail <= (uart->mask + 1U) / 2U);
+	tru_unlock_irqrestore(&uart->lock, cpsr);
+
+	if(wake && uart->wake != NULL) uart->wake(uart);
+}
+
+uint32_t tru_hps_uart_write(tru_hps_uart_t *uart, const uint8_t *buf, uint32_t len, tru_hps_uart_wait_t wait){
+	uint32_t done = 0U;
+	uint32_t cpsr;
+	uint32_t n;
+
+	for(;;){
+		cpsr = tru_lock_irqsave(&uart->lock);
+
+		// Copy what fits
+		n = uart->mask + 1U - (uart->head - uart->tail);
+		if(n > len - done) n = len - done;
+		for(uint32_t i = 0U; i < n; i++){
+			uart->buf[uart->head & uart->mask] = buf[done + i];
+			uart->head++;
+		}
+		done += n;
+
+		tru_hps_uart_fill(uart);
+		if(done < len && wait == TRU_HPS_UART_WAIT && uart->wait != NULL) uart->waiters++;
+		tru_unlock_irqrestore(&uart->lock, cpsr);
+
+		if(done == len || wait == TRU_HPS_UART_NOWAIT) break;
+
+		// The ring is full, wait for the interrupt handler to make room, or
+		// poll for it with the next fill
+		if(uart->wait != NULL){
+			uart->wait(uart);
+
+			cpsr = tru_lock_irqsave(&uart->lock);
+			uart->waiters--;
+			tru_unlock_irqrestore(&uart->lock, cpsr);
+		}
+	}
+
+	return done;
+}
+
+void tru_hps_uart_poll(tru_hps_uart_t *uart){
+	uint32_t cpsr;
+
+	cpsr = tru_lock_irqsave(&uart->lock);
+	tru_hps_uart_fill(uart);
+	tru_unlock_irqrestore(&uart->lock, cpsr);
+}
+
+void tru_hps_uart_flush(tru_hps_uart_t *uart){
+	while(uart->tail != uart->head){
+		tru_hps_uart_poll(uart);
+	}
+	tru_hps_uart_ll_wait_empty((void *)uart->reg);
+}
+
+#if defined(TRU_UART_TX_DMA) && TRU_UART_TX_DMA == 1U
+
+void tru_hps_uart_dma_init(tru_hps_uart_t *uart, ALT_DMA_CHANNEL_t channel, ALT_DMA_EVENT_t event, tru_hps_uart_callback_t dma_wait, tru_hps_uart_callback_t dma_done){
+	uart->handle.location = (void *)uart->reg;
+	uart->handle.fcr = TRU_HPS_UART_FCR;
+	uart->channel = channel;
+	uart->event = event;
+	uart->periph = ((uintptr_t)uart->reg == TRU_HPS_UART1_BASE) ? ALT_DMA_PERIPH_UART1_TX : ALT_DMA_PERIPH_UART0_TX;
+	uart->dma_wait = dma_wait;
+	uart->dma_done = dma_done;
+}
+
+void tru_hps_uart_dma_isr(uint32_t icciar, void *context){
+	tru_hps_uart_t *uart = context;
+
+	(void)icciar;
+
+	alt_dma_int_clear(uart->event);
+	if(uart->dma_done != NULL) uart->dma_done(uart);
+}
+
+// Waits until the channel has stopped, it stops at the end of the program or
+// on a fault
+static bool tru_hps_uart_dma_wait(tru_hps_uart_t *uart){
+	ALT_DMA_CHANNEL_STATE_t state;
+
+	if(uart->dma_wait != NULL) uart->dma_wait(uart);
+	do{
+		alt_dma_channel_state_get(uart->channel, &state);
+	}while(state != ALT_DMA_CHANNEL_STATE_STOPPED && state != ALT_DMA_CHANNEL_STATE_FAULTING);
+
+	if(state == ALT_DMA_CHANNEL_STATE_FAULTING){
+		alt_dma_channel_kill(uart->channel);
+		return false;
+	}
+	return true;
+}
+
+bool tru_hps_uart_write_dma(tru_hps_uart_t *uart, const void *buf, uint32_t len){
+	const uint8_t *src = buf;
+	bool ok = true;
+	uint32_t empty;
+	uint32_t cpsr;
+	uint32_t n;
+
+	// Wait for the ring to empty, then hold it back
+	for(;;){
+		cpsr = tru_lock_irqsave(&uart->lock);
+		empty = (uart->tail == uart->head);
+		if(empty){
+			uart->dma_busy = 1U;
+		}else if(uart->wait != NULL){
+			uart->waiters++;
+		}
+		tru_unlock_irqrestore(&uart->lock, cpsr);
+
+		if(empty) break;
+
+		if(uart->wait != NULL){
+			uart->wait(uart);
+
+			cpsr = tru_lock_irqsave(&uart->lock);
+			uart->waiters--;
+			tru_unlock_irqrestore(&uart->lock, cpsr);
+		}else{
+			tru_hps_uart_poll(uart);
+		}
+	}
+
+	// The DMA reads SDRAM, not the caches
+	tru_l1_data_clean_range((void *)src, len);
+	tru_l2_data_clean_range((void *)src, len);
+
+	while(ok && len){
+		n = (len > TRU_HPS_UART_DMA_CHUNK) ? TRU_HPS_UART_DMA_CHUNK : len;
+		ok = (alt_dma_memory_to_periph(uart->channel, &uart->program, uart->periph, src, n, &uart->handle, true, uart->event) == ALT_E_SUCCESS);
+		if(ok) ok = tru_hps_uart_dma_wait(uart);
+		src += n;
+		len -= n;
+	}
+
+	// Hand the FIFO back to the ring
+	cpsr = tru_lock_irqsave(&uart->lock);
+	uart->dma_busy = 0U;
+	tru_hps_uart_fill(uart);
+	tru_unlock_irqrestore(&uart->lock, cpsr);
+
+	return ok;
+}
+
+#endif
+
+void tru_hps_uart_rx_init(tru_hps_uart_t *uart, tru_hps_uart_rx_callback_t rx, tru_hps_uart_read_callback_t read){
+	uart->read = read;
+	uart->rx = rx;
+
+	// Bytes already in the FIFO are kept, the first interrupt passes them on
+	uart->reg->ier_dlh |= TRU_HPS_UART_IER_ERBFI_SET_MSK | TRU_HPS_UART_IER_ELSI_SET_MSK;
+}
+
+void tru_hps_uart_rx_poll(tru_hps_uart_t *uart){
+	if(uart->rx != NULL) tru_hps_uart_rx_drain(uart);
+}
+
+void tru_hps_uart_stop(tru_hps_uart_t *uart){
+	tru_hps_uart_flush(uart);
+	if(tru_hps_uart_console == uart) tru_hps_uart_console = NULL;
+
+	uart->reg->ier_dlh &= ~(TRU_HPS_UART_IER_ERBFI_SET_MSK | TRU_HPS_UART_IER_ELSI_SET_MSK | TRU_HPS_UART_IER_ETBEI_SET_MSK | TRU_HPS_UART_IER_PTIME_SET_MSK);
+	uart->rx = NULL;
+	uart->reg->iir_fcr = TRU_HPS_UART_FCR_FIFOE_SET_MSK;
+}
+
+#endif
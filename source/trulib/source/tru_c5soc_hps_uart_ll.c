@@ -67,6 +67,17 @@ void tru_hps_uart_ll_write_str(void *uart_base, const char *str, uint32_t len){
 	}
 }
 
+// Same as tru_hps_uart_ll_write_str() but without the '\r' insertion, for binary data
+void tru_hps_uart_ll_write_bin(void *uart_base, const uint8_t *buf, uint32_t len){
+	// FIFO & threshold mode enabled?
+	char fifo_th_en = (TRU_HPS_UART_REG(uart_base)->sfe && TRU_HPS_UART_REG(uart_base)->stet) ? 1U : 0U;
+
+	for(uint32_t i = 0U; i < len; i++){
+		tru_hps_uart_ll_wait_ready(uart_base, fifo_th_en);
+		TRU_HPS_UART_REG(uart_base)->rbr_thr_dll = buf[i];
+	}
+}
+
 void tru_hps_uart_ll_write_char(void *uart_base, const char c){
 	// FIFO & threshold mode enabled?
 	char fifo_th_en = (TRU_HPS_UART_REG(uart_base)->sfe && TRU_HPS_UART_REG(uart_base)->stet) ? 1U : 0U;
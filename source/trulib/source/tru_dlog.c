@@ -0,0 +1,207 @@
+/*
+	MIT License
+
+	Copyright (c) 2025 Truong Hy
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+
+	Version: 20261017
+
+	Deferred binary logger, records a format string pointer, a timestamp and the
+	raw arguments in a RAM ring per CPU for a low priority task to send out.
+
+	Each record is sent to the console UART as a binary frame, which is decoded
+	on the host with scripts-generic/tru_dlog_decode.py and the ELF file of the
+	program, e.g.:
+		python3 tru_dlog_decode.py program.elf /dev/ttyUSB0
+
+	The frame layout, little endian:
+		byte 0     : 0x00 sync, text output never contains it
+		byte 1     : bits 7..4 CPU, bits 3..0 number of arguments n
+		bytes 2..5 : format string address, 0 for a dropped records report
+		bytes 6..13: global timer
+		4n bytes   : arguments
+		1 byte     : XOR of bytes 1 up to here
+	Text written by other code in between the frames is passed through by the
+	decoder.
+
+	With TRU_CFG_FRAME the records go on the framed transport instead, on their
+	own channel, see tru_frame.h.
+*/
+
+#include "tru_dlog.h"
+
+#if(TRU_CPU_FAMILY == TRU_CPU_FAMILY_CORTEXA9)
+
+#include "tru_c5soc_hps_uart_ll.h"
+#include "tru_c5soc_hps_uart.h"
+#include "tru_pl011_ll.h"
+#if defined(TRU_FRAME) && TRU_FRAME == 1U
+	#include "tru_frame.h"
+#endif
+#include <stdarg.h>
+#include <string.h>
+
+#define TRU_DLOG_SYNC      0x00U
+#define TRU_DLOG_FRAME_MAX (2U + 4U + 8U + TRU_DLOG_ARGS_MAX * 4U + 1U)
+
+static tru_dlog_rec_t tru_dlog_buf[TRU_DLOG_CPUS][TRU_DLOG_RING_LENGTH] __attribute__((aligned(CACHELINE_SIZE)));
+
+// Set up at build time, so that records can be made from the first instruction
+static tru_spsc_t tru_dlog_ring[TRU_DLOG_CPUS] = {
+	{ .buf = (uint8_t *)tru_dlog_buf[0], .mask = TRU_DLOG_RING_LENGTH - 1U, .item_size = sizeof(tru_dlog_rec_t) },
+	{ .buf = (uint8_t *)tru_dlog_buf[1], .mask = TRU_DLOG_RING_LENGTH - 1U, .item_size = sizeof(tru_dlog_rec_t) }
+};
+
+static volatile uint32_t tru_dlog_dropped[TRU_DLOG_CPUS];
+
+// Consumer state, only used by tru_dlog_drain()
+static tru_dlog_rec_t tru_dlog_next[TRU_DLOG_CPUS];  // The oldest record of each ring, taken out to merge them in time order
+static uint32_t tru_dlog_has_next[TRU_DLOG_CPUS];
+static uint32_t tru_dlog_reported[TRU_DLOG_CPUS];    // Dropped records already reported
+
+// Each CPU only pushes to its own ring, and IRQ is masked for the push, so each
+// ring has a single producer at a time and the SPSC ring needs no lock
+void tru_dlog_record(const char *fmt, uint32_t nargs, ...){
+	tru_dlog_rec_t rec;
+	va_list ap;
+	uint32_t cpsr;
+	uint32_t mpidr;
+	uint32_t cpu;
+	uint32_t i;
+
+	if(nargs <= TRU_DLOG_ARGS_MAX){
+		va_start(ap, nargs);
+		for(i = 0U; i < nargs; i++){
+			rec.arg[i] = va_arg(ap, uint32_t);
+		}
+		va_end(ap);
+	}
+	rec.fmt = fmt;
+
+	__asm__ volatile(
+		"MRS   %0, cpsr                                      \n"
+		"CPSID i                                             \n"
+		: "=r" (cpsr) : : "memory"
+	);
+
+	__read_mpidr(mpidr);
+	cpu = mpidr & 0x1U;
+	rec.cpu_nargs = cpu << 4U | nargs;
+	rec.time = gtim_get_counter();
+	if(nargs > TRU_DLOG_ARGS_MAX || tru_spsc_push(&tru_dlog_ring[cpu], &rec) == TRU_SPSC_FULL) tru_dlog_dropped[cpu]++;
+
+	__asm__ volatile("MSR cpsr_c, %0" : : "r" (cpsr) : "memory");
+}
+
+// Writes to the console UART, the same one as _write() in tru_newlib_ext.c, but
+// without the '\r' insertion
+static void tru_dlog_write(const uint8_t *buf, uint32_t len){
+#if(TRU_TARGET == TRU_TARGET_C5SOC)
+	if(tru_hps_uart_console != NULL){
+		tru_hps_uart_write(tru_hps_uart_console, buf, len, TRU_HPS_UART_WAIT);
+		return;
+	}
+
+	#if TRU_BOARD == TRU_BOARD_VEXPA9
+		tru_pl011_ll_write_bin((void *)TRU_BOARD_UART0_BASE, buf, len);
+	#elif defined(TRU_PRINT_UART0) && TRU_PRINT_UART0 == 1U
+		tru_hps_uart_ll_write_bin((void *)TRU_HPS_UART0_BASE, buf, len);
+	#elif defined(TRU_PRINT_UART1) && TRU_PRINT_UART1 == 1U
+		tru_hps_uart_ll_write_bin((void *)TRU_HPS_UART1_BASE, buf, len);
+	#else
+		(void)buf;
+		(void)len;
+	#endif
+#else
+	(void)buf;
+	(void)len;
+#endif
+}
+
+static void tru_dlog_send(const tru_dlog_rec_t *rec){
+	uint8_t frame[TRU_DLOG_FRAME_MAX];
+	uint32_t nargs = rec->cpu_nargs & 0xfU;
+	uint32_t fmt = (uint32_t)(uintptr_t)rec->fmt;
+	uint32_t len = 0U;
+	uint8_t check = 0U;
+	uint32_t i;
+
+	frame[len++] = TRU_DLOG_SYNC;
+	frame[len++] = (uint8_t)rec->cpu_nargs;
+	memcpy(&frame[len], &fmt, 4U);
+	len += 4U;
+	memcpy(&frame[len], &rec->time, 8U);
+	len += 8U;
+	memcpy(&frame[len], rec->arg, nargs * 4U);
+	len += nargs * 4U;
+	for(i = 1U; i < len; i++){
+		check ^= frame[i];
+	}
+	frame[len++] = check;
+
+#if defined(TRU_FRAME) && TRU_FRAME == 1U
+	// The transport has its own delimiter and CRC, so without the sync and check bytes
+	if(tru_frame_console != NULL){
+		tru_frame_send(tru_frame_console, TRU_FRAME_CH_DLOG, &frame[1], len - 2U);
+		return;
+	}
+#endif
+
+	tru_dlog_write(frame, len);
+}
+
+// Sends the records of both rings to the console UART in time order, until
+// they are empty.  It waits for the UART, so call it from a low priority task.
+// Returns the number of records sent
+uint32_t tru_dlog_drain(void){
+	tru_dlog_rec_t drop;
+	uint32_t dropped;
+	uint32_t oldest;
+	uint32_t sent = 0U;
+	uint32_t c;
+
+	for(;;){
+		oldest = TRU_DLOG_CPUS;
+		for(c = 0U; c < TRU_DLOG_CPUS; c++){
+			// Report records dropped since the last report
+			dropped = tru_dlog_dropped[c];
+			if(dropped != tru_dlog_reported[c]){
+				drop.fmt = NULL;
+				drop.cpu_nargs = c << 4U | 1U;
+				drop.time = gtim_get_counter();
+				drop.arg[0] = dropped - tru_dlog_reported[c];
+				tru_dlog_send(&drop);
+				tru_dlog_reported[c] = dropped;
+			}
+
+			if(!tru_dlog_has_next[c]) tru_dlog_has_next[c] = tru_spsc_pop(&tru_dlog_ring[c], &tru_dlog_next[c], 1U);
+			if(tru_dlog_has_next[c] && (oldest == TRU_DLOG_CPUS || tru_dlog_next[c].time < tru_dlog_next[oldest].time)) oldest = c;
+		}
+		if(oldest == TRU_DLOG_CPUS) break;
+
+		tru_dlog_send(&tru_dlog_next[oldest]);
+		tru_dlog_has_next[oldest] = 0U;
+		sent++;
+	}
+
+	return sent;
+}
+
+#endif
@@ -31,6 +31,8 @@
 #if(TRU_TARGET == TRU_TARGET_C5SOC)
 
 #include "tru_logger.h"
+#include "tru_c5soc_hps_uart.h"
+#include <stddef.h>
 
 #if defined(TRU_EXIT_TO_UBOOT) && TRU_EXIT_TO_UBOOT == 1U
 
@@ -102,6 +104,7 @@ void __attribute__((naked)) etu(int rc){
 
 // Override newlib _exit()
 void __attribute__((noreturn)) _exit(int status){
+	if(tru_hps_uart_console != NULL) tru_hps_uart_stop(tru_hps_uart_console);  // U-Boot polls the UART
 	etu(status);
 	while(1);
 }
@@ -110,7 +113,8 @@ void __attribute__((noreturn)) _exit(int status){
 
 // Override newlib _exit()
 void __attribute__((noreturn)) _exit(int status){
-	LOG("Starting infinity loop\n");
+	LOG_SYNC("Starting infinity loop\n");  // The deferred logger task will never run again
+	if(tru_hps_uart_console != NULL) tru_hps_uart_flush(tru_hps_uart_console);  // Interrupts may be off from here on
 	while(1);
 }
 
@@ -0,0 +1,403 @@
+/*
+	MIT License
+
+	Copyright (c) 2025 Truong Hy
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+
+	Version: 20261017
+
+	Small printf style formatter for logging, see tru_fmt.h.
+*/
+
+#include "tru_fmt.h"
+
+#if(TRU_CPU_FAMILY == TRU_CPU_FAMILY_CORTEXA9)
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define TRU_FMT_LEFT  0x01U  // -
+#define TRU_FMT_ZERO  0x02U  // 0
+#define TRU_FMT_PLUS  0x04U  // +
+#define TRU_FMT_SPACE 0x08U  // space
+#define TRU_FMT_ALT   0x10U  // #
+#define TRU_FMT_UPPER 0x20U  // %X %F
+
+#define TRU_FMT_PREC_MAX_F 9U
+
+// Long enough for a 64-bit octal number, or a %f of 20 digits, a point and 9 decimals
+#define TRU_FMT_DIGITS_MAX 32U
+
+typedef struct{
+	uint32_t flags;
+	int width;
+	int prec;      // -1 when not given
+}tru_fmt_spec_t;
+
+static const uint32_t tru_fmt_pow10[TRU_FMT_PREC_MAX_F + 1U] = {
+	1U, 10U, 100U, 1000U, 10000U, 100000U, 1000000U, 10000000U, 100000000U, 1000000000U
+};
+
+// Provided by tru_newlib_ext.c or by the semihosting library
+int _write(int fd, char *ptr, int len);
+
+static void tru_fmt_putc(tru_fmt_out_t *out, char c){
+	if(out->pos == out->size && out->flush != NULL) out->flush(out);
+	if(out->pos < out->size) out->buf[out->pos++] = c;
+	out->count++;
+}
+
+static void tru_fmt_repeat(tru_fmt_out_t *out, char c, int n){
+	while(n-- > 0) tru_fmt_putc(out, c);
+}
+
+// Writes a field: the prefix (sign or 0x), zeros, then the digits, padded to
+// the width with spaces or, with the 0 flag, more zeros after the prefix
+static void tru_fmt_field(tru_fmt_out_t *out, const tru_fmt_spec_t *spec, const char *prefix, int prefix_len, int zeros, const char *digits, int len){
+	int pad = spec->width - prefix_len - zeros - len;
+	int i;
+
+	if(!(spec->flags & TRU_FMT_LEFT) && !(spec->flags & TRU_FMT_ZERO)) tru_fmt_repeat(out, ' ', pad);
+	for(i = 0; i < prefix_len; i++) tru_fmt_putc(out, prefix[i]);
+	if(!(spec->flags & TRU_FMT_LEFT) && (spec->flags & TRU_FMT_ZERO)) tru_fmt_repeat(out, '0', pad);
+	tru_fmt_repeat(out, '0', zeros);
+	for(i = 0; i < len; i++) tru_fmt_putc(out, digits[i]);
+	if(spec->flags & TRU_FMT_LEFT) tru_fmt_repeat(out, ' ', pad);
+}
+
+// Writes the digits of value in base 8, 10 or 16 at the end of buf, returns
+// the first.  32-bit values avoid the 64-bit division helper
+static char *tru_fmt_utoa(char *end, unsigned long long value, uint32_t base, bool upper){
+	const char *hex = upper ? "0123456789ABCDEF" : "0123456789abcdef";
+	char *p = end;
+	uint32_t v32;
+
+	if(base == 10U){
+		while(value > UINT32_MAX){
+			*--p = (char)('0' + value % 10U);
+			value /= 10U;
+		}
+		v32 = (uint32_t)value;
+		do{
+			*--p = (char)('0' + v32 % 10U);
+			v32 /= 10U;
+		}while(v32);
+	}else{
+		uint32_t shift = (base == 16U) ? 4U : 3U;
+
+		do{
+			*--p = hex[value & (base - 1U)];
+			value >>= shift;
+		}while(value);
+	}
+
+	return p;
+}
+
+static void tru_fmt_integer(tru_fmt_out_t *out, tru_fmt_spec_t *spec, unsigned long long value, bool negative, uint32_t base){
+	char digits[TRU_FMT_DIGITS_MAX];
+	char prefix[2];
+	int prefix_len = 0;
+	int zeros = 0;
+	char *p;
+	int len;
+
+	p = tru_fmt_utoa(&digits[TRU_FMT_DIGITS_MAX], value, base, spec->flags & TRU_FMT_UPPER);
+	len = (int)(&digits[TRU_FMT_DIGITS_MAX] - p);
+
+	// A precision is the minimum number of digits, 0 prints nothing for 0, and
+	// turns off the 0 flag
+	if(spec->prec >= 0){
+		spec->flags &= ~TRU_FMT_ZERO;
+		if(spec->prec == 0 && value == 0U) len = 0;
+		if(spec->prec > len) zeros = spec->prec - len;
+	}
+
+	if(negative){
+		prefix[prefix_len++] = '-';
+	}else if(base == 10U && (spec->flags & TRU_FMT_PLUS)){
+		prefix[prefix_len++] = '+';
+	}else if(base == 10U && (spec->flags & TRU_FMT_SPACE)){
+		prefix[prefix_len++] = ' ';
+	}else if((spec->flags & TRU_FMT_ALT) && base == 16U && value != 0U){
+		prefix[prefix_len++] = '0';
+		prefix[prefix_len++] = (spec->flags & TRU_FMT_UPPER) ? 'X' : 'x';
+	}else if((spec->flags & TRU_FMT_ALT) && base == 8U && zeros == 0 && (len == 0 || *p != '0')){
+		zeros = 1;
+	}
+
+	tru_fmt_field(out, spec, prefix, prefix_len, zeros, p, len);
+}
+
+// Fixed point notation from the integer and fraction parts, rounded to the
+// precision
+static void tru_fmt_fixed(tru_fmt_out_t *out, tru_fmt_spec_t *spec, double value){
+	char digits[TRU_FMT_DIGITS_MAX];
+	char *end = &digits[TRU_FMT_DIGITS_MAX];
+	char *p = end;
+	char prefix[1];
+	int prefix_len = 0;
+	const char *word;
+	unsigned long long ipart;
+	uint32_t fpart;
+	uint32_t prec;
+	double frac;
+
+	prec = (spec->prec < 0) ? 6U : (uint32_t)spec->prec;
+	if(prec > TRU_FMT_PREC_MAX_F) prec = TRU_FMT_PREC_MAX_F;
+
+	if(value < 0.0){
+		prefix[prefix_len++] = '-';
+		value = -value;
+	}else if(spec->flags & TRU_FMT_PLUS){
+		prefix[prefix_len++] = '+';
+	}else if(spec->flags & TRU_FMT_SPACE){
+		prefix[prefix_len++] = ' ';
+	}
+
+	// NaN, infinity and values beyond 64 bits are words, not zero padded
+	if(value != value || value >= 18446744073709551616.0){
+		spec->flags &= ~TRU_FMT_ZERO;
+		if(value != value){
+			word = (spec->flags & TRU_FMT_UPPER) ? "NAN" : "nan";
+		}else if(value - value != 0.0){
+			word = (spec->flags & TRU_FMT_UPPER) ? "INF" : "inf";
+		}else{
+			word = (spec->flags & TRU_FMT_UPPER) ? "OVF" : "ovf";
+		}
+		tru_fmt_field(out, spec, prefix, prefix_len, 0, word, 3);
+		return;
+	}
+
+	// Rounded half up.  printf() rounds a value exactly half way to even, but
+	// the scaled fraction can't tell those from values just either side
+	ipart = (unsigned long long)value;
+	frac = (value - (double)ipart) * (double)tru_fmt_pow10[prec] + 0.5;
+	fpart = (uint32_t)frac;
+	if(fpart >= tru_fmt_pow10[prec]){
+		fpart -= tru_fmt_pow10[prec];
+		ipart++;
+	}
+
+	if(prec){
+		for(uint32_t i = 0U; i < prec; i++){
+			*--p = (char)('0' + fpart % 10U);
+			fpart /= 10U;
+		}
+	}
+	if(prec || (spec->flags & TRU_FMT_ALT)) *--p = '.';
+	p = tru_fmt_utoa(p, ipart, 10U, false);
+
+	tru_fmt_field(out, spec, prefix, prefix_len, 0, p, (int)(end - p));
+}
+
+size_t tru_fmt_vformat(tru_fmt_out_t *out, const char *fmt, va_list ap){
+	size_t start = out->count;
+	tru_fmt_spec_t spec;
+	unsigned long long u;
+	long long s;
+	const char *str;
+	char length;
+	char c;
+	int n;
+
+	while((c = *fmt++) != '\0'){
+		if(c != '%'){
+			tru_fmt_putc(out, c);
+			continue;
+		}
+
+		// Flags
+		spec.flags = 0U;
+		for(;;){
+			c = *fmt;
+			if(c == '-') spec.flags |= TRU_FMT_LEFT;
+			else if(c == '0') spec.flags |= TRU_FMT_ZERO;
+			else if(c == '+') spec.flags |= TRU_FMT_PLUS;
+			else if(c == ' ') spec.flags |= TRU_FMT_SPACE;
+			else if(c == '#') spec.flags |= TRU_FMT_ALT;
+			else break;
+			fmt++;
+		}
+
+		// Width, a negative * is the - flag
+		spec.width = 0;
+		if(*fmt == '*'){
+			spec.width = va_arg(ap, int);
+			if(spec.width < 0){
+				spec.flags |= TRU_FMT_LEFT;
+				spec.width = -spec.width;
+			}
+			fmt++;
+		}else{
+			while(*fmt >= '0' && *fmt <= '9') spec.width = spec.width * 10 + (*fmt++ - '0');
+		}
+
+		// Precision, a negative * is as if not given
+		spec.prec = -1;
+		if(*fmt == '.'){
+			fmt++;
+			if(*fmt == '*'){
+				spec.prec = va_arg(ap, int);
+				if(spec.prec < 0) spec.prec = -1;
+				fmt++;
+			}else{
+				spec.prec = 0;
+				while(*fmt >= '0' && *fmt <= '9') spec.prec = spec.prec * 10 + (*fmt++ - '0');
+			}
+		}
+
+		// Size, H and Q stand for hh and ll
+		length = '\0';
+		if(*fmt == 'h' || *fmt == 'l' || *fmt == 'j' || *fmt == 'z' || *fmt == 't' || *fmt == 'L'){
+			length = *fmt++;
+			if(length == 'h' && *fmt == 'h'){
+				length = 'H';
+				fmt++;
+			}else if(length == 'l' && *fmt == 'l'){
+				length = 'Q';
+				fmt++;
+			}
+		}
+
+		c = *fmt++;
+		if(c >= 'A' && c <= 'Z') spec.flags |= TRU_FMT_UPPER;
+		switch(c){
+			case 'd':
+			case 'i':
+				if(length == 'Q' || length == 'j') s = va_arg(ap, long long);
+				else if(length == 'l') s = va_arg(ap, long);
+				else if(length == 'z' || length == 't') s = va_arg(ap, ptrdiff_t);
+				else s = va_arg(ap, int);
+				if(length == 'h') s = (short)s;
+				else if(length == 'H') s = (signed char)s;
+				u = (s < 0) ? 0ULL - (unsigned long long)s : (unsigned long long)s;
+				tru_fmt_integer(out, &spec, u, s < 0, 10U);
+				break;
+
+			case 'u':
+			case 'x':
+			case 'X':
+			case 'o':
+				if(length == 'Q' || length == 'j') u = va_arg(ap, unsigned long long);
+				else if(length == 'l') u = va_arg(ap, unsigned long);
+				else if(length == 'z' || length == 't') u = va_arg(ap, size_t);
+				else u = va_arg(ap, unsigned int);
+				if(length == 'h') u = (unsigned short)u;
+				else if(length == 'H') u = (unsigned char)u;
+				tru_fmt_integer(out, &spec, u, false, (c == 'u') ? 10U : (c == 'o') ? 8U : 16U);
+				break;
+
+			case 'p':
+				spec.flags |= TRU_FMT_ALT;
+				tru_fmt_integer(out, &spec, (uintptr_t)va_arg(ap, void *), false, 16U);
+				break;
+
+			case 'f':
+			case 'F':
+				tru_fmt_fixed(out, &spec, va_arg(ap, double));
+				break;
+
+			case 'c':
+				c = (char)va_arg(ap, int);
+				spec.flags &= ~TRU_FMT_ZERO;
+				tru_fmt_field(out, &spec, NULL, 0, 0, &c, 1);
+				break;
+
+			case 's':
+				str = va_arg(ap, const char *);
+				if(str == NULL) str = "(null)";
+				for(n = 0; str[n] != '\0' && (spec.prec < 0 || n < spec.prec); n++);
+				spec.flags &= ~TRU_FMT_ZERO;
+				tru_fmt_field(out, &spec, NULL, 0, 0, str, n);
+				break;
+
+			case '%':
+				tru_fmt_putc(out, '%');
+				break;
+
+			case '\0':
+				fmt--;  // A % at the end
+				tru_fmt_putc(out, '%');
+				break;
+
+			default:
+				tru_fmt_putc(out, '%');
+				tru_fmt_putc(out, c);
+				break;
+		}
+	}
+
+	return out->count - start;
+}
+
+int tru_fmt_vsnprintf(char *buf, size_t size, const char *fmt, va_list ap){
+	tru_fmt_out_t out = {
+		.buf = buf,
+		.size = size ? size - 1U : 0U,  // Room for the terminator
+		.pos = 0U,
+		.count = 0U,
+		.flush = NULL,
+		.context = NULL
+	};
+
+	tru_fmt_vformat(&out, fmt, ap);
+	if(size) buf[out.pos] = '\0';
+
+	return (int)out.count;
+}
+
+int tru_fmt_snprintf(char *buf, size_t size, const char *fmt, ...){
+	va_list ap;
+	int n;
+
+	va_start(ap, fmt);
+	n = tru_fmt_vsnprintf(buf, size, fmt, ap);
+	va_end(ap);
+
+	return n;
+}
+
+static void tru_fmt_dprintf_flush(tru_fmt_out_t *out){
+	_write((int)(intptr_t)out->context, out->buf, (int)out->pos);
+	out->pos = 0U;
+}
+
+int tru_fmt_dprintf(int fd, const char *fmt, ...){
+	char buf[TRU_FMT_DPRINTF_BUF];
+	tru_fmt_out_t out = {
+		.buf = buf,
+		.size = sizeof(buf),
+		.pos = 0U,
+		.count = 0U,
+		.flush = tru_fmt_dprintf_flush,
+		.context = (void *)(intptr_t)fd
+	};
+	va_list ap;
+
+	va_start(ap, fmt);
+	tru_fmt_vformat(&out, fmt, ap);
+	va_end(ap);
+	if(out.pos) tru_fmt_dprintf_flush(&out);
+
+	return (int)out.count;
+}
+
+#endif
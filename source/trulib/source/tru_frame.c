@@ -0,0 +1,227 @@
+/*
+	MIT License
+
+	Copyright (c) 2025 Truong Hy
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+
+	Version: 20261017
+
+	Framed transport over the console UART, see tru_frame.h for the format.
+*/
+
+#include "tru_frame.h"
+
+#if(TRU_CPU_FAMILY == TRU_CPU_FAMILY_CORTEXA9)
+
+#include <string.h>
+
+#define TRU_FRAME_RUN_MAX 254U  // Longest COBS block, code byte 0xff
+
+tru_frame_t *tru_frame_console = NULL;
+
+// CRC-32 a nibble at a time, a 64 byte table is a better fit for the cache
+// than the 1 KiB one of a byte at a time and the frames are short
+static const uint32_t tru_frame_crc_table[16] = {
+	0x00000000U, 0x1db71064U, 0x3b6e20c8U, 0x26d930acU,
+	0x76dc4190U, 0x6b6b51f4U, 0x4db26158U, 0x5005713cU,
+	0xedb88320U, 0xf00f9344U, 0xd6d6a3e8U, 0xcb61b38cU,
+	0x9b64c2b0U, 0x86d3d2d4U, 0xa00ae278U, 0xbdbdf21cU
+};
+
+uint32_t tru_frame_crc32(uint32_t crc, const void *buf, uint32_t len){
+	const uint8_t *p = buf;
+
+	crc = ~crc;
+	while(len--){
+		crc ^= *p++;
+		crc = (crc >> 4) ^ tru_frame_crc_table[crc & 0xfU];
+		crc = (crc >> 4) ^ tru_frame_crc_table[crc & 0xfU];
+	}
+
+	return ~crc;
+}
+
+void tru_frame_init(tru_frame_t *link, tru_frame_write_t write, tru_frame_callback_t lock, tru_frame_callback_t unlock, uint8_t *rx_buf, uint32_t rx_size, void *context){
+	memset(link, 0, sizeof(tru_frame_t));
+	link->write = write;
+	link->lock = lock;
+	link->unlock = unlock;
+	link->context = context;
+	link->rx_buf = rx_buf;
+	link->rx_size = rx_size;
+}
+
+void tru_frame_handler_set(tru_frame_t *link, uint32_t channel, tru_frame_handler_t handler){
+	if(channel < TRU_FRAME_CHANNELS) link->handler[channel] = handler;
+}
+
+// The frame is the list [channel][caller buffers...][CRC].  Each COBS block is
+// found by scanning ahead for a zero or 254 bytes, then its code byte is
+// written followed by the bytes themselves, straight from the buffers they are
+// in.  A block can span buffers
+void tru_frame_sendv(tru_frame_t *link, uint32_t channel, const tru_frame_iov_t *iov, uint32_t iov_count){
+	tru_frame_iov_t seg[TRU_FRAME_IOV_MAX + 2U];
+	uint8_t ch = (uint8_t)channel;
+	uint8_t crc_le[TRU_FRAME_CRC_SIZE];
+	uint8_t code;
+	uint32_t crc;
+	uint32_t n = 0U;
+	uint32_t s = 0U;
+	uint32_t off = 0U;
+
+	if(iov_count > TRU_FRAME_IOV_MAX) iov_count = TRU_FRAME_IOV_MAX;
+
+	seg[n].buf = &ch;
+	seg[n++].len = 1U;
+	crc = tru_frame_crc32(0U, &ch, 1U);
+	for(uint32_t i = 0U; i < iov_count; i++){
+		if(iov[i].len == 0U) continue;
+		seg[n++] = iov[i];
+		crc = tru_frame_crc32(crc, iov[i].buf, iov[i].len);
+	}
+	crc_le[0] = (uint8_t)crc;
+	crc_le[1] = (uint8_t)(crc >> 8);
+	crc_le[2] = (uint8_t)(crc >> 16);
+	crc_le[3] = (uint8_t)(crc >> 24);
+	seg[n].buf = crc_le;
+	seg[n++].len = TRU_FRAME_CRC_SIZE;
+
+	if(link->lock != NULL) link->lock(link);
+
+	for(;;){
+		uint32_t rs = s;
+		uint32_t ro = off;
+		uint32_t run = 0U;
+		bool zero = false;
+
+		// Length of the block
+		while(rs < n && run < TRU_FRAME_RUN_MAX){
+			if(ro == seg[rs].len){
+				rs++;
+				ro = 0U;
+				continue;
+			}
+			if(((const uint8_t *)seg[rs].buf)[ro] == 0x00U){
+				zero = true;
+				break;
+			}
+			run++;
+			ro++;
+		}
+
+		code = (uint8_t)(run + 1U);
+		link->write(link, &code, 1U);
+		while(run){
+			uint32_t chunk = seg[s].len - off;
+
+			if(chunk > run) chunk = run;
+			if(chunk){
+				link->write(link, (const uint8_t *)seg[s].buf + off, chunk);
+				off += chunk;
+				run -= chunk;
+			}
+			if(off == seg[s].len){
+				s++;
+				off = 0U;
+			}
+		}
+		while(s < n && off == seg[s].len){
+			s++;
+			off = 0U;
+		}
+
+		// The zero is implied by a code below 0xff, a full block at the end needs
+		// nothing after it
+		if(zero){
+			off++;
+		}else if(s == n){
+			break;
+		}
+	}
+
+	code = TRU_FRAME_DELIM;
+	link->write(link, &code, 1U);
+
+	if(link->unlock != NULL) link->unlock(link);
+}
+
+void tru_frame_send(tru_frame_t *link, uint32_t channel, const void *buf, uint32_t len){
+	tru_frame_iov_t iov = { .buf = buf, .len = len };
+
+	tru_frame_sendv(link, channel, &iov, 1U);
+}
+
+static void tru_frame_rx_end(tru_frame_t *link){
+	uint32_t len = link->rx_len;
+	uint32_t crc;
+
+	if(link->rx_code == 0U && !link->rx_drop) return;  // Delimiters in a row, not a frame
+
+	if(link->rx_drop || link->rx_left != 0U || len < 1U + TRU_FRAME_CRC_SIZE){
+		link->rx_errors++;
+		return;
+	}
+
+	len -= TRU_FRAME_CRC_SIZE;
+	crc = (uint32_t)link->rx_buf[len] | (uint32_t)link->rx_buf[len + 1U] << 8 | (uint32_t)link->rx_buf[len + 2U] << 16 | (uint32_t)link->rx_buf[len + 3U] << 24;
+	if(crc != tru_frame_crc32(0U, link->rx_buf, len)){
+		link->rx_errors++;
+		return;
+	}
+
+	link->rx_frames++;
+	if(link->rx_buf[0] < TRU_FRAME_CHANNELS && link->handler[link->rx_buf[0]] != NULL){
+		link->handler[link->rx_buf[0]](link, link->rx_buf[0], &link->rx_buf[1], len - 1U);
+	}
+}
+
+static inline void tru_frame_rx_put(tru_frame_t *link, uint8_t byte){
+	if(link->rx_len < link->rx_size){
+		link->rx_buf[link->rx_len++] = byte;
+	}else{
+		link->rx_drop = true;
+	}
+}
+
+void tru_frame_rx(tru_frame_t *link, const uint8_t *buf, uint32_t len){
+	for(uint32_t i = 0U; i < len; i++){
+		uint8_t byte = buf[i];
+
+		if(byte == TRU_FRAME_DELIM){
+			tru_frame_rx_end(link);
+			link->rx_len = 0U;
+			link->rx_left = 0U;
+			link->rx_code = 0U;
+			link->rx_drop = false;
+		}else if(link->rx_drop){
+			continue;
+		}else if(link->rx_left == 0U){
+			// A code byte, the block before it ended with a zero unless it was full
+			if(link->rx_code != 0U && link->rx_code < 0xffU) tru_frame_rx_put(link, 0x00U);
+			link->rx_code = byte;
+			link->rx_left = byte - 1U;
+		}else{
+			tru_frame_rx_put(link, byte);
+			link->rx_left--;
+		}
+	}
+}
+
+#endif
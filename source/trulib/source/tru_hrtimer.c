@@ -0,0 +1,204 @@
+/*
+	MIT License
+
+	Copyright (c) 2025 Truong Hy
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+
+	Version: 20261017
+
+	High resolution (microsecond) timer service for the Intel Cyclone V SoC (HPS).
+
+	References:
+		- Cyclone V SoC: Cyclone V Hard Processor System Technical Reference Manual. Notable refs: Timer, Reset Manager
+*/
+
+#include "tru_hrtimer.h"
+
+#if(TRU_TARGET == TRU_TARGET_C5SOC)
+
+#include "tru_cortex_a9.h"
+#include "tru_lock.h"
+#include "alt_clock_manager.h"
+#include "alt_globaltmr.h"
+#include "socal/hps.h"
+#include "socal/socal.h"
+#include "socal/alt_rstmgr.h"
+#include <stddef.h>
+
+static tru_hrtimer_t *tru_hrtimer_list;  // Active timers, sorted by expiry
+static uint32_t tru_hrtimer_gt_freq;     // Global timer frequency
+static uint32_t tru_hrtimer_sp_freq;     // SP timer frequency
+static uint64_t tru_hrtimer_slack;       // TRU_HRTIMER_SLACK_US in global timer counts
+
+static tru_spinlock_t tru_hrtimer_spinlock;
+
+// Inserts the timer into the list, after any with the same expiry
+static void tru_hrtimer_insert(tru_hrtimer_t *timer){
+	tru_hrtimer_t **link = &tru_hrtimer_list;
+
+	while(*link != NULL && (int64_t)((*link)->expiry - timer->expiry) <= 0){
+		link = &(*link)->next;
+	}
+	timer->next = *link;
+	*link = timer;
+	timer->active = 1U;
+}
+
+static void tru_hrtimer_remove(tru_hrtimer_t *timer){
+	tru_hrtimer_t **link = &tru_hrtimer_list;
+
+	while(*link != NULL){
+		if(*link == timer){
+			*link = timer->next;
+			break;
+		}
+		link = &(*link)->next;
+	}
+	timer->active = 0U;
+}
+
+// Sets the SP timer to interrupt at the expiry of the first timer.  The SP
+// timer counts are limited to 1 second, a later expiry takes more interrupts
+static void tru_hrtimer_program(uint64_t now){
+	uint64_t delta;
+	uint32_t count;
+
+	alt_gpt_tmr_stop(TRU_HRTIMER_GPT);
+	if(tru_hrtimer_list == NULL) return;
+
+	delta = ((int64_t)(tru_hrtimer_list->expiry - now) > 0) ? tru_hrtimer_list->expiry - now : 0U;
+	if(delta > tru_hrtimer_gt_freq) delta = tru_hrtimer_gt_freq;
+	count = (uint32_t)(delta * tru_hrtimer_sp_freq / tru_hrtimer_gt_freq);
+	if(count == 0U) count = 1U;
+
+	alt_gpt_counter_set(TRU_HRTIMER_GPT, count);
+	alt_gpt_tmr_start(TRU_HRTIMER_GPT);
+}
+
+void tru_hrtimer_init(void){
+	alt_freq_t freq;
+
+	tru_hrtimer_list = NULL;
+
+	alt_clk_freq_get(ALT_CLK_MPU_PERIPH, &freq);
+	tru_hrtimer_gt_freq = freq / (alt_globaltmr_prescaler_get() + 1U);
+	alt_clk_freq_get(ALT_CLK_L4_SP, &freq);
+	tru_hrtimer_sp_freq = freq;
+	tru_hrtimer_slack = tru_hrtimer_us_to_counts(TRU_HRTIMER_SLACK_US);
+
+	// The global timer is the time base, this leaves its counter untouched if
+	// it is already running
+	alt_globaltmr_start();
+
+	// Release only this SP timer from reset, alt_gpt_all_tmr_init() would reset
+	// all the OSC1 and SP timers
+	alt_clrbits_word(ALT_RSTMGR_PERMODRST_ADDR, ALT_RSTMGR_PERMODRST_SPTMR1_SET_MSK);
+
+	alt_gpt_tmr_stop(TRU_HRTIMER_GPT);
+	alt_gpt_mode_set(TRU_HRTIMER_GPT, ALT_GPT_RESTART_MODE_ONESHOT);
+	alt_gpt_int_clear_pending(TRU_HRTIMER_GPT);
+	alt_gpt_int_enable(TRU_HRTIMER_GPT);
+}
+
+// Calls the callbacks of the expired timers, then sets the SP timer for the
+// next expiry.  The lock is not held during a callback, so it may start or
+// stop any timer, including its own
+void tru_hrtimer_isr(uint32_t icciar, void *context){
+	tru_hrtimer_t *timer;
+	uint64_t now;
+	uint32_t cpsr;
+	(void)icciar;
+	(void)context;
+
+	alt_gpt_int_clear_pending(TRU_HRTIMER_GPT);
+
+	cpsr = tru_lock_irqsave(&tru_hrtimer_spinlock);
+	now = gtim_get_counter();
+	while(tru_hrtimer_list != NULL && (int64_t)(tru_hrtimer_list->expiry - now) <= (int64_t)tru_hrtimer_slack){
+		timer = tru_hrtimer_list;
+		tru_hrtimer_list = timer->next;
+		timer->active = 0U;
+
+		if(timer->period){
+			// Periodic timers keep their phase.  Expiries that were missed or
+			// are within the slack are skipped, the callback is called once, so
+			// the timer is never due again in this loop
+			timer->expiry += timer->period;
+			if((int64_t)(timer->expiry - now) <= (int64_t)tru_hrtimer_slack){
+				timer->expiry += ((now + tru_hrtimer_slack - timer->expiry) / timer->period + 1U) * timer->period;
+			}
+			tru_hrtimer_insert(timer);
+		}
+
+		tru_unlock_irqrestore(&tru_hrtimer_spinlock, cpsr);
+		timer->callback(timer, timer->context);
+		cpsr = tru_lock_irqsave(&tru_hrtimer_spinlock);
+		now = gtim_get_counter();
+	}
+	tru_hrtimer_program(now);
+	tru_unlock_irqrestore(&tru_hrtimer_spinlock, cpsr);
+}
+
+void tru_hrtimer_create(tru_hrtimer_t *timer, tru_hrtimer_callback_t callback, void *context){
+	timer->expiry = 0U;
+	timer->period = 0U;
+	timer->callback = callback;
+	timer->context = context;
+	timer->next = NULL;
+	timer->active = 0U;
+}
+
+void tru_hrtimer_start(tru_hrtimer_t *timer, uint32_t delay_us, uint32_t period_us){
+	uint64_t now;
+	uint32_t cpsr;
+
+	cpsr = tru_lock_irqsave(&tru_hrtimer_spinlock);
+	if(timer->active) tru_hrtimer_remove(timer);
+
+	// A period within the slack would be due again as soon as it is called
+	if(period_us != 0U && period_us <= TRU_HRTIMER_SLACK_US) period_us = TRU_HRTIMER_PERIOD_MIN_US;
+
+	now = gtim_get_counter();
+	timer->expiry = now + tru_hrtimer_us_to_counts(delay_us);
+	timer->period = tru_hrtimer_us_to_counts(period_us);
+	tru_hrtimer_insert(timer);
+
+	// Only a new first timer changes the SP timer
+	if(tru_hrtimer_list == timer) tru_hrtimer_program(now);
+	tru_unlock_irqrestore(&tru_hrtimer_spinlock, cpsr);
+}
+
+void tru_hrtimer_stop(tru_hrtimer_t *timer){
+	uint32_t cpsr;
+
+	cpsr = tru_lock_irqsave(&tru_hrtimer_spinlock);
+	if(timer->active) tru_hrtimer_remove(timer);
+	tru_unlock_irqrestore(&tru_hrtimer_spinlock, cpsr);
+}
+
+uint64_t tru_hrtimer_now(void){
+	return gtim_get_counter();
+}
+
+uint64_t tru_hrtimer_us_to_counts(uint32_t us){
+	return (uint64_t)us * tru_hrtimer_gt_freq / 1000000U;
+}
+
+#endif
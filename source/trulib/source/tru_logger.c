@@ -0,0 +1,50 @@
+/*
+	MIT License
+
+	Copyright (c) 2025 Truong Hy
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+
+	Version: 20261017
+
+	Run time thresholds of the levelled logging, see tru_logger.h.
+*/
+
+#include "tru_logger.h"
+
+#if defined(TRU_LOG) && TRU_LOG == 1U
+
+// A byte per module, the levelled macros load their entry and compare it
+uint8_t tru_log_level[TRU_LOG_MODULES] = { [0 ... TRU_LOG_MODULES - 1U] = TRU_LOG_LEVEL_RUN };
+
+void tru_log_level_set(uint32_t module, uint32_t level){
+	uint32_t i;
+
+	if(level > TRU_LOG_LEVEL_DEBUG) level = TRU_LOG_LEVEL_DEBUG;
+
+	if(module < TRU_LOG_MODULES){
+		tru_log_level[module] = (uint8_t)level;
+	}else{
+		for(i = 0U; i < TRU_LOG_MODULES; i++){
+			tru_log_level[i] = (uint8_t)level;
+		}
+	}
+}
+
+#endif
@@ -0,0 +1,133 @@
+/*
+	MIT License
+
+	Copyright (c) 2025 Truong Hy
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+
+	Version: 20261017
+
+	Fixed size block memory pool, for passing messages without copying them.
+*/
+
+#include "tru_mpool.h"
+
+#if(TRU_CPU_FAMILY == TRU_CPU_FAMILY_CORTEXA9)
+
+#include <stddef.h>
+
+void tru_mpool_init(tru_mpool_t *pool, void *buf, uint32_t block_size, uint32_t block_count){
+	tru_mpool_block_t *block;
+	uint32_t i;
+
+	pool->lock = 0U;
+	pool->buf = buf;
+	pool->block_size = TRU_MPOOL_BLOCK_SIZE(block_size);
+	pool->block_count = block_count;
+	pool->used = 0U;
+	pool->high_water = 0U;
+	pool->alloc_fails = 0U;
+	pool->free_fails = 0U;
+
+	// The bitmap follows the blocks, all of them start free
+	pool->map = (uint32_t *)&pool->buf[pool->block_size * block_count];
+	for(i = 0U; i < TRU_MPOOL_MAP_SIZE(block_count) / 4U; i++){
+		pool->map[i] = 0U;
+	}
+
+	// Link the blocks in address order, so the first allocations are
+	// contiguous
+	pool->free_list = NULL;
+	for(i = block_count; i > 0U; i--){
+		block = (tru_mpool_block_t *)&pool->buf[(i - 1U) * pool->block_size];
+		block->next = pool->free_list;
+		pool->free_list = block;
+	}
+}
+
+void *tru_mpool_alloc(tru_mpool_t *pool){
+	tru_mpool_block_t *block;
+	uint32_t index;
+	uint32_t cpsr;
+
+	cpsr = tru_lock_irqsave(&pool->lock);
+	block = pool->free_list;
+	if(block != NULL){
+		pool->free_list = block->next;
+		index = (uint32_t)((uint8_t *)block - pool->buf) / pool->block_size;
+		pool->map[index / 32U] |= 1UL << (index % 32U);
+		pool->used++;
+		if(pool->used > pool->high_water) pool->high_water = pool->used;
+	}else{
+		pool->alloc_fails++;
+	}
+	tru_unlock_irqrestore(&pool->lock, cpsr);
+
+	return block;
+}
+
+bool tru_mpool_free(tru_mpool_t *pool, void *block){
+	uint32_t offset = (uint32_t)((uint8_t *)block - pool->buf);
+	uint32_t index = offset / pool->block_size;
+	uint32_t bit = 1UL << (index % 32U);
+	bool ok;
+	uint32_t cpsr;
+
+	cpsr = tru_lock_irqsave(&pool->lock);
+	// Also rejects a pointer below buf, the subtraction wraps to a large
+	// offset.  A block that is not allocated has its bit clear, which also
+	// keeps used from wrapping
+	ok = offset < pool->block_size * pool->block_count && offset % pool->block_size == 0U && (pool->map[index / 32U] & bit);
+	if(ok){
+		pool->map[index / 32U] &= ~bit;
+		((tru_mpool_block_t *)block)->next = pool->free_list;
+		pool->free_list = block;
+		pool->used--;
+	}else{
+		pool->free_fails++;
+	}
+	tru_unlock_irqrestore(&pool->lock, cpsr);
+
+	return ok;
+}
+
+void tru_mpool_get_stats(tru_mpool_t *pool, tru_mpool_stats_t *stats){
+	uint32_t cpsr;
+
+	cpsr = tru_lock_irqsave(&pool->lock);
+	stats->block_size = pool->block_size;
+	stats->block_count = pool->block_count;
+	stats->used = pool->used;
+	stats->high_water = pool->high_water;
+	stats->alloc_fails = pool->alloc_fails;
+	stats->free_fails = pool->free_fails;
+	tru_unlock_irqrestore(&pool->lock, cpsr);
+}
+
+// Restarts the high water mark from the blocks allocated now, e.g. at the
+// start of a measurement
+void tru_mpool_reset_high_water(tru_mpool_t *pool){
+	uint32_t cpsr;
+
+	cpsr = tru_lock_irqsave(&pool->lock);
+	pool->high_water = pool->used;
+	tru_unlock_irqrestore(&pool->lock, cpsr);
+}
+
+#endif
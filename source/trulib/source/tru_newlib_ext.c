@@ -21,7 +21,7 @@
 	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 	SOFTWARE.
 
-	Version: 20250405
+	Version: 20261017
 
 	Minimal implementation of required newlib function stubs.
 */
@@ -32,6 +32,11 @@
 
 #if (defined(TRU_PRINT_UART0) && TRU_PRINT_UART0 == 1U) || (defined(TRU_PRINT_UART1) && TRU_PRINT_UART1 == 1U)
 	#include "tru_c5soc_hps_uart_ll.h"
+	#include "tru_c5soc_hps_uart.h"
+	#include "tru_pl011_ll.h"
+	#if defined(TRU_FRAME) && TRU_FRAME == 1U
+		#include "tru_frame.h"
+	#endif
 #endif
 
 #include <errno.h>
@@ -76,12 +81,63 @@
 		}
 
 		int _read(int fd, char *ptr, int len){
+			int n;
+
+			// The console UART when the application has given it a read function,
+			// which blocks until there is at least 1 byte, see tru_c5soc_hps_uart.h
+			if(tru_hps_uart_console != NULL && tru_hps_uart_console->read != NULL && len > 0){
+				n = (int)tru_hps_uart_console->read(tru_hps_uart_console, (uint8_t *)ptr, (uint32_t)len);
+
+				#if defined(TRU_LOG_RN) && TRU_LOG_RN == 1U
+					// A terminal sends '\r' for the enter key, turn it into the '\n' that fgets() looks for
+					for(int i = 0; i < n; i++){
+						if(ptr[i] == '\r') ptr[i] = '\n';
+					}
+				#endif
+
+				return n;
+			}
+
 			errno = EIO;  // Input/output error
 			return -1;  // Too complicated to implement read for TTY, return error
 		}
 
+		// Queues to the interrupt driven console UART, with a '\r' inserted before each '\n' if enabled
+		static void tru_console_write(char *ptr, int len){
+			#if defined(TRU_LOG_RN) && TRU_LOG_RN == 1U
+				int start = 0;
+
+				for(int i = 0; i < len; i++){
+					if(ptr[i] == '\n'){
+						tru_hps_uart_write(tru_hps_uart_console, (const uint8_t *)&ptr[start], (uint32_t)(i - start), TRU_HPS_UART_WAIT);
+						tru_hps_uart_write(tru_hps_uart_console, (const uint8_t *)"\r", 1U, TRU_HPS_UART_WAIT);
+						start = i;  // The '\n' goes with the next part
+					}
+				}
+				tru_hps_uart_write(tru_hps_uart_console, (const uint8_t *)&ptr[start], (uint32_t)(len - start), TRU_HPS_UART_WAIT);
+			#else
+				tru_hps_uart_write(tru_hps_uart_console, (const uint8_t *)ptr, (uint32_t)len, TRU_HPS_UART_WAIT);
+			#endif
+		}
+
 		int _write(int fd, char *ptr, int len){
-			#if TRU_PRINT_UART0 == 1U
+			#if defined(TRU_FRAME) && TRU_FRAME == 1U
+				// Framed, the host client prints the text, see tru_frame.h
+				if(tru_frame_console != NULL){
+					tru_frame_send(tru_frame_console, TRU_FRAME_CH_LOG, ptr, (uint32_t)len);
+					return len;
+				}
+			#endif
+
+			// The interrupt driven driver once the application has set it up, see tru_c5soc_hps_uart.h
+			if(tru_hps_uart_console != NULL){
+				tru_console_write(ptr, len);
+				return len;
+			}
+
+			#if TRU_BOARD == TRU_BOARD_VEXPA9
+				tru_pl011_ll_write_str((void *)TRU_BOARD_UART0_BASE, ptr, len);  // Re-target to the PL011, the QEMU vexpress-a9 has no HPS UART
+			#elif TRU_PRINT_UART0 == 1U
 				tru_hps_uart_ll_write_str((void *)TRU_HPS_UART0_BASE, ptr, len);  // Re-target to UART controller
 			#elif TRU_PRINT_UART1 == 1U
 				tru_hps_uart_ll_write_str((void *)TRU_HPS_UART1_BASE, ptr, len);  // Re-target to UART controller
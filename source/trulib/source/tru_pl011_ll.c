@@ -0,0 +1,75 @@
+/*
+	MIT License
+
+	Copyright (c) 2025 Truong Hy
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+
+	Version: 20261017
+
+	Low-level code for the Arm PrimeCell UART (PL011), see tru_pl011_ll.h.
+*/
+
+#include "tru_pl011_ll.h"
+
+#if(TRU_TARGET == TRU_TARGET_C5SOC) && (TRU_BOARD == TRU_BOARD_VEXPA9)
+
+// Enables the transmitter and receiver, with the FIFOs and line settings left at reset, i.e. 8N1 with no FIFO
+void tru_pl011_ll_init(void *uart_base){
+	TRU_PL011_REG(uart_base)->cr = TRU_PL011_CR_UARTEN_MSK | TRU_PL011_CR_TXE_MSK | TRU_PL011_CR_RXE_MSK;
+}
+
+// Blocking wait until all pending data has gone out
+void tru_pl011_ll_wait_empty(void *uart_base){
+	while(TRU_PL011_REG(uart_base)->fr & TRU_PL011_FR_BUSY_MSK);
+}
+
+static void tru_pl011_ll_wait_ready(void *uart_base){
+	while(TRU_PL011_REG(uart_base)->fr & TRU_PL011_FR_TXFF_MSK);  // Wait while the transmit FIFO (or holding register) is full
+}
+
+void tru_pl011_ll_write_str(void *uart_base, const char *str, uint32_t len){
+	// Write input bytes to UART controller, one at a time
+	for(uint32_t i = 0U; i < len; i++){
+		tru_pl011_ll_write_char(uart_base, str[i]);
+	}
+}
+
+// Same as tru_pl011_ll_write_str() but without the '\r' insertion, for binary data
+void tru_pl011_ll_write_bin(void *uart_base, const uint8_t *buf, uint32_t len){
+	for(uint32_t i = 0U; i < len; i++){
+		tru_pl011_ll_wait_ready(uart_base);
+		TRU_PL011_REG(uart_base)->dr = buf[i];
+	}
+}
+
+void tru_pl011_ll_write_char(void *uart_base, const char c){
+	// For each '\n' character insert '\r'?
+	#if defined(TRU_LOG_RN) && TRU_LOG_RN == 1U
+		if(c == '\n'){
+			tru_pl011_ll_wait_ready(uart_base);
+			TRU_PL011_REG(uart_base)->dr = '\r';
+		}
+	#endif
+
+	tru_pl011_ll_wait_ready(uart_base);
+	TRU_PL011_REG(uart_base)->dr = (uint32_t)(unsigned char)c;  // Write a single character to the transmit FIFO
+}
+
+#endif
@@ -0,0 +1,200 @@
+/*
+	MIT License
+
+	Copyright (c) 2025 Truong Hy
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+
+	Version: 20261017
+
+	Cortex-A9 performance monitor (PMU), counts per task.
+
+	The PMU of each CPU is set up by tru_pmu_init() and then runs freely.  The
+	counts are made per task by the FreeRTOS task switch hooks (see
+	FreeRTOSConfig.h): tru_pmu_switch_in() saves the counters of the CPU and
+	tru_pmu_switch_out() adds what they counted since then to the totals of the
+	task.  A task's totals are read with tru_pmu_task_get(), which includes the
+	current period when the task is running on the calling CPU, so a task can
+	measure a piece of its own code even if it moves between CPUs.  Interrupt
+	handlers are counted in the task they interrupt.
+
+	The counters are 32-bit, the overflow flags correct for one wrap between a
+	switch in and out.  The cycle counter runs at the CPU clock, so a task that
+	runs for over 5 seconds at 800MHz without a task switch loses counts.
+
+	Event counting in the secure state, which is how this program runs, needs
+	SDER.SUNIDEN set, so tru_pmu_init() sets it.
+*/
+
+#include "tru_pmu.h"
+
+#if(TRU_CPU_FAMILY == TRU_CPU_FAMILY_CORTEXA9)
+
+#if defined(TRU_PMU) && TRU_PMU == 1U
+
+#include "tru_cache.h"
+#include "tru_lock.h"
+#include <stddef.h>
+
+#define PMCNT_ALL_MSK     (PMCNT_CYCLES_MSK | ((1U << TRU_PMU_COUNTERS) - 1U))
+
+// Counter values when the current task of a CPU was switched in
+typedef struct{
+	uint32_t task;                        // Task number, 0 for none
+	uint32_t cycles;
+	uint32_t event[TRU_PMU_COUNTERS];
+}__attribute__((aligned(CACHELINE_SIZE))) tru_pmu_cpu_t;
+
+static tru_pmu_cpu_t tru_pmu_cpu[2];
+static tru_pmu_counters_t tru_pmu_tasks[TRU_PMU_TASKS];
+static uint32_t tru_pmu_events[TRU_PMU_COUNTERS];
+static tru_spinlock_t tru_pmu_spinlock;
+
+static inline tru_pmu_cpu_t *tru_pmu_this_cpu(void){
+	uint32_t mpidr;
+
+	__read_mpidr(mpidr);
+	return &tru_pmu_cpu[mpidr & 0x1U];
+}
+
+static void tru_pmu_read(uint32_t *cycles, uint32_t *event){
+	uint32_t i;
+
+	__read_pmccntr(*cycles);
+	for(i = 0U; i < TRU_PMU_COUNTERS; i++){
+		__write_pmselr(i);
+		__isb();
+		__read_pmxevcntr(event[i]);
+	}
+}
+
+// Counts from start to now, the overflow flag means the counter wrapped once
+static inline uint64_t tru_pmu_elapsed(uint32_t start, uint32_t now, uint32_t overflow){
+	uint64_t elapsed = (uint32_t)(now - start);
+
+	// A wrap to below start is already in the 32-bit difference
+	if(overflow && now >= start) elapsed += 1ULL << 32U;
+
+	return elapsed;
+}
+
+// Adds the counts since the switch in to counters
+static void tru_pmu_add_elapsed(const tru_pmu_cpu_t *cpu, tru_pmu_counters_t *counters){
+	uint32_t cycles;
+	uint32_t event[TRU_PMU_COUNTERS];
+	uint32_t overflow;
+	uint32_t i;
+
+	tru_pmu_read(&cycles, event);
+	__read_pmovsr(overflow);
+
+	counters->cycles += tru_pmu_elapsed(cpu->cycles, cycles, overflow & PMCNT_CYCLES_MSK);
+	for(i = 0U; i < TRU_PMU_COUNTERS; i++){
+		counters->event[i] += tru_pmu_elapsed(cpu->event[i], event[i], overflow & (1U << i));
+	}
+}
+
+// Sets up and starts the PMU of the calling CPU, so it is called on each CPU.
+// events is TRU_PMU_COUNTERS events for the event counters, or NULL for
+// TRU_PMU_DEFAULT_EVENTS
+void tru_pmu_init(const uint32_t *events){
+	static const uint32_t default_events[TRU_PMU_COUNTERS] = TRU_PMU_DEFAULT_EVENTS;
+	tru_pmu_cpu_t *cpu = tru_pmu_this_cpu();
+	uint32_t reg;
+	uint32_t i;
+
+	if(events == NULL) events = default_events;
+
+	__read_sder(reg);
+	__write_sder(reg | SDER_SUNIDEN_MSK);
+
+	__write_pmcntenclr(PMCNT_ALL_MSK);
+	__write_pmintenclr(PMCNT_ALL_MSK);
+
+	for(i = 0U; i < TRU_PMU_COUNTERS; i++){
+		tru_pmu_events[i] = events[i];
+		__write_pmselr(i);
+		__isb();
+		__write_pmxevtyper(events[i]);
+	}
+
+	__read_pmcr(reg);
+	__write_pmcr((reg & ~PMCR_D_MSK) | PMCR_E_MSK | PMCR_P_MSK | PMCR_C_MSK);
+	__write_pmovsr(PMCNT_ALL_MSK);
+	__write_pmcntenset(PMCNT_ALL_MSK);
+	__isb();
+
+	cpu->task = 0U;
+}
+
+// The event counted by an event counter, as set by tru_pmu_init()
+uint32_t tru_pmu_event_get(uint32_t counter){
+	return (counter < TRU_PMU_COUNTERS) ? tru_pmu_events[counter] : 0U;
+}
+
+// Called by the task switch hooks with IRQ masked
+void tru_pmu_switch_in(uint32_t task){
+	tru_pmu_cpu_t *cpu = tru_pmu_this_cpu();
+
+	// Read before clearing the flags, a wrap in between is then below start
+	tru_pmu_read(&cpu->cycles, cpu->event);
+	__write_pmovsr(PMCNT_ALL_MSK);
+	cpu->task = task;
+}
+
+void tru_pmu_switch_out(uint32_t task){
+	tru_pmu_cpu_t *cpu = tru_pmu_this_cpu();
+	uint32_t cpsr;
+
+	// The first task of CPU1 is started without a switch in
+	if(cpu->task != task) return;
+	cpu->task = 0U;
+
+	if(task < TRU_PMU_TASKS){
+		cpsr = tru_lock_irqsave(&tru_pmu_spinlock);
+		tru_pmu_add_elapsed(cpu, &tru_pmu_tasks[task]);
+		tru_unlock_irqrestore(&tru_pmu_spinlock, cpsr);
+	}
+}
+
+// Totals of a task since it was created, the FreeRTOS task number is from
+// vTaskGetInfo() or uxTaskGetSystemState().  Tasks numbered TRU_PMU_TASKS
+// and above are not counted and read as 0
+void tru_pmu_task_get(uint32_t task, tru_pmu_counters_t *counters){
+	tru_pmu_cpu_t *cpu;
+	uint32_t cpsr;
+	uint32_t i;
+
+	if(task >= TRU_PMU_TASKS){
+		counters->cycles = 0U;
+		for(i = 0U; i < TRU_PMU_COUNTERS; i++) counters->event[i] = 0U;
+		return;
+	}
+
+	// IRQ is masked by the lock, so the calling task stays on this CPU
+	cpsr = tru_lock_irqsave(&tru_pmu_spinlock);
+	*counters = tru_pmu_tasks[task];
+	cpu = tru_pmu_this_cpu();
+	if(cpu->task == task) tru_pmu_add_elapsed(cpu, counters);
+	tru_unlock_irqrestore(&tru_pmu_spinlock, cpsr);
+}
+
+#endif
+
+#endif
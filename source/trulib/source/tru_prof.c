@@ -0,0 +1,187 @@
+/*
+	MIT License
+
+	Copyright (c) 2025 Truong Hy
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+
+	Version: 20261017
+
+	Statistical PC sampling profiler for the Intel Cyclone V SoC (HPS).
+
+	The private watchdog of each CPU runs in timer mode at a fixed rate,
+	independent of the RTOS tick.  Its interrupt handler passes the
+	interrupted PC and LR, and a context such as the running task, to
+	tru_prof_sample(), which counts them in a histogram of that CPU.  Nothing
+	is halted, so the timing of the program is only changed by the short
+	interrupt.  Pick a rate that is not a multiple of the tick rate, or the
+	samples fall in step with the tick.
+
+	tru_prof_print() writes the histogram out as text, which
+	scripts-generic/tru_prof_symbolise.py turns into function names and
+	flame graph input using the ELF file.  The tru_prof structure can also be
+	dumped with the debugger.
+
+	References:
+		- Cortex-A9 MPCore Technical Reference Manual: Private timer and watchdog registers
+*/
+
+#include "tru_prof.h"
+
+#if(TRU_TARGET == TRU_TARGET_C5SOC)
+
+#include "tru_cortex_a9.h"
+#include "tru_logger.h"
+#include "alt_clock_manager.h"
+#include "alt_watchdog.h"
+#include "socal/hps.h"
+#include "socal/socal.h"
+#include "socal/alt_rstmgr.h"
+
+// Defined in alt_watchdog.c without a prototype in alt_watchdog.h
+extern void alt_ARM_wdog_gpt_mode_set(void);
+
+tru_prof_t tru_prof;
+
+#if defined(TRU_PROF) && TRU_PROF == 1U
+
+bool tru_prof_init(uint32_t rate_hz){
+	alt_freq_t freq;
+
+	// The watchdog counts the peripheral base clock, the same as the global timer
+	alt_clk_freq_get(ALT_CLK_MPU_PERIPH, &freq);
+	if(rate_hz == 0U || rate_hz > freq) return false;
+
+	tru_prof.magic = TRU_PROF_MAGIC;
+	tru_prof.entries = TRU_PROF_ENTRIES;
+	tru_prof.cpus = TRU_PROF_CPUS;
+	tru_prof.rate_hz = rate_hz;
+
+	// Release the private watchdogs from reset, alt_wdog_init() would also
+	// reset the L4 watchdogs
+	alt_clrbits_word(ALT_RSTMGR_MPUMODRST_ADDR, ALT_RSTMGR_MPUMODRST_WDS_SET_MSK);
+
+	alt_ARM_wdog_gpt_mode_set();
+	alt_wdog_stop(ALT_WDOG_CPU);
+	alt_wdog_core_prescaler_set(0U);
+	alt_wdog_counter_set(ALT_WDOG_CPU, freq / rate_hz - 1U);
+	alt_wdog_response_mode_set(ALT_WDOG_CPU, ALT_WDOG_TIMER_MODE_FREERUN);
+	alt_wdog_int_clear(ALT_WDOG_CPU);
+	alt_wdog_int_enable(ALT_WDOG_CPU);
+	alt_wdog_start(ALT_WDOG_CPU);
+
+	tru_prof.enabled = 1U;
+
+	return true;
+}
+
+// Called by the TRU_PROF_IRQ handler, on the CPU that is sampled.  The
+// histogram of a CPU is only written here, and this interrupt does not nest
+// with itself, so there is no lock
+void tru_prof_sample(uint32_t pc, uint32_t lr, uint32_t context){
+	tru_prof_cpu_t *cpu;
+	tru_prof_entry_t *entry;
+	uint32_t mpidr;
+	uint32_t hash;
+	uint32_t i;
+
+	alt_wdog_int_clear(ALT_WDOG_CPU);
+	if(!tru_prof.enabled) return;
+
+	__read_mpidr(mpidr);
+	cpu = &tru_prof.cpu[mpidr & 0x1U];
+	cpu->samples++;
+
+	// Fibonacci hashing, linear probing
+	hash = ((pc >> 2U) ^ lr ^ context) * 0x9e3779b1U >> (32U - TRU_PROF_ENTRIES_LOG2);
+	for(i = 0U; i < TRU_PROF_PROBES; i++){
+		entry = &cpu->table[(hash + i) & (TRU_PROF_ENTRIES - 1U)];
+		if(entry->count == 0U){
+			entry->pc = pc;
+			entry->lr = lr;
+			entry->context = context;
+			entry->count = 1U;
+			return;
+		}
+		if(entry->pc == pc && entry->lr == lr && entry->context == context){
+			entry->count++;
+			return;
+		}
+	}
+
+	cpu->dropped++;
+}
+
+void tru_prof_start(void){
+	__dmb();
+	tru_prof.enabled = 1U;
+}
+
+void tru_prof_stop(void){
+	tru_prof.enabled = 0U;
+	__dmb();
+}
+
+// Empties the histograms, call it with the profiler stopped
+void tru_prof_clear(void){
+	tru_prof_cpu_t *cpu;
+	uint32_t c;
+	uint32_t i;
+
+	for(c = 0U; c < TRU_PROF_CPUS; c++){
+		cpu = &tru_prof.cpu[c];
+		cpu->samples = 0U;
+		cpu->dropped = 0U;
+		for(i = 0U; i < TRU_PROF_ENTRIES; i++){
+			cpu->table[i].count = 0U;
+		}
+	}
+}
+
+// Prints the histograms as lines of:
+//   PROF <cpu> <context> <lr> <pc> <count>
+// which is read by scripts-generic/tru_prof_symbolise.py.  Sampling is
+// paused meanwhile.  The lines are written synchronously, there are too many
+// for the deferred logger
+void tru_prof_print(void){
+	const tru_prof_entry_t *entry;
+	uint32_t enabled = tru_prof.enabled;
+	uint32_t c;
+	uint32_t i;
+
+	tru_prof_stop();
+
+	LOG_SYNC("PROF rate %lu\n", (unsigned long)tru_prof.rate_hz);
+	for(c = 0U; c < TRU_PROF_CPUS; c++){
+		LOG_SYNC("PROF cpu %lu samples %lu dropped %lu\n", (unsigned long)c, (unsigned long)tru_prof.cpu[c].samples, (unsigned long)tru_prof.cpu[c].dropped);
+		for(i = 0U; i < TRU_PROF_ENTRIES; i++){
+			entry = &tru_prof.cpu[c].table[i];
+			if(entry->count != 0U){
+				LOG_SYNC("PROF %lu %08lx %08lx %08lx %lu\n", (unsigned long)c, (unsigned long)entry->context, (unsigned long)entry->lr, (unsigned long)entry->pc, (unsigned long)entry->count);
+			}
+		}
+	}
+	LOG_SYNC("PROF end\n");
+
+	if(enabled) tru_prof_start();
+}
+
+#endif
+
+#endif
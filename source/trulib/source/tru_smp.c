@@ -0,0 +1,93 @@
+/*
+	MIT License
+
+	Copyright (c) 2025 Truong Hy
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+
+	Version: 20261017
+
+	Dual CPU (SMP) support for the Intel Cyclone V SoC (HPS), ARM Cortex-A9 MPCore.
+
+	References:
+		- Cyclone V SoC: Cyclone V Hard Processor System Technical Reference Manual. Notable refs: Reset Manager, MPU Module Reset Register (mpumodrst)
+*/
+
+#include "tru_smp.h"
+
+#if(TRU_TARGET == TRU_TARGET_C5SOC)
+
+#if defined(TRU_SMP) && TRU_SMP == 1U
+
+#include "tru_c5soc_hps_ll.h"
+#include "tru_cortex_a9.h"
+#include "tru_cache.h"
+#include "tru_util_ll.h"
+
+// Trampoline at the CPU1 reset address.  "LDR pc, [pc, #-4]" loads the word
+// that follows it, which is the address of Reset_Handler
+#define TRU_SMP_TRAMPOLINE_LDR_PC 0xe51ff004U
+#define TRU_SMP_TRAMPOLINE_SIZE   8U
+
+// MMU translation table, see tru_startup.c
+#define TRU_SMP_MMU_TBL_SIZE      (4096U * 4U)
+
+extern uint32_t c5soc_mmu_tbl[];
+void Reset_Handler(void);
+
+// Entry of CPU1 after its startup, read by Reset_Handler_CPU1
+void (*volatile tru_smp_cpu1_entry)(void);
+
+void tru_smp_cpu1_start(void (*entry)(void)){
+	uint32_t vbar;
+
+	tru_smp_cpu1_entry = entry;
+
+	// CPU1 starts executing at address 0 when it is released from reset.  When
+	// this program is linked at address 0 the vector table is already there and
+	// its reset vector jumps to Reset_Handler, otherwise place a trampoline
+	// there that jumps to Reset_Handler.  Note, 0x0 is written with assembly
+	// because the compiler treats a null pointer dereference as undefined
+	__read_vbar(vbar);
+	if(vbar != TRU_HPS_RAM_BASE){
+		__asm__ volatile(
+			"STR %0, [%2, #0]                                    \n"
+			"STR %1, [%2, #4]                                    \n"
+			:
+			: "r" (TRU_SMP_TRAMPOLINE_LDR_PC), "r" ((uint32_t)Reset_Handler), "r" (TRU_HPS_RAM_BASE)
+			: "memory"
+		);
+	}
+
+	// CPU1 starts with its MMU and caches off, so everything it reads before
+	// they are on must be in memory: the trampoline, the entry and the MMU table
+	tru_l1_data_clean_range((void *)TRU_HPS_RAM_BASE, TRU_SMP_TRAMPOLINE_SIZE);
+	tru_l1_data_clean_range((void *)&tru_smp_cpu1_entry, sizeof(tru_smp_cpu1_entry));
+	tru_l1_data_clean_range(c5soc_mmu_tbl, TRU_SMP_MMU_TBL_SIZE);
+	tru_l2_data_clean_range((void *)TRU_HPS_RAM_BASE, TRU_SMP_TRAMPOLINE_SIZE);
+	tru_l2_data_clean_range((void *)&tru_smp_cpu1_entry, sizeof(tru_smp_cpu1_entry));
+	tru_l2_data_clean_range(c5soc_mmu_tbl, TRU_SMP_MMU_TBL_SIZE);
+
+	// Release CPU1 from reset
+	tru_iom_wr32((uint32_t *)TRU_HPS_RSTMGR_MPUMODRST, tru_iom_rd32((uint32_t *)TRU_HPS_RSTMGR_MPUMODRST) & ~TRU_HPS_RSTMGR_MPUMODRST_CPU1_SET_MSK);
+}
+
+#endif
+
+#endif
@@ -24,6 +24,7 @@
 	Version: 20250405
 
 	Bare-metal C startup initialisations for the Intel Cyclone V SoC (HPS), ARM Cortex-A9.
+	The board addresses are in tru_board.h, which also supports the QEMU vexpress-a9.
 	My own standalone init functions.
 
 	References:
@@ -39,10 +40,15 @@
 #if defined(TRU_STARTUP) && TRU_STARTUP == 1U
 
 #include "tru_cortex_a9.h"
+#include "tru_board.h"
 #include "alt_interrupt.h"
 #include "tru_mmu.h"
 #include <stdint.h>
 
+// Turns a define into a string for the assembly below
+#define TRU_STARTUP_STR(x)  #x
+#define TRU_STARTUP_XSTR(x) TRU_STARTUP_STR(x)
+
 #if defined(ALT_INT_PROVISION_VECTOR_SUPPORT) && ALT_INT_PROVISION_VECTOR_SUPPORT == 0U
 	// Exception & interrupt handler supporting CMSIS
 	void Default_Handler(void);
@@ -103,12 +109,12 @@ void __attribute__((naked)) Reset_Handler(RESET_ARGS){
 		// Constants
 		// =========
 
-		// Arm MPCORE peripheral (private memory region) registers.  Only the peripheral base address is vendor specific, the offsets are the same for all other vendors
-		".set PERIPH_BASE, 0xfffec000UL                     \n"  // This same address can also be determined from the coprocessor register: MRC p15, 4, r0, c15, c0, 0
+		// Arm MPCORE peripheral (private memory region) registers.  Only the peripheral base address is vendor specific, the offsets are the same for all other vendors, see tru_board.h
+		".set PERIPH_BASE, " TRU_STARTUP_XSTR(TRU_BOARD_PERIPH_BASE) "\n"  // This same address can also be determined from the coprocessor register: MRC p15, 4, r0, c15, c0, 0
 		".set SCU_BASE,    (PERIPH_BASE + 0x0000U)          \n"
 
-		// Arm CoreLink™ Level 2 Cache Controller L2C-310 registers.  Only the L2 base register is vendor specific, the offsets are the same for all other vendors
-		".set L2_BASE,                0xfffef000UL          \n"
+		// Arm CoreLink™ Level 2 Cache Controller L2C-310 registers.  Only the L2 base register is vendor specific, the offsets are the same for all other vendors, see tru_board.h
+		".set L2_BASE,                " TRU_STARTUP_XSTR(TRU_BOARD_L2C310_BASE) "\n"
 		".set L2_REG1_CTRL,           (L2_BASE + 0x100U)    \n"
 		".set L2_REG1_AUX_CTRL,       (L2_BASE + 0x104U)    \n"
 		".set L2_REG1_TAGRAM_CTRL,    (L2_BASE + 0x108U)    \n"
@@ -120,11 +126,19 @@ void __attribute__((naked)) Reset_Handler(RESET_ARGS){
 		".set L2_REG7_CACHE_SYNC,     (L2_BASE + 0x730U)    \n"
 		".set L2_REG7_INV_WAY,        (L2_BASE + 0x77cU)    \n"
 		// Latency is vendor specific
-		".set L2_TAG_LATENCY,         0x0U                  \n"
-		".set L2_DATA_LATENCY,        0x10U                 \n"
+		".set L2_TAG_LATENCY,         " TRU_STARTUP_XSTR(TRU_BOARD_L2C310_TAGRAM_LATENCY) "\n"
+		".set L2_DATA_LATENCY,        " TRU_STARTUP_XSTR(TRU_BOARD_L2C310_DATARAM_LATENCY) "\n"
 
 		"CPSID if                                           \n"  // Mask interrupts
 
+#if defined(TRU_SMP) && TRU_SMP == 1U
+		// CPU1 is released from reset by tru_smp_cpu1_start() after CPU0 has
+		// initialised everything shared, it only needs to initialise itself
+		"MRC p15, 0, r3, c0, c0, 5                          \n"  // Read MPIDR
+		"ANDS r3, r3, #3                                    \n"  // CPU ID
+		"BNE Reset_Handler_CPU1                             \n"
+#endif
+
 #if defined(TRU_EXIT_TO_UBOOT) && TRU_EXIT_TO_UBOOT == 1U
 		// Save U-Boot argc
 		"LDR r3, =uboot_argc                                \n"
@@ -491,6 +505,152 @@ void __attribute__((naked)) Reset_Handler(RESET_ARGS){
 	);
 }
 
+#if defined(TRU_SMP) && TRU_SMP == 1U
+// ====================
+// CPU1 startup handler
+// ====================
+
+// Notes:
+// - CPU0 has already initialised the L2 cache, SCU and the MMU table, and they are shared with CPU1
+// - SMP coherency is enabled before the MMU and L1 cache, as required for the L1 data cache to be coherent
+// - The entry function is set by tru_smp_cpu1_start(), see tru_smp.c
+void __attribute__((naked)) Reset_Handler_CPU1(void){
+	__asm__ volatile(
+		"CPSID if                                           \n"  // Mask interrupts
+
+		// Switch into secure access mode
+		"MRC p15, 0, r0, c1, c1, 2                          \n"  // Read NSACR (Non-secure Access Control Register)
+		"ORR r0, r0, #(0x3 << 20)                           \n"  // Setup bits to enable access permissions.  Undocumented Altera/Intel Cyclone V SoC vendor specific
+		"MCR p15, 0, r0, c1, c1, 2                          \n"  // Write NSACR
+		"ISB                                                \n"
+
+		// Turn off caches and MMU
+		"MRC p15, 0, r0, c1, c0, 0                          \n"  // Read SCTLR
+		"BIC r0, r0, #(0x1 << 13)                           \n"  // Clear V bit 13 to disable hivecs
+		"BIC r0, r0, #(0x1 << 12)                           \n"  // Clear I bit 12 to disable L1 I-cache
+		"BIC r0, r0, #(0x1 << 11)                           \n"  // Clear Z bit 11 to disable branch prediction
+		"BIC r0, r0, #(0x1 << 2)                            \n"  // Clear C bit 2 to disable L1 D-cache
+		"BIC r0, r0, #(0x1 << 0)                            \n"  // Clear M bit 0 to disable MMU
+		"MCR p15, 0, r0, c1, c0, 0                          \n"  // Write SCTLR
+		"ISB                                                \n"  // Ensures changes have completed
+
+		// ACTLR
+		"MRC p15, 0, r0, c1, c0, 1                          \n"  // Read ACTLR
+		"BIC r0, r0, #(0x1 << 2)                            \n"  // Disable L1 dside prefetch
+		"BIC r0, r0, #(0x1 << 1)                            \n"  // Disable L2 prefetch hint (UNK/WI since r4p1)
+		"MCR p15, 0, r0, c1, c0, 1                          \n"  // Write ACTLR
+		"ISB                                                \n"
+
+		// Set Vector Base Address Register (VBAR), the vector table is shared with CPU0
+#if defined(ALT_INT_PROVISION_VECTOR_SUPPORT) && ALT_INT_PROVISION_VECTOR_SUPPORT == 0U
+		"LDR r0, =Vectors                                   \n"
+#else
+		"LDR r0, =__intc_interrupt_vector                   \n"
+#endif
+		"MCR p15, 0, r0, c12, c0, 0                         \n"
+
+		// Setup stack for each exception mode, CPU1 has its own set
+		"CPS #0x11                                          \n"
+		"LDR sp, =__FIQ_STACK_LIMIT_CPU1                    \n"
+		"CPS #0x12                                          \n"
+		"LDR sp, =__IRQ_STACK_LIMIT_CPU1                    \n"
+		"CPS #0x13                                          \n"
+		"LDR sp, =__SVC_STACK_LIMIT_CPU1                    \n"
+		"CPS #0x17                                          \n"
+		"LDR sp, =__ABT_STACK_LIMIT_CPU1                    \n"
+		"CPS #0x1B                                          \n"
+		"LDR sp, =__UND_STACK_LIMIT_CPU1                    \n"
+		"CPS #0x1F                                          \n"
+		"LDR sp, =__SYS_STACK_LIMIT_CPU1                    \n"
+		"CPS #0x13                                          \n"  // Continue in supervisor mode, the same as CPU0 enters main()
+
+		// Invalidate MMU TLBs all (TLBIALL)
+		"MOV r0, #0                                         \n"
+		"MCR p15, 0, r0, c8, c7, 0                          \n"
+
+		// Invalidate L1 branch predictor all (BPIALL)
+		"MCR p15, 0, r0, c7, c5, 6                          \n"
+		"DSB                                                \n"
+		"ISB                                                \n"
+
+		// Invalidate L1 instruction cache (ICIALLU)
+		"MCR p15, 0, r0, c7, c5, 0                          \n"
+		"DSB                                                \n"
+		"ISB                                                \n"
+
+		// Invalidate L1 data cache
+		"BL invalidate_l1_dcache_all                        \n"
+		"DSB                                                \n"
+		"ISB                                                \n"
+
+#if defined(TRU_NEON) && TRU_NEON == 1U
+		// Enable permission and turn on NEON/VFP (FPU)
+		"MRC p15, 0, r0, c1, c0, 2                          \n"  // Read CPACR (Coprocessor Access Control Register)
+		"ORR r0, r0, #0x00F00000                            \n"  // Setup bits to enable access to NEON/VFP (Coprocessors 10 and 11)
+		"MCR p15, 0, r0, c1, c0, 2                          \n"  // Write CPACR (Coprocessor Access Control Register)
+		"ISB                                                \n"  // Ensures CPACR write have completed before continuing
+
+		// Enable NEON
+		"VMRS r0, fpexc                                     \n"  // Read FPEXC (Floating-Point Exception Control register)
+		"ORR r0, r0, #0x40000000                            \n"  // Setup bits to enable the NEON/VFP (Advanced SIMD and floating-point extensions)
+		"VMSR fpexc, r0                                     \n"  // Write FPEXC (Floating-Point Exception Control register)
+
+		// Initialise FPSCR to a known state
+		"VMRS r0, fpscr                                     \n"
+		"LDR r1, =0x00086060                                \n"
+		"AND r0, r0, r1                                     \n"
+		"VMSR fpscr, r0                                     \n"
+#endif
+
+		// Enable SMP cache coherency support
+		"MRC p15, 0, r0, c1, c0, 1                          \n"  // Read ACTLR
+		"ORR r0, r0, #(0x1 << 22)                           \n"  // Set bit 22 to enable shared attribute override. Recommended for ACP data coherency from Cyclone V HPS tech ref
+		"ORR r0, r0, #(0x1 << 6)                            \n"  // Set bit 6 to participate in SMP coherency
+		"ORR r0, r0, #(0x1 << 0)                            \n"  // Set bit 0 to enable maintenance broadcast
+		"MCR p15, 0, r0, c1, c0, 1                          \n"  // Write ACTLR
+		"ISB                                                \n"
+
+		// Register MMU table, the same one as CPU0
+		"LDR r0, =c5soc_mmu_tbl                             \n"  // Load MMU translation table base address
+		"ORR r0, r0, #0x5b                                  \n"  // MMU attributes
+		"MCR p15, 0, r0, c2, c0, 0                          \n"  // Register level-1 MMU translation table and attributes with the TTBR0 register
+		"ISB                                                \n"  // Ensures changes have completed
+
+		// Set MMU domain access
+		"MOV r0, #0x1                                       \n"  // Client access. Accesses are checked against the permission bits in the translation tables, i.e. apply table entry setting
+		"MCR p15, 0, r0, c3, c0, 0                          \n"  // Write DACR
+		"ISB                                                \n"  // Ensures changes have completed
+
+		// Enable MMU
+		"MRC p15, 0, r0, c1, c0, 0                          \n"  // Read SCTLR
+		"ORR r0, r0, #(0x1 << 29)                           \n"  // Set AFE bit to enable simplified access permissions model
+		"BIC r0, r0, #(0x1 << 28)                           \n"  // Clear TRE bit to disable TEX remap
+		"BIC r0, r0, #(0x1 << 1)                            \n"  // Clear A bit to disable strict alignment fault checking
+		"ORR r0, r0, #(0x1 << 0)                            \n"  // Set M bit 0 to enable MMU
+		"MCR p15, 0, r0, c1, c0, 0                          \n"  // Write SCTLR
+		"ISB                                                \n"  // Ensures changes have completed
+
+		// Enable L1 caches and branch prediction
+		"MRC p15, 0, r0, c1, c0, 0                          \n"  // Read SCTLR
+		"ORR r0, r0, #(0x1 << 12)                           \n"  // Set I bit 12 to enable L1 I-cache
+		"ORR r0, r0, #(0x1 << 11)                           \n"  // Set Z bit 11 to enable branch prediction
+		"ORR r0, r0, #(0x1 << 2)                            \n"  // Set C bit 2 to enable L1 D-cache
+		"MCR p15, 0, r0, c1, c0, 0                          \n"  // Write SCTLR
+		"ISB                                                \n"  // Ensures changes have completed
+
+		// Call the CPU1 entry function with interrupts still masked
+		"LDR r0, =tru_smp_cpu1_entry                        \n"
+		"LDR r0, [r0]                                       \n"
+		"BLX r0                                             \n"
+
+		// We don't expect the above to return
+		"_cpu1_infinity_loop:                               \n"
+		"WFI                                                \n"
+		"B _cpu1_infinity_loop                              \n"
+	);
+}
+#endif
+
 // =============================
 // Override newlib _stack_init()
 // =============================
@@ -680,6 +840,17 @@ void clean_l1_dcache_all(void){
 // | When remapped to Boot ROM |                         | Normal, RO, inner & outer-cacheable, shareable            |
 // +-----------------------------------------------------------------------------------------------------------------+
 
+// On the QEMU vexpress-a9 (TRU_BOARD_VEXPA9) the table is instead:
+// +-----------------------------------------------------------------------------------------------------------------+
+// | Region                             | Address Range           | MMU table entry attributes                       |
+// |-----------------------------------------------------------------------------------------------------------------|
+// | Unused                             | 0xA0000000 - 0xFFFFFFFF | Shared device, RW, non-cacheable, shareable      |
+// |-----------------------------------------------------------------------------------------------------------------|
+// | 1GB DDR2                           | 0x60000000 - 0x9FFFFFFF | Normal, RWX, inner & outer-cacheable, shareable  |
+// |-----------------------------------------------------------------------------------------------------------------|
+// | Flash, Periph, MPCore, SRAM        | 0x00000000 - 0x5FFFFFFF | Shared device, RW, non-cacheable, shareable      |
+// +-----------------------------------------------------------------------------------------------------------------+
+
 __asm__(
 	// =========
 	// Constants
@@ -754,6 +925,7 @@ __asm__(
 	".section mmu_ttb_l1_entries, \"a\"                          \n"
 	".globl c5soc_mmu_tbl                                        \n"
 	"c5soc_mmu_tbl:                                              \n"
+#if(TRU_BOARD == TRU_BOARD_DE10NANO)
 		// Use repeat directive to create multiple MMU table entries for the 3GB DDR-3 SDRAM memory region
 		".rept 3072                                              \n"
 			".word MMU_SECTION_ADDR |"
@@ -836,6 +1008,49 @@ __asm__(
 			"      MMU_SHORT_NS_SECURE                           \n"
 			".set MMU_SECTION_ADDR, MMU_SECTION_ADDR + 0x100000UL\n"
 		".endr                                                   \n"
+#elif(TRU_BOARD == TRU_BOARD_VEXPA9)
+		// QEMU vexpress-a9, see tru_board_vexpa9.h
+		// Use repeat directive to create multiple MMU table entries for the flash, motherboard peripherals, MPCore private region and static memory region
+		".rept 1536                                              \n"
+			".word MMU_SECTION_ADDR |"
+			"      MMU_SHORT_XN_NONEXECUTE |"
+			"      MMU_SHORT_DOMAIN_ZERO |"
+			"      MMU_SHORT_TEXCB_SHAREABLE_DEV |"
+			"      MMU_SHORT_AP_RW_ANY |"
+			"      MMU_SHORT_S_SHAREABLE |"
+			"      MMU_SHORT_NG_GLOBAL |"
+			"      MMU_SHORT_SECTION |"
+			"      MMU_SHORT_NS_SECURE                           \n"
+			".set MMU_SECTION_ADDR, MMU_SECTION_ADDR + 0x100000UL\n"
+		".endr                                                   \n"
+
+		// Use repeat directive to create multiple MMU table entries for the 1GB DDR2 memory region
+		".rept 1024                                              \n"
+			".word MMU_SECTION_ADDR |"
+			"      MMU_SHORT_DOMAIN_ZERO |"
+			"      MMU_SHORT_TEXCB2_NORMAL_OWBWA_IWBWA |"
+			"      MMU_SHORT_AP_RW_ANY |"
+			"      MMU_SHORT_S_SHAREABLE |"
+			"      MMU_SHORT_NG_GLOBAL |"
+			"      MMU_SHORT_SECTION |"
+			"      MMU_SHORT_NS_SECURE                           \n"
+			".set MMU_SECTION_ADDR, MMU_SECTION_ADDR + 0x100000UL\n"
+		".endr                                                   \n"
+
+		// Use repeat directive to create multiple MMU table entries for the remaining memory region, which is unused
+		".rept 1536                                              \n"
+			".word MMU_SECTION_ADDR |"
+			"      MMU_SHORT_XN_NONEXECUTE |"
+			"      MMU_SHORT_DOMAIN_ZERO |"
+			"      MMU_SHORT_TEXCB_SHAREABLE_DEV |"
+			"      MMU_SHORT_AP_RW_ANY |"
+			"      MMU_SHORT_S_SHAREABLE |"
+			"      MMU_SHORT_NG_GLOBAL |"
+			"      MMU_SHORT_SECTION |"
+			"      MMU_SHORT_NS_SECURE                           \n"
+			".set MMU_SECTION_ADDR, MMU_SECTION_ADDR + 0x100000UL\n"
+		".endr                                                   \n"
+#endif
 );
 
 #endif
@@ -0,0 +1,93 @@
+/*
+	MIT License
+
+	Copyright (c) 2025 Truong Hy
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+
+	Version: 20261017
+
+	Binary event trace recorder, one 64-bit record per event in a RAM ring per CPU.
+
+	To get a trace stop the recorder, e.g. from the debugger with
+	"call tru_trace_stop()", then dump the tru_trace structure to a file with
+	OpenOCD, e.g.:
+		dump_image trace.bin <address of tru_trace> <sizeof(tru_trace)>
+	and convert it with scripts-generic/tru_trace_decode.py.
+*/
+
+#include "tru_trace.h"
+
+#if(TRU_CPU_FAMILY == TRU_CPU_FAMILY_CORTEXA9)
+
+#include "tru_lock.h"
+
+tru_trace_t tru_trace;
+
+#if defined(TRU_TRACE) && TRU_TRACE == 1U
+
+static tru_spinlock_t tru_trace_spinlock;
+
+void tru_trace_init(uint32_t timer_hz){
+	tru_trace.magic = TRU_TRACE_MAGIC;
+	tru_trace.ring_length = TRU_TRACE_RING_LENGTH;
+	tru_trace.cpus = TRU_TRACE_CPUS;
+	tru_trace.timer_hz = timer_hz;
+	tru_trace.stop_time = 0U;
+	tru_trace.enabled = 1U;
+}
+
+// Stops recording and saves the time the decoder unwraps the timestamps from
+void tru_trace_stop(void){
+	tru_trace.enabled = 0U;
+	__dmb();
+	tru_trace.stop_time = gtim_get_counter();
+}
+
+// Numbers queues and timers, the FreeRTOS trace hooks store it in the object
+uint32_t tru_trace_new_id(void){
+	uint32_t cpsr;
+	uint32_t id;
+
+	cpsr = tru_lock_irqsave(&tru_trace_spinlock);
+	id = ++tru_trace.next_id;
+	tru_unlock_irqrestore(&tru_trace_spinlock, cpsr);
+
+	return id;
+}
+
+// Records a task creation and keeps its name for the decoder
+void tru_trace_task_create(uint32_t task, const char *name){
+	char *dst;
+	uint32_t i;
+
+	if(task < TRU_TRACE_NAMES){
+		dst = tru_trace.names[task];
+		for(i = 0U; i < TRU_TRACE_NAME_LEN - 1U && name[i] != '\0'; i++){
+			dst[i] = name[i];
+		}
+		dst[i] = '\0';
+	}
+
+	tru_trace_record(TRU_TRACE_TASK_CREATE, task);
+}
+
+#endif
+
+#endif